@@ -55,6 +55,7 @@ LOCAL_SRC_FILES := ../on_3dm_attributes.cpp \
 		../on_viewport.cpp \
 		../on_xform.cpp \
 		../stringholder.cpp \
+		../parallel.cpp \
 		../stdafx.cpp \
 		../opennurbs/opennurbs_3dm_attributes.cpp \
 		../opennurbs/opennurbs_3dm_properties.cpp \
@@ -263,4 +263,872 @@ RH_C_FUNCTION const ON_Mesh* ON_Extrusion_GetMesh(const ON_Extrusion* pConstExtr
   if( pConstExtrusion )
     rc = pConstExtrusion->Mesh(ON::MeshType(meshtype));
   return rc;
-}
\ No newline at end of file
+}
+
+// Groups extrusions by their profiles for CRhCmnExtrusionMesher. Nothing is
+// shared: every ON_Extrusion keeps its own copy of its profile curves. The
+// groups only let the mesher tessellate the profiles once per entry and
+// reuse that for every extrusion in it. Profiles are hashed with DataCRC and
+// then compared span by span, so a curve class with a weak DataCRC can not
+// merge different profiles.
+class CRhCmnExtrusionProfileGroups
+{
+public:
+  CRhCmnExtrusionProfileGroups();
+
+  // Returns the index of the entry with the same profiles as extrusion,
+  // making the entry when there is none. The first extrusion added to an
+  // entry must stay alive as long as the groups. Returns -1 when extrusion
+  // has no profile.
+  int Add(const ON_Extrusion& extrusion);
+
+  // entries[i] gets Add(geometry[i]), or -1 when geometry[i] is not an
+  // extrusion. Hashing runs in parallel, adding in input order.
+  void Add(const ON_Geometry* const* geometry, int count, int thread_count, int* entries);
+
+  int Count() const { return m_entries.Count(); }
+
+  // extrusion the entry was made from
+  const ON_Extrusion* Extrusion(int entry) const;
+
+private:
+  struct CEntry
+  {
+    ON__UINT32 m_crc;
+    const ON_Extrusion* m_extrusion;
+    int m_next; // next entry in the same bucket
+  };
+
+  struct CHashTask
+  {
+    const ON_Geometry* const* m_geometry;
+    ON__UINT32* m_crc;
+  };
+
+  static bool HashTask(void* context, int index, int thread_index);
+  static ON__UINT32 ProfileCRC(const ON_Extrusion& extrusion);
+  static bool SameCurve(const ON_Curve& a, const ON_Curve& b);
+  static bool SameProfiles(const ON_Extrusion& a, const ON_Extrusion& b);
+  int Add(const ON_Extrusion& extrusion, ON__UINT32 crc);
+  void Rehash(int bucket_count);
+
+  ON_SimpleArray<CEntry> m_entries;
+  ON_SimpleArray<int> m_buckets; // first entry in every bucket
+
+  // no copies
+  CRhCmnExtrusionProfileGroups(const CRhCmnExtrusionProfileGroups&);
+  CRhCmnExtrusionProfileGroups& operator=(const CRhCmnExtrusionProfileGroups&);
+};
+
+CRhCmnExtrusionProfileGroups::CRhCmnExtrusionProfileGroups()
+{
+}
+
+ON__UINT32 CRhCmnExtrusionProfileGroups::ProfileCRC(const ON_Extrusion& extrusion)
+{
+  const int profile_count = extrusion.ProfileCount();
+  ON__UINT32 crc = ON_CRC32(0, sizeof(profile_count), &profile_count);
+  for( int i=0; i<profile_count; i++ )
+  {
+    const ON_Curve* profile = extrusion.Profile(i);
+    if( profile )
+      crc = profile->DataCRC(crc);
+  }
+  return crc;
+}
+
+bool CRhCmnExtrusionProfileGroups::SameCurve(const ON_Curve& a, const ON_Curve& b)
+{
+  if( a.ClassId() != b.ClassId() || a.Domain() != b.Domain() )
+    return false;
+  const int span_count = a.SpanCount();
+  if( span_count < 1 || span_count != b.SpanCount() || a.Degree() != b.Degree() || a.IsClosed() != b.IsClosed() )
+    return false;
+  ON_SimpleArray<double> sa(span_count+1), sb(span_count+1);
+  if( !a.GetSpanVector(sa.Array()) || !b.GetSpanVector(sb.Array()) )
+    return false;
+  sa.SetCount(span_count+1);
+  sb.SetCount(span_count+1);
+  for( int i=0; i<=span_count; i++ )
+  {
+    if( sa[i] != sb[i] || a.PointAt(sa[i]) != b.PointAt(sa[i]) )
+      return false;
+    if( i < span_count )
+    {
+      const double mid = 0.5*(sa[i] + sa[i+1]);
+      if( a.PointAt(mid) != b.PointAt(mid) )
+        return false;
+    }
+  }
+  return true;
+}
+
+bool CRhCmnExtrusionProfileGroups::SameProfiles(const ON_Extrusion& a, const ON_Extrusion& b)
+{
+  if( &a == &b )
+    return true;
+  const int profile_count = a.ProfileCount();
+  if( profile_count != b.ProfileCount() )
+    return false;
+  for( int i=0; i<profile_count; i++ )
+  {
+    const ON_Curve* pa = a.Profile(i);
+    const ON_Curve* pb = b.Profile(i);
+    if( 0 == pa || 0 == pb || !SameCurve(*pa, *pb) )
+      return false;
+  }
+  return true;
+}
+
+void CRhCmnExtrusionProfileGroups::Rehash(int bucket_count)
+{
+  m_buckets.Reserve(bucket_count);
+  m_buckets.SetCount(bucket_count);
+  int i;
+  for( i=0; i<bucket_count; i++ )
+    m_buckets[i] = -1;
+  for( i=0; i<m_entries.Count(); i++ )
+  {
+    CEntry& entry = m_entries[i];
+    int& first = m_buckets[entry.m_crc & (bucket_count-1)];
+    entry.m_next = first;
+    first = i;
+  }
+}
+
+int CRhCmnExtrusionProfileGroups::Add(const ON_Extrusion& extrusion, ON__UINT32 crc)
+{
+  if( extrusion.ProfileCount() < 1 )
+    return -1;
+  if( m_buckets.Count() < 1 )
+    Rehash(256);
+  int i;
+  for( i=m_buckets[crc & (m_buckets.Count()-1)]; i>=0; i=m_entries[i].m_next )
+  {
+    CEntry& entry = m_entries[i];
+    if( entry.m_crc == crc && SameProfiles(*entry.m_extrusion, extrusion) )
+      return i;
+  }
+
+  i = m_entries.Count();
+  CEntry& entry = m_entries.AppendNew();
+  entry.m_crc = crc;
+  entry.m_extrusion = &extrusion;
+  int& first = m_buckets[crc & (m_buckets.Count()-1)];
+  entry.m_next = first;
+  first = i;
+  if( m_entries.Count() > 2*m_buckets.Count() )
+    Rehash(4*m_buckets.Count());
+  return i;
+}
+
+int CRhCmnExtrusionProfileGroups::Add(const ON_Extrusion& extrusion)
+{
+  return Add(extrusion, ProfileCRC(extrusion));
+}
+
+bool CRhCmnExtrusionProfileGroups::HashTask(void* context, int index, int)
+{
+  const CHashTask* task = (const CHashTask*)context;
+  const ON_Extrusion* extrusion = ON_Extrusion::Cast(task->m_geometry[index]);
+  task->m_crc[index] = extrusion ? ProfileCRC(*extrusion) : 0;
+  return true;
+}
+
+void CRhCmnExtrusionProfileGroups::Add(const ON_Geometry* const* geometry, int count, int thread_count, int* entries)
+{
+  if( 0 == geometry || 0 == entries || count < 1 )
+    return;
+  ON_SimpleArray<ON__UINT32> crc(count);
+  crc.SetCount(count);
+  CHashTask task;
+  task.m_geometry = geometry;
+  task.m_crc = crc.Array();
+  RhCmnParallelFor(thread_count, count, HashTask, &task);
+  for( int i=0; i<count; i++ )
+  {
+    const ON_Extrusion* extrusion = ON_Extrusion::Cast(geometry[i]);
+    entries[i] = extrusion ? Add(*extrusion, crc[i]) : -1;
+  }
+}
+
+const ON_Extrusion* CRhCmnExtrusionProfileGroups::Extrusion(int entry) const
+{
+  return (entry >= 0 && entry < m_entries.Count()) ? m_entries[entry].m_extrusion : 0;
+}
+
+// Meshes extrusions straight from their profiles instead of going through
+// BrepForm and the brep mesher. Every profile is tessellated once in profile
+// coordinates and the samples are mapped to both ends of the path with
+// GetProfileTransformation, which takes care of mitered ends. Wall vertices
+// are shared along smooth stretches of a profile and doubled at kinks. Caps
+// are ear clipped after the inner profiles have been bridged into the outer
+// one. CreateMeshes tessellates each CRhCmnExtrusionProfileGroups entry once
+// and then sweeps one extrusion per work item with RhCmnParallelFor.
+class CRhCmnExtrusionMesher
+{
+public:
+  CRhCmnExtrusionMesher(double tolerance, double angle_tolerance);
+
+  // Returns NULL when the extrusion has no usable profile or path.
+  ON_Mesh* CreateMesh(const ON_Extrusion& extrusion) const;
+
+  // meshes[i] gets the mesh of geometry[i], or NULL when geometry[i] is not
+  // an extrusion. Returns the number of meshes made.
+  int CreateMeshes(const ON_Geometry* const* geometry, int count, int thread_count, ON_Mesh** meshes) const;
+
+private:
+  struct CLoop
+  {
+    ON_SimpleArray<ON_2dPoint> m_P;
+    ON_SimpleArray<ON_2dVector> m_T[2]; // unit tangents below and above each sample
+    bool m_bClosed;
+    bool m_bFlip; // (ty,-tx) points into the material
+  };
+
+  // tessellated profiles of an extrusion, used by every extrusion in the
+  // same profile group
+  struct CProfile
+  {
+    ON_ClassArray<CLoop> m_loops;
+    ON_SimpleArray<ON_2dPoint> m_cap_points; // closed loops without their closing samples
+    ON_SimpleArray<int> m_cap_triangles;     // counterclockwise triples into m_cap_points
+    bool m_bClosed;
+    bool m_bValid;
+  };
+
+  struct CTask
+  {
+    const CRhCmnExtrusionMesher* m_mesher;
+    const ON_Geometry* const* m_geometry;
+    ON_Mesh** m_meshes;
+    const CRhCmnExtrusionProfileGroups* m_groups;
+    const int* m_entries;
+    CProfile* m_profiles;
+  };
+
+  static bool ProfileTask(void* context, int index, int thread_index);
+  static bool MeshTask(void* context, int index, int thread_index);
+  bool CreateProfile(const ON_Extrusion& extrusion, CProfile& profile) const;
+  ON_Mesh* Sweep(const ON_Extrusion& extrusion, const CProfile& profile) const;
+  static double Area2(const ON_2dPoint& a, const ON_2dPoint& b, const ON_2dPoint& c);
+  static bool InCone(const ON_2dPoint& a0, const ON_2dPoint& a, const ON_2dPoint& a1, const ON_2dPoint& q);
+  bool Split(const ON_Curve& curve, double a, double b) const;
+  bool Tessellate(const ON_Curve& curve, CLoop& loop) const;
+  static void Bridge(const ON_SimpleArray<ON_2dPoint>& points, const ON_SimpleArray<int>& hole, ON_SimpleArray<int>& poly);
+  static void EarClip(const ON_SimpleArray<ON_2dPoint>& points, const ON_SimpleArray<int>& poly, ON_SimpleArray<int>& triangles);
+  static void Triangulate(const ON_ClassArray<CLoop>& loops, ON_SimpleArray<ON_2dPoint>& points, ON_SimpleArray<int>& triangles);
+
+  const double m_tolerance;
+  const double m_cos_angle;
+  const bool m_bAngle;
+  const int m_max_count; // samples per profile
+
+  // no copies
+  CRhCmnExtrusionMesher(const CRhCmnExtrusionMesher&);
+  CRhCmnExtrusionMesher& operator=(const CRhCmnExtrusionMesher&);
+};
+
+CRhCmnExtrusionMesher::CRhCmnExtrusionMesher(double tolerance, double angle_tolerance)
+: m_tolerance(tolerance > 0.0 ? tolerance : 0.0)
+, m_cos_angle(angle_tolerance > 0.0 ? cos(angle_tolerance) : 1.0)
+, m_bAngle(angle_tolerance > 0.0 && angle_tolerance < ON_PI)
+, m_max_count(1024)
+{
+}
+
+double CRhCmnExtrusionMesher::Area2(const ON_2dPoint& a, const ON_2dPoint& b, const ON_2dPoint& c)
+{
+  return (b.x-a.x)*(c.y-a.y) - (c.x-a.x)*(b.y-a.y);
+}
+
+// true when q lies inside the corner a0,a,a1 of a counterclockwise polygon
+bool CRhCmnExtrusionMesher::InCone(const ON_2dPoint& a0, const ON_2dPoint& a, const ON_2dPoint& a1, const ON_2dPoint& q)
+{
+  if( Area2(a, a1, a0) >= 0.0 )
+    return Area2(a, q, a0) > 0.0 && Area2(q, a, a1) > 0.0;
+  return !(Area2(a, q, a1) >= 0.0 && Area2(q, a, a0) >= 0.0);
+}
+
+bool CRhCmnExtrusionMesher::Split(const ON_Curve& curve, double a, double b) const
+{
+  ON_3dPoint A, B;
+  ON_3dVector TA, TB;
+  const bool bA = curve.EvTangent(a, A, TA, 1);
+  const bool bB = curve.EvTangent(b, B, TB, -1);
+  if( !bA || !bB )
+    return false;
+  if( m_tolerance > 0.0 )
+  {
+    const ON_3dPoint M = curve.PointAt(0.5*(a+b));
+    const ON_Line chord(A, B);
+    const double d = (A == B) ? M.DistanceTo(A) : chord.DistanceTo(M);
+    if( d > m_tolerance )
+      return true;
+  }
+  return (m_bAngle && TA*TB < m_cos_angle);
+}
+
+bool CRhCmnExtrusionMesher::Tessellate(const ON_Curve& curve, CLoop& loop) const
+{
+  const int span_count = curve.SpanCount();
+  if( span_count < 1 )
+    return false;
+  ON_SimpleArray<double> spans(span_count+1);
+  if( !curve.GetSpanVector(spans.Array()) )
+    return false;
+  spans.SetCount(span_count+1);
+  // Curved spans start out in at least 4 pieces, and a closed curved
+  // profile in at least 8, so it stays a closed, round loop even when both
+  // tolerances are turned off.
+  int pieces = 1;
+  if( curve.Degree() > 1 )
+  {
+    pieces = 4;
+    if( curve.IsClosed() && pieces*span_count < 8 )
+      pieces = (8 + span_count - 1)/span_count;
+  }
+  const double min_length = 1.0e-8*(spans[span_count] - spans[0]);
+
+  // depth first so the parameters come out sorted
+  ON_SimpleArray<double> t(span_count*pieces+1);
+  ON_SimpleArray<ON_Interval> stack(32);
+  t.Append(spans[0]);
+  int i;
+  for( i=0; i<span_count; i++ )
+  {
+    const ON_Interval span(spans[i], spans[i+1]);
+    for( int k=1; k<=pieces; k++ )
+    {
+      stack.Append(ON_Interval(*t.Last(), k == pieces ? span[1] : span.ParameterAt((double)k/(double)pieces)));
+      while( stack.Count() > 0 )
+      {
+        const ON_Interval piece = *stack.Last();
+        stack.SetCount(stack.Count()-1);
+        const bool bRoom = (t.Count() + stack.Count() + 1 < m_max_count);
+        if( bRoom && piece.Length() > min_length && Split(curve, piece[0], piece[1]) )
+        {
+          const double mid = piece.Mid();
+          stack.Append(ON_Interval(mid, piece[1]));
+          stack.Append(ON_Interval(piece[0], mid));
+        }
+        else
+          t.Append(piece[1]);
+      }
+    }
+  }
+
+  // tangents differ on the two sides of a span boundary only
+  const int n = t.Count();
+  loop.m_P.Reserve(n);
+  loop.m_T[0].Reserve(n);
+  loop.m_T[1].Reserve(n);
+  int knot = 0;
+  for( i=0; i<n; i++ )
+  {
+    ON_3dPoint P;
+    ON_3dVector T[2];
+    while( knot < span_count && spans[knot] < t[i] )
+      knot++;
+    const bool bKnot = (t[i] == spans[knot]);
+    if( !curve.EvTangent(t[i], P, T[0], (0 == i || !bKnot) ? 1 : -1) )
+      return false;
+    T[1] = T[0];
+    if( bKnot && i > 0 && i+1 < n )
+      curve.EvTangent(t[i], P, T[1], 1);
+
+    // zero length pieces collapse into the previous sample
+    const int count = loop.m_P.Count();
+    if( count > 0 && ON_2dPoint(P.x, P.y).DistanceTo(loop.m_P[count-1]) <= ON_ZERO_TOLERANCE )
+    {
+      loop.m_T[1][count-1] = ON_2dVector(T[1].x, T[1].y);
+      continue;
+    }
+    loop.m_P.Append(ON_2dPoint(P.x, P.y));
+    loop.m_T[0].Append(ON_2dVector(T[0].x, T[0].y));
+    loop.m_T[1].Append(ON_2dVector(T[1].x, T[1].y));
+  }
+
+  const int count = loop.m_P.Count();
+  loop.m_bClosed = curve.IsClosed() && count >= 4;
+  loop.m_bFlip = false;
+  if( loop.m_bClosed )
+    loop.m_P[count-1] = loop.m_P[0];
+  for( i=0; i<count; i++ )
+  {
+    // fall back on the chord where the curve has no tangent
+    for( int side=0; side<2; side++ )
+    {
+      ON_2dVector& T = loop.m_T[side][i];
+      if( T.Unitize() )
+        continue;
+      const int j = (0 == side) ? (i > 0 ? i-1 : i) : (i+1 < count ? i+1 : i);
+      T = (0 == side) ? loop.m_P[i] - loop.m_P[j] : loop.m_P[j] - loop.m_P[i];
+      T.Unitize();
+    }
+  }
+  return count >= 2;
+}
+
+// Splices hole, a clockwise loop, into poly, a counterclockwise loop, along
+// the bridge from the hole's rightmost point to a visible point of poly
+// (David Eberly, "Triangulation by Ear Clipping").
+void CRhCmnExtrusionMesher::Bridge(const ON_SimpleArray<ON_2dPoint>& points, const ON_SimpleArray<int>& hole, ON_SimpleArray<int>& poly)
+{
+  const int n = poly.Count();
+  const int hole_count = hole.Count();
+  int m = 0, i;
+  for( i=1; i<hole_count; i++ )
+  {
+    if( points[hole[i]].x > points[hole[m]].x )
+      m = i;
+  }
+  const ON_2dPoint M = points[hole[m]];
+
+  // nearest edge hit by the ray from M in the +x direction
+  int edge = -1;
+  double hit = ON_UNSET_POSITIVE_VALUE;
+  for( i=0; i<n; i++ )
+  {
+    const ON_2dPoint& A = points[poly[i]];
+    const ON_2dPoint& B = points[poly[(i+1)%n]];
+    if( (A.y <= M.y && B.y >= M.y && A.y < B.y) || (B.y <= M.y && A.y >= M.y && B.y < A.y) )
+    {
+      const double x = A.x + (M.y - A.y)*(B.x - A.x)/(B.y - A.y);
+      if( x >= M.x && x < hit )
+      {
+        hit = x;
+        edge = i;
+      }
+    }
+  }
+
+  int v = 0;
+  if( edge >= 0 )
+  {
+    const int e1 = (edge+1)%n;
+    v = points[poly[edge]].x > points[poly[e1]].x ? edge : e1;
+    const ON_2dPoint I(hit, M.y);
+    const ON_2dPoint P = points[poly[v]];
+    const bool bCCW = Area2(M, I, P) > 0.0;
+
+    // a reflex vertex inside M,I,P blocks the view of P; take the one
+    // closest in angle to the ray instead
+    double best_cos = -2.0;
+    for( i=0; i<n; i++ )
+    {
+      const ON_2dPoint& Q = points[poly[i]];
+      if( poly[i] == poly[v] || Area2(points[poly[(i+n-1)%n]], Q, points[poly[(i+1)%n]]) > 0.0 )
+        continue;
+      const double a = Area2(M, I, Q), b = Area2(I, P, Q), c = Area2(P, M, Q);
+      const bool bInside = bCCW ? (a > 0.0 && b > 0.0 && c > 0.0) : (a < 0.0 && b < 0.0 && c < 0.0);
+      if( !bInside )
+        continue;
+      const double d = M.DistanceTo(Q);
+      const double cos_angle = d > 0.0 ? (Q.x - M.x)/d : 1.0;
+      if( cos_angle > best_cos )
+      {
+        best_cos = cos_angle;
+        v = i;
+      }
+    }
+  }
+  else
+  {
+    double best = ON_UNSET_POSITIVE_VALUE;
+    for( i=0; i<n; i++ )
+    {
+      const double d = M.DistanceTo(points[poly[i]]);
+      if( d < best )
+      {
+        best = d;
+        v = i;
+      }
+    }
+  }
+
+  // earlier bridges repeat points; use the copy whose corner faces M
+  for( i=0; i<n; i++ )
+  {
+    if( poly[i] == poly[v] && InCone(points[poly[(i+n-1)%n]], points[poly[i]], points[poly[(i+1)%n]], M) )
+    {
+      v = i;
+      break;
+    }
+  }
+
+  ON_SimpleArray<int> bridged(n + hole_count + 2);
+  bridged.Append(v+1, poly.Array());
+  for( i=0; i<=hole_count; i++ )
+    bridged.Append(hole[(m+i)%hole_count]);
+  bridged.Append(poly[v]);
+  bridged.Append(n-v-1, poly.Array()+v+1);
+  poly = bridged;
+}
+
+void CRhCmnExtrusionMesher::EarClip(const ON_SimpleArray<ON_2dPoint>& points, const ON_SimpleArray<int>& poly, ON_SimpleArray<int>& triangles)
+{
+  const int n = poly.Count();
+  if( n < 3 )
+    return;
+  ON_SimpleArray<int> prev(n), next(n);
+  prev.SetCount(n);
+  next.SetCount(n);
+  int i;
+  for( i=0; i<n; i++ )
+  {
+    prev[i] = (i+n-1)%n;
+    next[i] = (i+1)%n;
+  }
+
+  int remaining = n, stall = 0;
+  i = 0;
+  while( remaining > 3 )
+  {
+    const int p = prev[i], q = next[i];
+    const ON_2dPoint& A = points[poly[p]];
+    const ON_2dPoint& B = points[poly[i]];
+    const ON_2dPoint& C = points[poly[q]];
+    const double area = Area2(A, B, C);
+    bool bEar = area > 0.0;
+    for( int k=next[q]; bEar && k!=p; k=next[k] )
+    {
+      const int pk = poly[k];
+      if( pk == poly[p] || pk == poly[i] || pk == poly[q] )
+        continue;
+      const ON_2dPoint& Q = points[pk];
+      if( Area2(points[poly[prev[k]]], Q, points[poly[next[k]]]) > 0.0 )
+        continue; // only reflex vertices can be inside an ear
+      if( Area2(A, B, Q) >= 0.0 && Area2(B, C, Q) >= 0.0 && Area2(C, A, Q) >= 0.0 )
+        bEar = false;
+    }
+
+    // a full lap without an ear means the polygon is degenerate; clip
+    // anyway so the loop ends
+    if( bEar || stall > remaining )
+    {
+      if( area > 0.0 )
+      {
+        triangles.Append(poly[p]);
+        triangles.Append(poly[i]);
+        triangles.Append(poly[q]);
+      }
+      next[p] = q;
+      prev[q] = p;
+      remaining--;
+      stall = 0;
+      i = p;
+    }
+    else
+    {
+      i = q;
+      stall++;
+    }
+  }
+  if( Area2(points[poly[prev[i]]], points[poly[i]], points[poly[next[i]]]) > 0.0 )
+  {
+    triangles.Append(poly[prev[i]]);
+    triangles.Append(poly[i]);
+    triangles.Append(poly[next[i]]);
+  }
+}
+
+void CRhCmnExtrusionMesher::Triangulate(const ON_ClassArray<CLoop>& loops, ON_SimpleArray<ON_2dPoint>& points, ON_SimpleArray<int>& triangles)
+{
+  const int loop_count = loops.Count();
+  ON_SimpleArray<int> poly;
+  ON_ClassArray< ON_SimpleArray<int> > holes(loop_count);
+  ON_SimpleArray<double> hole_x(loop_count);
+  int l, i;
+  for( l=0; l<loop_count; l++ )
+  {
+    // the closing sample repeats the first one
+    const CLoop& loop = loops[l];
+    const int first = points.Count();
+    const int count = loop.m_P.Count()-1;
+    points.Append(count, loop.m_P.Array());
+
+    // outer loop counterclockwise, holes clockwise
+    double area = 0.0;
+    double max_x = loop.m_P[0].x;
+    for( i=0; i<count; i++ )
+    {
+      area += loop.m_P[i].x*loop.m_P[i+1].y - loop.m_P[i+1].x*loop.m_P[i].y;
+      if( loop.m_P[i].x > max_x )
+        max_x = loop.m_P[i].x;
+    }
+    const bool bReverse = (0 == l) ? (area < 0.0) : (area > 0.0);
+    ON_SimpleArray<int>& ring = (0 == l) ? poly : holes.AppendNew();
+    ring.Reserve(count);
+    for( i=0; i<count; i++ )
+      ring.Append(first + (bReverse ? count-1-i : i));
+    if( l > 0 )
+      hole_x.Append(max_x);
+  }
+
+  // holes right to left so every bridge stays clear of the holes still to come
+  const int hole_count = holes.Count();
+  ON_SimpleArray<int> order(hole_count);
+  for( i=0; i<hole_count; i++ )
+  {
+    int j = order.Count();
+    order.Append(i);
+    for( ; j>0 && hole_x[order[j-1]] < hole_x[i]; j-- )
+      order[j] = order[j-1];
+    order[j] = i;
+  }
+  for( i=0; i<hole_count; i++ )
+    Bridge(points, holes[order[i]], poly);
+
+  triangles.Reserve(3*poly.Count());
+  EarClip(points, poly, triangles);
+}
+
+bool CRhCmnExtrusionMesher::CreateProfile(const ON_Extrusion& extrusion, CProfile& profile) const
+{
+  const int profile_count = extrusion.ProfileCount();
+  if( profile_count < 1 )
+    return false;
+  profile.m_loops.Reserve(profile_count);
+  profile.m_bClosed = true;
+  int l, i;
+  for( l=0; l<profile_count; l++ )
+  {
+    const ON_Curve* curve = extrusion.Profile(l);
+    CLoop& loop = profile.m_loops.AppendNew();
+    if( 0 == curve || !Tessellate(*curve, loop) )
+      return false;
+    profile.m_bClosed = profile.m_bClosed && loop.m_bClosed;
+  }
+
+  // caps need every profile closed
+  if( profile.m_bClosed )
+    Triangulate(profile.m_loops, profile.m_cap_points, profile.m_cap_triangles);
+
+  // right (ty,-tx) of a counterclockwise outer loop or a clockwise hole is
+  // outside the material
+  for( l=0; l<profile_count; l++ )
+  {
+    CLoop& loop = profile.m_loops[l];
+    if( !loop.m_bClosed )
+      continue;
+    double area = 0.0;
+    for( i=0; i+1<loop.m_P.Count(); i++ )
+      area += loop.m_P[i].x*loop.m_P[i+1].y - loop.m_P[i+1].x*loop.m_P[i].y;
+    loop.m_bFlip = (0 == l) ? (area < 0.0) : (area > 0.0);
+  }
+  return true;
+}
+
+ON_Mesh* CRhCmnExtrusionMesher::CreateMesh(const ON_Extrusion& extrusion) const
+{
+  CProfile profile;
+  return CreateProfile(extrusion, profile) ? Sweep(extrusion, profile) : NULL;
+}
+
+ON_Mesh* CRhCmnExtrusionMesher::Sweep(const ON_Extrusion& extrusion, const CProfile& profile) const
+{
+  ON_Xform xform[2];
+  if( !extrusion.GetProfileTransformation(0.0, xform[0]) || !extrusion.GetProfileTransformation(1.0, xform[1]) )
+    return NULL;
+  ON_3dVector T = extrusion.PathTangent();
+  if( !T.Unitize() )
+    return NULL;
+
+  const ON_ClassArray<CLoop>& loops = profile.m_loops;
+  const ON_SimpleArray<ON_2dPoint>& cap_points = profile.m_cap_points;
+  const ON_SimpleArray<int>& cap_triangles = profile.m_cap_triangles;
+  const int profile_count = loops.Count();
+  const int capped = profile.m_bClosed ? extrusion.IsCapped() : 0;
+  int l, i;
+
+  int vertex_count = 0, face_count = 0;
+  for( l=0; l<profile_count; l++ )
+  {
+    vertex_count += 4*loops[l].m_P.Count();
+    face_count += loops[l].m_P.Count()-1;
+  }
+  const int cap_count = (1 == capped || 2 == capped) ? 1 : (capped > 0 ? 2 : 0);
+  vertex_count += cap_count*cap_points.Count();
+  face_count += cap_count*(cap_triangles.Count()/3);
+
+  ON_Mesh* mesh = new ON_Mesh(face_count, vertex_count, true, false);
+
+  // walls: one column of two vertices per sample, two columns at kinks
+  ON_SimpleArray<int> below, above;
+  for( l=0; l<profile_count; l++ )
+  {
+    const CLoop& loop = loops[l];
+    const int n = loop.m_P.Count();
+    const int first = mesh->m_V.Count();
+    below.SetCount(0);
+    above.SetCount(0);
+    below.Reserve(n);
+    above.Reserve(n);
+    int column = 0;
+    for( i=0; i<n; i++ )
+    {
+      const ON_2dVector& T0 = loop.m_T[0][i];
+      const ON_2dVector& T1 = loop.m_T[1][i];
+      const bool bKink = (i > 0 && i+1 < n && T0*T1 < ON_DEFAULT_ANGLE_TOLERANCE_COSINE);
+      for( int side=0; side<(bKink ? 2 : 1); side++ )
+      {
+        ON_2dVector tangent = bKink ? loop.m_T[side][i] : T0 + T1;
+        if( !tangent.Unitize() )
+          tangent = T0;
+        const double sign = loop.m_bFlip ? -1.0 : 1.0;
+        const ON_3dPoint P(loop.m_P[i].x, loop.m_P[i].y, 0.0);
+        ON_3dVector N = xform[0]*ON_3dVector(sign*tangent.y, -sign*tangent.x, 0.0);
+        N = N - (N*T)*T; // mitered ends shear along the path only
+        N.Unitize();
+        for( int end=0; end<2; end++ )
+        {
+          mesh->m_V.Append(ON_3fPoint(xform[end]*P));
+          mesh->m_N.Append(ON_3fVector(N));
+        }
+      }
+      below.Append(column);
+      column += bKink ? 2 : 1;
+      above.Append(column-1);
+    }
+    for( i=0; i+1<n; i++ )
+    {
+      const int a = first + 2*above[i];
+      const int b = first + 2*below[i+1];
+      const ON_3dVector E = ON_3dPoint(mesh->m_V[b]) - ON_3dPoint(mesh->m_V[a]);
+      const ON_3dVector N = ON_3dVector(mesh->m_N[a]) + ON_3dVector(mesh->m_N[b]);
+      ON_MeshFace& face = mesh->m_F.AppendNew();
+      face.vi[0] = a;
+      if( ON_CrossProduct(E, T)*N >= 0.0 )
+      {
+        face.vi[1] = b;
+        face.vi[2] = b+1;
+        face.vi[3] = a+1;
+      }
+      else
+      {
+        face.vi[1] = a+1;
+        face.vi[2] = b+1;
+        face.vi[3] = b;
+      }
+    }
+  }
+
+  // caps: counterclockwise profile triangles face along X x Y
+  const ON_3dVector Z = ON_CrossProduct(xform[0]*ON_3dVector(1.0, 0.0, 0.0), xform[0]*ON_3dVector(0.0, 1.0, 0.0));
+  const bool bRightHanded = (Z*T > 0.0);
+  for( int end=0; end<2; end++ )
+  {
+    if( !(capped & (1<<end)) )
+      continue;
+    const int first = mesh->m_V.Count();
+    const ON_3fVector N(end ? T : -T);
+    for( i=0; i<cap_points.Count(); i++ )
+    {
+      mesh->m_V.Append(ON_3fPoint(xform[end]*ON_3dPoint(cap_points[i].x, cap_points[i].y, 0.0)));
+      mesh->m_N.Append(N);
+    }
+    const bool bReverse = (1 == end) != bRightHanded;
+    for( i=0; i+2<cap_triangles.Count(); i+=3 )
+    {
+      ON_MeshFace& face = mesh->m_F.AppendNew();
+      face.vi[0] = first + cap_triangles[i];
+      face.vi[1] = first + cap_triangles[bReverse ? i+2 : i+1];
+      face.vi[2] = first + cap_triangles[bReverse ? i+1 : i+2];
+      face.vi[3] = face.vi[2];
+    }
+  }
+
+  mesh->ComputeFaceNormals();
+  return mesh;
+}
+
+bool CRhCmnExtrusionMesher::ProfileTask(void* context, int index, int)
+{
+  CTask* task = (CTask*)context;
+  CProfile& profile = task->m_profiles[index];
+  profile.m_bValid = task->m_mesher->CreateProfile(*task->m_groups->Extrusion(index), profile);
+  return true;
+}
+
+bool CRhCmnExtrusionMesher::MeshTask(void* context, int index, int)
+{
+  const CTask* task = (const CTask*)context;
+  const int entry = task->m_entries[index];
+  const CProfile* profile = (entry >= 0) ? &task->m_profiles[entry] : 0;
+  task->m_meshes[index] = (profile && profile->m_bValid) ? task->m_mesher->Sweep(*ON_Extrusion::Cast(task->m_geometry[index]), *profile) : NULL;
+  return true;
+}
+
+int CRhCmnExtrusionMesher::CreateMeshes(const ON_Geometry* const* geometry, int count, int thread_count, ON_Mesh** meshes) const
+{
+  if( 0 == geometry || 0 == meshes || count < 1 )
+    return 0;
+
+  // members cut from the same section share one tessellated profile
+  CRhCmnExtrusionProfileGroups groups;
+  ON_SimpleArray<int> entries(count);
+  entries.SetCount(count);
+  groups.Add(geometry, count, thread_count, entries.Array());
+  ON_ClassArray<CProfile> profiles(groups.Count());
+  for( int i=0; i<groups.Count(); i++ )
+    profiles.AppendNew();
+
+  CTask task;
+  task.m_mesher = this;
+  task.m_geometry = geometry;
+  task.m_meshes = meshes;
+  task.m_groups = &groups;
+  task.m_entries = entries.Array();
+  task.m_profiles = profiles.Array();
+  RhCmnParallelFor(thread_count, groups.Count(), ProfileTask, &task);
+  RhCmnParallelFor(thread_count, count, MeshTask, &task);
+  int rc = 0;
+  for( int i=0; i<count; i++ )
+  {
+    if( meshes[i] )
+      rc++;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION ON_Mesh* ON_Extrusion_CreateMesh(const ON_Extrusion* pConstExtrusion, double tolerance, double angleTolerance)
+{
+  ON_Mesh* rc = NULL;
+  if( pConstExtrusion )
+  {
+    CRhCmnExtrusionMesher mesher(tolerance, angleTolerance);
+    rc = mesher.CreateMesh(*pConstExtrusion);
+  }
+  return rc;
+}
+
+// meshes gets one entry per input, NULL where the input is not an extrusion
+RH_C_FUNCTION int ON_Extrusion_CreateMeshes(const ON_SimpleArray<const ON_Geometry*>* pConstGeometry, double tolerance, double angleTolerance, int threadCount, ON_SimpleArray<ON_Mesh*>* meshes)
+{
+  int rc = 0;
+  if( pConstGeometry && meshes )
+  {
+    const int count = pConstGeometry->Count();
+    const int first = meshes->Count();
+    meshes->Reserve(first + count);
+    meshes->SetCount(first + count);
+    CRhCmnExtrusionMesher mesher(tolerance, angleTolerance);
+    rc = mesher.CreateMeshes(pConstGeometry->Array(), count, threadCount, meshes->Array() + first);
+  }
+  return rc;
+}
+
+// groups gets one entry per input: the index of its profile group, or -1
+// when the input is not an extrusion. Returns the number of groups.
+RH_C_FUNCTION int ON_Extrusion_GroupByProfile(const ON_SimpleArray<const ON_Geometry*>* pConstGeometry, int threadCount, /*ARRAY*/int* groups)
+{
+  int rc = 0;
+  if( pConstGeometry && groups )
+  {
+    CRhCmnExtrusionProfileGroups profile_groups;
+    profile_groups.Add(pConstGeometry->Array(), pConstGeometry->Count(), threadCount, groups);
+    rc = profile_groups.Count();
+  }
+  return rc;
+}
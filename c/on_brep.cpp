@@ -326,6 +326,264 @@ RH_C_FUNCTION bool ON_Brep_IsValidTest(const ON_Brep* pConstBrep, int which_test
   return rc;
 }
 
+// Checks the vertices, edges, trims, loops and faces of many breps in
+// parallel and reports every failing component instead of text. Like
+// ON_Brep::IsValid, a brep only gets its geometry checked when all of its
+// topology is valid, and its tolerances and flags only when all of its
+// geometry is valid.
+class CRhCmnBrepValidator
+{
+public:
+  enum LEVEL
+  {
+    topology_only = 0,
+    geometry = 1,
+    tolerances_and_flags = 2
+  };
+  enum ERROR_CODE
+  {
+    invalid_topology = 1,
+    invalid_geometry = 2,
+    invalid_tolerances_and_flags = 3
+  };
+
+  CRhCmnBrepValidator(const ON_Brep* const* breps, int brep_count);
+
+  // errors gets 4 ints per problem sorted by brep: brep index,
+  // ON_COMPONENT_INDEX::TYPE, component index and ERROR_CODE. Problems
+  // with the brep as a whole use ON_COMPONENT_INDEX::invalid_type and -1.
+  // Returns the number of invalid breps.
+  int Validate(int level, int thread_count, ON_SimpleArray<int>& errors);
+
+private:
+  enum { block_size = 64 };
+  struct CTask
+  {
+    int m_brep;
+    int m_type; // ON_COMPONENT_INDEX::TYPE
+    int m_first;
+    int m_count;
+  };
+  struct CError
+  {
+    int m_brep;
+    int m_type;
+    int m_index;
+    int m_code;
+  };
+
+  static bool RunTask(void* context, int index, int thread_index);
+  static int CompareError(const CError* a, const CError* b);
+  static bool IsDeleted(const ON_Brep& brep, int type, int index);
+  bool Check(const ON_Brep& brep, int type, int index) const;
+  void AddTasks(int brep, int type, int count);
+  void RunPass(int code, int thread_count);
+
+  const ON_Brep* const* m_breps;
+  const int m_brep_count;
+  int m_code; // ERROR_CODE of the running pass
+  ON_SimpleArray<bool> m_bValid;
+  ON_SimpleArray<CTask> m_tasks;
+  ON_ClassArray< ON_SimpleArray<CError> > m_thread_errors;
+  ON_SimpleArray<CError> m_errors;
+};
+
+CRhCmnBrepValidator::CRhCmnBrepValidator(const ON_Brep* const* breps, int brep_count)
+: m_breps(breps)
+, m_brep_count(brep_count > 0 ? brep_count : 0)
+, m_code(invalid_topology)
+{
+}
+
+int CRhCmnBrepValidator::CompareError(const CError* a, const CError* b)
+{
+  if( a->m_brep != b->m_brep )
+    return a->m_brep < b->m_brep ? -1 : 1;
+  if( a->m_code != b->m_code )
+    return a->m_code < b->m_code ? -1 : 1;
+  if( a->m_type != b->m_type )
+    return a->m_type < b->m_type ? -1 : 1;
+  if( a->m_index != b->m_index )
+    return a->m_index < b->m_index ? -1 : 1;
+  return 0;
+}
+
+bool CRhCmnBrepValidator::IsDeleted(const ON_Brep& brep, int type, int index)
+{
+  switch( type )
+  {
+  case ON_COMPONENT_INDEX::brep_vertex: return brep.m_V[index].m_vertex_index < 0;
+  case ON_COMPONENT_INDEX::brep_edge:   return brep.m_E[index].m_edge_index < 0;
+  case ON_COMPONENT_INDEX::brep_trim:   return brep.m_T[index].m_trim_index < 0;
+  case ON_COMPONENT_INDEX::brep_loop:   return brep.m_L[index].m_loop_index < 0;
+  case ON_COMPONENT_INDEX::brep_face:   return brep.m_F[index].m_face_index < 0;
+  }
+  return false;
+}
+
+bool CRhCmnBrepValidator::Check(const ON_Brep& brep, int type, int index) const
+{
+  // ON_Brep::IsValid skips components that were deleted but not compacted
+  if( IsDeleted(brep, type, index) )
+    return true;
+  switch( m_code )
+  {
+  case invalid_topology:
+    switch( type )
+    {
+    case ON_COMPONENT_INDEX::brep_vertex: return brep.IsValidVertexTopology(index, NULL);
+    case ON_COMPONENT_INDEX::brep_edge:   return brep.IsValidEdgeTopology(index, NULL);
+    case ON_COMPONENT_INDEX::brep_trim:   return brep.IsValidTrimTopology(index, NULL);
+    case ON_COMPONENT_INDEX::brep_loop:   return brep.IsValidLoopTopology(index, NULL);
+    case ON_COMPONENT_INDEX::brep_face:   return brep.IsValidFaceTopology(index, NULL);
+    }
+    break;
+  case invalid_geometry:
+    switch( type )
+    {
+    case ON_COMPONENT_INDEX::brep_vertex: return brep.IsValidVertexGeometry(index, NULL);
+    case ON_COMPONENT_INDEX::brep_edge:   return brep.IsValidEdgeGeometry(index, NULL);
+    case ON_COMPONENT_INDEX::brep_trim:   return brep.IsValidTrimGeometry(index, NULL);
+    case ON_COMPONENT_INDEX::brep_loop:   return brep.IsValidLoopGeometry(index, NULL);
+    case ON_COMPONENT_INDEX::brep_face:   return brep.IsValidFaceGeometry(index, NULL);
+    }
+    break;
+  case invalid_tolerances_and_flags:
+    switch( type )
+    {
+    case ON_COMPONENT_INDEX::brep_vertex: return brep.IsValidVertexTolerancesAndFlags(index, NULL);
+    case ON_COMPONENT_INDEX::brep_edge:   return brep.IsValidEdgeTolerancesAndFlags(index, NULL);
+    case ON_COMPONENT_INDEX::brep_trim:   return brep.IsValidTrimTolerancesAndFlags(index, NULL);
+    case ON_COMPONENT_INDEX::brep_loop:   return brep.IsValidLoopTolerancesAndFlags(index, NULL);
+    case ON_COMPONENT_INDEX::brep_face:   return brep.IsValidFaceTolerancesAndFlags(index, NULL);
+    }
+    break;
+  }
+  return false;
+}
+
+bool CRhCmnBrepValidator::RunTask(void* context, int index, int thread_index)
+{
+  CRhCmnBrepValidator* validator = (CRhCmnBrepValidator*)context;
+  const CTask& task = validator->m_tasks[index];
+  const ON_Brep& brep = *validator->m_breps[task.m_brep];
+  ON_SimpleArray<CError>& errors = validator->m_thread_errors[thread_index];
+  for( int i=task.m_first; i<task.m_first+task.m_count; i++ )
+  {
+    if( !validator->Check(brep, task.m_type, i) )
+    {
+      CError& e = errors.AppendNew();
+      e.m_brep = task.m_brep;
+      e.m_type = task.m_type;
+      e.m_index = i;
+      e.m_code = validator->m_code;
+    }
+  }
+  return true;
+}
+
+void CRhCmnBrepValidator::AddTasks(int brep, int type, int count)
+{
+  for( int first=0; first<count; first += block_size )
+  {
+    CTask& task = m_tasks.AppendNew();
+    task.m_brep = brep;
+    task.m_type = type;
+    task.m_first = first;
+    task.m_count = (count-first < block_size) ? count-first : block_size;
+  }
+}
+
+void CRhCmnBrepValidator::RunPass(int code, int thread_count)
+{
+  m_code = code;
+  m_tasks.SetCount(0);
+  for( int b=0; b<m_brep_count; b++ )
+  {
+    if( !m_bValid[b] )
+      continue;
+    const ON_Brep* brep = m_breps[b];
+    AddTasks(b, ON_COMPONENT_INDEX::brep_vertex, brep->m_V.Count());
+    AddTasks(b, ON_COMPONENT_INDEX::brep_edge, brep->m_E.Count());
+    AddTasks(b, ON_COMPONENT_INDEX::brep_trim, brep->m_T.Count());
+    AddTasks(b, ON_COMPONENT_INDEX::brep_loop, brep->m_L.Count());
+    AddTasks(b, ON_COMPONENT_INDEX::brep_face, brep->m_F.Count());
+  }
+  RhCmnParallelFor(thread_count, m_tasks.Count(), RunTask, this);
+
+  for( int i=0; i<m_thread_errors.Count(); i++ )
+  {
+    ON_SimpleArray<CError>& errors = m_thread_errors[i];
+    for( int j=0; j<errors.Count(); j++ )
+      m_bValid[errors[j].m_brep] = false;
+    m_errors.Append(errors.Count(), errors.Array());
+    errors.SetCount(0);
+  }
+}
+
+int CRhCmnBrepValidator::Validate(int level, int thread_count, ON_SimpleArray<int>& errors)
+{
+  int b;
+  m_bValid.Reserve(m_brep_count);
+  for( b=0; b<m_brep_count; b++ )
+  {
+    const ON_Brep* brep = m_breps[b];
+    bool bValid = (NULL != brep);
+    if( bValid && 0 == brep->m_F.Count() && 0 == brep->m_E.Count() && 0 == brep->m_V.Count() )
+      bValid = false; // ON_Brep::IsValidTopology rejects empty breps
+    m_bValid.Append(bValid);
+    if( !bValid )
+    {
+      CError& e = m_errors.AppendNew();
+      e.m_brep = b;
+      e.m_type = ON_COMPONENT_INDEX::invalid_type;
+      e.m_index = -1;
+      e.m_code = invalid_topology;
+    }
+  }
+
+  if( thread_count < 1 )
+    thread_count = RhCmnMaxThreadCount();
+  m_thread_errors.Reserve(thread_count);
+  for( int i=0; i<thread_count; i++ )
+    m_thread_errors.AppendNew();
+
+  RunPass(invalid_topology, thread_count);
+  if( level >= geometry )
+    RunPass(invalid_geometry, thread_count);
+  if( level >= tolerances_and_flags )
+    RunPass(invalid_tolerances_and_flags, thread_count);
+
+  m_errors.QuickSort(CompareError);
+  errors.Reserve(errors.Count() + 4*m_errors.Count());
+  for( int i=0; i<m_errors.Count(); i++ )
+  {
+    errors.Append(m_errors[i].m_brep);
+    errors.Append(m_errors[i].m_type);
+    errors.Append(m_errors[i].m_index);
+    errors.Append(m_errors[i].m_code);
+  }
+
+  int rc = 0;
+  for( b=0; b<m_brep_count; b++ )
+  {
+    if( !m_bValid[b] )
+      rc++;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION int ON_Brep_ValidateBreps(const ON_SimpleArray<const ON_Brep*>* pConstBreps, int level, int threadCount, ON_SimpleArray<int>* errors)
+{
+  int rc = 0;
+  if( pConstBreps && errors )
+  {
+    CRhCmnBrepValidator validator(pConstBreps->Array(), pConstBreps->Count());
+    rc = validator.Validate(level, threadCount, *errors);
+  }
+  return rc;
+}
+
 RH_C_FUNCTION ON_Brep* ONC_BrepFromMesh( const ON_Mesh* pConstMesh, bool bTrimmedTriangles)
 {
   ON_Brep* rc = NULL;
@@ -337,6 +595,595 @@ RH_C_FUNCTION ON_Brep* ONC_BrepFromMesh( const ON_Mesh* pConstMesh, bool bTrimme
   return rc;
 }
 
+// Builds a brep from a mesh where edge connected faces that lie in the same
+// plane are merged into one planar face bounded by polygon loops. Quads are
+// split along their 0-2 diagonal; the diagonal disappears whenever both
+// halves land in the same region. Regions whose boundary is not a set of
+// simple loops fall back to one face per triangle.
+class CRhCmnBrepFromMesh
+{
+public:
+  CRhCmnBrepFromMesh(const ON_Mesh& mesh, double angle_tolerance, double distance_tolerance);
+  ~CRhCmnBrepFromMesh();
+
+  ON_Brep* Create(int thread_count);
+
+private:
+  struct CTri
+  {
+    int m_v[3];      // topology vertex indices
+    ON_3dVector m_n; // cross product of the sides, length = 2*area
+    int m_region;    // -1 = not assigned yet, -2 = dropped
+  };
+  struct CHalf
+  {
+    ON__UINT64 m_key; // sorted vertex pair of the side
+    int m_tri;
+    int m_side;
+  };
+  struct CRegion
+  {
+    int m_tri_index; // first entry in m_region_tris
+    int m_tri_count;
+    bool m_bFailed;
+    ON_Plane m_plane;
+    double m_deviation; // largest distance from a boundary vertex to m_plane
+    ON_PlaneSurface* m_srf;
+    ON_SimpleArray<int> m_loop_sizes; // outer loop first
+    ON_SimpleArray<int> m_sides;      // boundary sides as 3*tri+side, loop by loop
+    ON_SimpleArray<ON_Curve*> m_c2;   // one trim curve per boundary side
+  };
+
+  static bool SetupTri(void* context, int index, int thread_index);
+  static bool RunRegion(void* context, int index, int thread_index);
+  static int CompareHalf(const CHalf* a, const CHalf* b);
+  int Neighbor(int tri, int side) const;
+  bool Accept(int tri, const ON_3dVector& normal, const ON_3dPoint& origin) const;
+  void GrowRegions();
+  void BuildRegion(CRegion& region) const;
+  void ClearRegion(CRegion& region) const;
+
+  const ON_Mesh& m_mesh;
+  const double m_cos_angle;
+  const double m_distance_tolerance;
+  ON_3dPointArray m_P;           // one point per topology vertex
+  ON_SimpleArray<CTri> m_tris;
+  ON_SimpleArray<CHalf> m_halves; // sorted by m_key
+  ON_SimpleArray<int> m_edge_start; // edge e owns m_halves[m_edge_start[e]..m_edge_start[e+1])
+  ON_SimpleArray<int> m_side_edge;  // 3*tri+side -> edge
+  ON_SimpleArray<int> m_region_tris;
+  ON_ClassArray<CRegion> m_regions;
+  int m_run_first; // RunRegion builds m_regions[m_run_first+index]
+
+  // no copies
+  CRhCmnBrepFromMesh(const CRhCmnBrepFromMesh&);
+  CRhCmnBrepFromMesh& operator=(const CRhCmnBrepFromMesh&);
+};
+
+CRhCmnBrepFromMesh::CRhCmnBrepFromMesh(const ON_Mesh& mesh, double angle_tolerance, double distance_tolerance)
+: m_mesh(mesh)
+, m_cos_angle(cos(angle_tolerance > 0.0 ? angle_tolerance : 0.0))
+, m_distance_tolerance(distance_tolerance > 0.0 ? distance_tolerance : 0.0)
+, m_run_first(0)
+{
+}
+
+CRhCmnBrepFromMesh::~CRhCmnBrepFromMesh()
+{
+  for( int i=0; i<m_regions.Count(); i++ )
+    ClearRegion(m_regions[i]);
+}
+
+void CRhCmnBrepFromMesh::ClearRegion(CRegion& region) const
+{
+  if( region.m_srf )
+    delete region.m_srf;
+  region.m_srf = NULL;
+  for( int i=0; i<region.m_c2.Count(); i++ )
+  {
+    if( region.m_c2[i] )
+      delete region.m_c2[i];
+  }
+  region.m_c2.Empty();
+}
+
+bool CRhCmnBrepFromMesh::SetupTri(void* context, int index, int)
+{
+  CRhCmnBrepFromMesh* pThis = (CRhCmnBrepFromMesh*)context;
+  CTri& tri = pThis->m_tris[index];
+  const ON_3dPoint& A = pThis->m_P[tri.m_v[0]];
+  const ON_3dPoint& B = pThis->m_P[tri.m_v[1]];
+  const ON_3dPoint& C = pThis->m_P[tri.m_v[2]];
+  tri.m_n = ON_CrossProduct(B-A, C-A);
+  return true;
+}
+
+int CRhCmnBrepFromMesh::CompareHalf(const CHalf* a, const CHalf* b)
+{
+  if( a->m_key < b->m_key )
+    return -1;
+  if( a->m_key > b->m_key )
+    return 1;
+  return (a->m_tri < b->m_tri) ? -1 : ((a->m_tri > b->m_tri) ? 1 : (a->m_side - b->m_side));
+}
+
+int CRhCmnBrepFromMesh::Neighbor(int tri, int side) const
+{
+  const int e = m_side_edge[3*tri+side];
+  const int start = m_edge_start[e];
+  if( m_edge_start[e+1] - start != 2 )
+    return -1;
+  const CHalf& h0 = m_halves[start];
+  const CHalf& other = (h0.m_tri==tri && h0.m_side==side) ? m_halves[start+1] : h0;
+  // consistently oriented neighbors run along the shared side in opposite directions
+  const CTri& T = m_tris[other.m_tri];
+  if( T.m_v[other.m_side] != m_tris[tri].m_v[(side+1)%3] )
+    return -1;
+  return other.m_tri;
+}
+
+bool CRhCmnBrepFromMesh::Accept(int tri, const ON_3dVector& normal, const ON_3dPoint& origin) const
+{
+  const CTri& T = m_tris[tri];
+  ON_3dVector n = T.m_n;
+  if( n.Unitize() && n*normal < m_cos_angle )
+    return false;
+  for( int i=0; i<3; i++ )
+  {
+    if( fabs((m_P[T.m_v[i]]-origin)*normal) > m_distance_tolerance )
+      return false;
+  }
+  return true;
+}
+
+void CRhCmnBrepFromMesh::GrowRegions()
+{
+  const int tri_count = m_tris.Count();
+  m_region_tris.Reserve(tri_count);
+  ON_SimpleArray<int> stack(64);
+  for( int seed=0; seed<tri_count; seed++ )
+  {
+    if( m_tris[seed].m_region != -1 )
+      continue;
+    ON_3dVector normal = m_tris[seed].m_n;
+    if( !normal.Unitize() )
+      continue; // degenerate triangles never start a region
+    const ON_3dPoint origin = m_P[m_tris[seed].m_v[0]];
+
+    CRegion& region = m_regions.AppendNew();
+    region.m_tri_index = m_region_tris.Count();
+    region.m_tri_count = 0;
+    region.m_bFailed = false;
+    region.m_deviation = 0.0;
+    region.m_srf = NULL;
+    const int region_index = m_regions.Count()-1;
+
+    m_tris[seed].m_region = region_index;
+    stack.Append(seed);
+    while( stack.Count() > 0 )
+    {
+      const int t = *stack.Last();
+      stack.SetCount(stack.Count()-1);
+      m_region_tris.Append(t);
+      region.m_tri_count++;
+      for( int side=0; side<3; side++ )
+      {
+        const int nbr = Neighbor(t, side);
+        if( nbr >= 0 && m_tris[nbr].m_region == -1 && Accept(nbr, normal, origin) )
+        {
+          m_tris[nbr].m_region = region_index;
+          stack.Append(nbr);
+        }
+      }
+    }
+  }
+
+  // degenerate triangles that no region picked up are left out
+  for( int i=0; i<tri_count; i++ )
+  {
+    if( m_tris[i].m_region == -1 )
+      m_tris[i].m_region = -2;
+  }
+}
+
+bool CRhCmnBrepFromMesh::RunRegion(void* context, int index, int)
+{
+  CRhCmnBrepFromMesh* pThis = (CRhCmnBrepFromMesh*)context;
+  pThis->BuildRegion(pThis->m_regions[pThis->m_run_first+index]);
+  return true;
+}
+
+void CRhCmnBrepFromMesh::BuildRegion(CRegion& region) const
+{
+  region.m_bFailed = true;
+  const int* tris = m_region_tris.Array() + region.m_tri_index;
+  const int region_index = m_tris[tris[0]].m_region;
+
+  // area weighted plane of the region
+  ON_3dVector N(0.0,0.0,0.0);
+  ON_3dVector C(0.0,0.0,0.0);
+  double area = 0.0;
+  int i, j;
+  for( i=0; i<region.m_tri_count; i++ )
+  {
+    const CTri& T = m_tris[tris[i]];
+    const double a = T.m_n.Length();
+    N = N + T.m_n;
+    C = C + (a/3.0)*(ON_3dVector(m_P[T.m_v[0]]) + ON_3dVector(m_P[T.m_v[1]]) + ON_3dVector(m_P[T.m_v[2]]));
+    area += a;
+  }
+  if( !(area > 0.0) || !N.Unitize() )
+    return;
+  ON_Plane plane(ON_3dPoint(C/area), N);
+  if( !plane.IsValid() )
+    return;
+
+  // boundary sides keyed by their start vertex
+  ON_SimpleArray<ON__UINT64> keys(3*region.m_tri_count);
+  for( i=0; i<region.m_tri_count; i++ )
+  {
+    const int t = tris[i];
+    for( int side=0; side<3; side++ )
+    {
+      const int nbr = Neighbor(t, side);
+      if( nbr < 0 || m_tris[nbr].m_region != region_index )
+        keys.Append( (((ON__UINT64)m_tris[t].m_v[side])<<32) | (ON__UINT64)(3*t+side) );
+    }
+  }
+  const int side_count = keys.Count();
+  if( side_count < 3 )
+    return;
+  keys.QuickSort(ON_CompareIncreasing<ON__UINT64>);
+  for( i=1; i<side_count; i++ )
+  {
+    // the region touches itself at a vertex
+    if( (keys[i]>>32) == (keys[i-1]>>32) )
+      return;
+  }
+
+  // chain the sides into loops
+  ON_SimpleArray<bool> used(side_count);
+  used.SetCount(side_count);
+  used.Zero();
+  ON_SimpleArray<int> sides(side_count);
+  ON_SimpleArray<int> loop_sizes;
+  for( i=0; i<side_count; i++ )
+  {
+    if( used[i] )
+      continue;
+    int loop_size = 0;
+    int k = i;
+    for(;;)
+    {
+      used[k] = true;
+      const int sid = (int)(keys[k] & 0xFFFFFFFF);
+      sides.Append(sid);
+      loop_size++;
+      const ON__UINT64 end = (ON__UINT64)m_tris[sid/3].m_v[(sid%3+1)%3];
+      int lo = 0, hi = side_count;
+      while( lo < hi )
+      {
+        const int mid = (lo+hi)/2;
+        if( (keys[mid]>>32) < end )
+          lo = mid+1;
+        else
+          hi = mid;
+      }
+      if( lo >= side_count || (keys[lo]>>32) != end )
+        return;
+      if( lo == i )
+        break;
+      if( used[lo] )
+        return;
+      k = lo;
+    }
+    loop_sizes.Append(loop_size);
+  }
+
+  // 2d corners and the outer loop
+  ON_SimpleArray<ON_2dPoint> uv(side_count);
+  double deviation = 0.0;
+  for( i=0; i<side_count; i++ )
+  {
+    const ON_3dPoint& P = m_P[m_tris[sides[i]/3].m_v[sides[i]%3]];
+    ON_2dPoint& p = uv.AppendNew();
+    plane.ClosestPointTo(P, &p.x, &p.y);
+    const double d = fabs(plane.DistanceTo(P));
+    if( d > deviation )
+      deviation = d;
+  }
+  int outer = -1;
+  int start = 0;
+  for( i=0; i<loop_sizes.Count(); i++ )
+  {
+    double twice_area = 0.0;
+    for( j=0; j<loop_sizes[i]; j++ )
+    {
+      const ON_2dPoint& p0 = uv[start+j];
+      const ON_2dPoint& p1 = uv[start+(j+1)%loop_sizes[i]];
+      twice_area += p0.x*p1.y - p1.x*p0.y;
+    }
+    if( twice_area > 0.0 )
+    {
+      if( outer >= 0 )
+        return;
+      outer = i;
+    }
+    else if( !(twice_area < 0.0) )
+      return;
+    start += loop_sizes[i];
+  }
+  if( outer < 0 )
+    return;
+
+  // outer loop first, the holes follow in their original order
+  region.m_loop_sizes.Reserve(loop_sizes.Count());
+  region.m_sides.Reserve(side_count);
+  region.m_c2.Reserve(side_count);
+  double umin = uv[0].x, umax = uv[0].x, vmin = uv[0].y, vmax = uv[0].y;
+  for( int pass=0; pass<2; pass++ )
+  {
+    start = 0;
+    for( i=0; i<loop_sizes.Count(); i++ )
+    {
+      const int n = loop_sizes[i];
+      if( (0 == pass) == (i == outer) )
+      {
+        region.m_loop_sizes.Append(n);
+        for( j=0; j<n; j++ )
+        {
+          const ON_2dPoint& p0 = uv[start+j];
+          const ON_2dPoint& p1 = uv[start+(j+1)%n];
+          region.m_sides.Append(sides[start+j]);
+          region.m_c2.Append(new ON_LineCurve(p0, p1));
+          if( p0.x < umin ) umin = p0.x;
+          if( p0.x > umax ) umax = p0.x;
+          if( p0.y < vmin ) vmin = p0.y;
+          if( p0.y > vmax ) vmax = p0.y;
+        }
+      }
+      start += n;
+    }
+  }
+  if( !(umax > umin) || !(vmax > vmin) )
+  {
+    ClearRegion(region);
+    region.m_loop_sizes.Empty();
+    region.m_sides.Empty();
+    return;
+  }
+
+  region.m_srf = new ON_PlaneSurface(plane);
+  region.m_srf->SetExtents(0, ON_Interval(umin, umax), true);
+  region.m_srf->SetExtents(1, ON_Interval(vmin, vmax), true);
+  region.m_plane = plane;
+  region.m_deviation = deviation;
+  region.m_bFailed = false;
+}
+
+ON_Brep* CRhCmnBrepFromMesh::Create(int thread_count)
+{
+  const ON_MeshTopology& top = m_mesh.Topology();
+  const int topv_count = top.m_topv.Count();
+  if( topv_count < 3 || top.m_topv_map.Count() != m_mesh.m_V.Count() )
+    return NULL;
+
+  int i, j;
+  m_P.SetCapacity(topv_count);
+  for( i=0; i<topv_count; i++ )
+    m_P.Append(ON_3dPoint(m_mesh.m_V[top.m_topv[i].m_vi[0]]));
+
+  // triangles, leaving out those with repeated vertices
+  const int face_count = m_mesh.m_F.Count();
+  m_tris.Reserve(face_count + m_mesh.QuadCount());
+  for( i=0; i<face_count; i++ )
+  {
+    const ON_MeshFace& f = m_mesh.m_F[i];
+    int v[4];
+    for( j=0; j<4; j++ )
+      v[j] = top.m_topv_map[f.vi[j]];
+    for( j=0; j<2; j++ )
+    {
+      if( 1 == j && v[2] == v[3] )
+        break;
+      const int a = v[0], b = v[j+1], c = v[j+2];
+      if( a == b || b == c || c == a )
+        continue;
+      CTri& tri = m_tris.AppendNew();
+      tri.m_v[0] = a;
+      tri.m_v[1] = b;
+      tri.m_v[2] = c;
+      tri.m_region = -1;
+    }
+  }
+  const int tri_count = m_tris.Count();
+  if( tri_count < 1 )
+    return NULL;
+  RhCmnParallelFor(thread_count, tri_count, SetupTri, this);
+
+  // undirected edges shared by triangle sides
+  m_halves.SetCapacity(3*tri_count);
+  for( i=0; i<tri_count; i++ )
+  {
+    for( j=0; j<3; j++ )
+    {
+      ON__UINT64 a = (ON__UINT64)m_tris[i].m_v[j];
+      ON__UINT64 b = (ON__UINT64)m_tris[i].m_v[(j+1)%3];
+      if( a > b )
+      {
+        const ON__UINT64 t = a; a = b; b = t;
+      }
+      CHalf& h = m_halves.AppendNew();
+      h.m_key = (a<<32) | b;
+      h.m_tri = i;
+      h.m_side = j;
+    }
+  }
+  m_halves.QuickSort(CompareHalf);
+  m_side_edge.SetCapacity(3*tri_count);
+  m_side_edge.SetCount(3*tri_count);
+  m_edge_start.Reserve(3*tri_count/2 + 2);
+  for( i=0; i<m_halves.Count(); i++ )
+  {
+    if( 0 == i || m_halves[i].m_key != m_halves[i-1].m_key )
+      m_edge_start.Append(i);
+    m_side_edge[3*m_halves[i].m_tri + m_halves[i].m_side] = m_edge_start.Count()-1;
+  }
+  const int edge_count = m_edge_start.Count();
+  m_edge_start.Append(m_halves.Count());
+
+  GrowRegions();
+  int region_count = m_regions.Count();
+  RhCmnParallelFor(thread_count, region_count, RunRegion, this);
+
+  // split the failures into single triangles and try once more
+  for( i=0; i<region_count; i++ )
+  {
+    if( !m_regions[i].m_bFailed )
+      continue;
+    const int tri_index = m_regions[i].m_tri_index;
+    const int count = m_regions[i].m_tri_count;
+    m_regions[i].m_tri_count = 0;
+    for( j=0; j<count; j++ )
+    {
+      CRegion& single = m_regions.AppendNew();
+      single.m_tri_index = tri_index+j;
+      single.m_tri_count = 1;
+      single.m_bFailed = false;
+      single.m_deviation = 0.0;
+      single.m_srf = NULL;
+      m_tris[m_region_tris[tri_index+j]].m_region = m_regions.Count()-1;
+    }
+  }
+  if( m_regions.Count() > region_count )
+  {
+    m_run_first = region_count;
+    RhCmnParallelFor(thread_count, m_regions.Count()-region_count, RunRegion, this);
+    region_count = m_regions.Count();
+  }
+
+  // size everything up front so the topology arrays never grow
+  ON_SimpleArray<int> vertex_map(topv_count);
+  vertex_map.SetCount(topv_count);
+  ON_SimpleArray<int> edge_map(edge_count);
+  edge_map.SetCount(edge_count);
+  for( i=0; i<topv_count; i++ )
+    vertex_map[i] = -1;
+  for( i=0; i<edge_count; i++ )
+    edge_map[i] = -1;
+  int brep_face_count = 0, brep_loop_count = 0, brep_trim_count = 0;
+  for( i=0; i<region_count; i++ )
+  {
+    const CRegion& region = m_regions[i];
+    if( region.m_bFailed || NULL == region.m_srf )
+      continue;
+    brep_face_count++;
+    brep_loop_count += region.m_loop_sizes.Count();
+    brep_trim_count += region.m_sides.Count();
+    for( j=0; j<region.m_sides.Count(); j++ )
+    {
+      const int sid = region.m_sides[j];
+      edge_map[m_side_edge[sid]] = 0;
+      vertex_map[m_tris[sid/3].m_v[sid%3]] = 0;
+    }
+  }
+  if( brep_face_count < 1 )
+    return NULL;
+
+  int brep_vertex_count = 0, brep_edge_count = 0;
+  for( i=0; i<topv_count; i++ )
+  {
+    if( 0 == vertex_map[i] )
+      vertex_map[i] = brep_vertex_count++;
+  }
+  for( i=0; i<edge_count; i++ )
+  {
+    if( 0 == edge_map[i] )
+      edge_map[i] = brep_edge_count++;
+  }
+
+  ON_Brep* brep = ON_Brep::New();
+  brep->m_V.Reserve(brep_vertex_count);
+  brep->m_E.Reserve(brep_edge_count);
+  brep->m_C3.Reserve(brep_edge_count);
+  brep->m_T.Reserve(brep_trim_count);
+  brep->m_C2.Reserve(brep_trim_count);
+  brep->m_L.Reserve(brep_loop_count);
+  brep->m_F.Reserve(brep_face_count);
+  brep->m_S.Reserve(brep_face_count);
+
+  for( i=0; i<topv_count; i++ )
+  {
+    if( vertex_map[i] >= 0 )
+      brep->NewVertex(m_P[i], 0.0);
+  }
+  for( i=0; i<edge_count; i++ )
+  {
+    if( edge_map[i] < 0 )
+      continue;
+    const ON__UINT64 key = m_halves[m_edge_start[i]].m_key;
+    const int a = (int)(key>>32);
+    const int b = (int)(key & 0xFFFFFFFF);
+    const int c3i = brep->AddEdgeCurve(new ON_LineCurve(m_P[a], m_P[b]));
+    brep->NewEdge(brep->m_V[vertex_map[a]], brep->m_V[vertex_map[b]], c3i, NULL, 0.0);
+  }
+
+  for( i=0; i<region_count; i++ )
+  {
+    CRegion& region = m_regions[i];
+    if( region.m_bFailed || NULL == region.m_srf )
+      continue;
+    const int si = brep->AddSurface(region.m_srf);
+    region.m_srf = NULL;
+    ON_BrepFace& face = brep->NewFace(si);
+    int k = 0;
+    for( int li=0; li<region.m_loop_sizes.Count(); li++ )
+    {
+      ON_BrepLoop& loop = brep->NewLoop(0 == li ? ON_BrepLoop::outer : ON_BrepLoop::inner, face);
+      for( j=0; j<region.m_loop_sizes[li]; j++, k++ )
+      {
+        const int sid = region.m_sides[k];
+        const int a = m_tris[sid/3].m_v[sid%3];
+        const int c2i = brep->AddTrimCurve(region.m_c2[k]);
+        region.m_c2[k] = NULL;
+        ON_BrepEdge& edge = brep->m_E[edge_map[m_side_edge[sid]]];
+        const bool bRev3d = (edge.m_vi[0] != vertex_map[a]);
+        ON_BrepTrim& trim = brep->NewTrim(edge, bRev3d, loop, c2i);
+        trim.m_tolerance[0] = 0.0;
+        trim.m_tolerance[1] = 0.0;
+        if( region.m_deviation > edge.m_tolerance )
+          edge.m_tolerance = region.m_deviation;
+      }
+    }
+  }
+
+  for( i=0; i<brep->m_E.Count(); i++ )
+  {
+    const ON_BrepEdge& edge = brep->m_E[i];
+    for( j=0; j<2; j++ )
+    {
+      ON_BrepVertex& vertex = brep->m_V[edge.m_vi[j]];
+      if( edge.m_tolerance > vertex.m_tolerance )
+        vertex.m_tolerance = edge.m_tolerance;
+    }
+  }
+
+  brep->SetTrimIsoFlags();
+  brep->SetTolerancesBoxesAndFlags(true);
+  return brep;
+}
+
+RH_C_FUNCTION ON_Brep* ONC_BrepFromMeshMergeCoplanar( const ON_Mesh* pConstMesh, double angleTolerance, double distanceTolerance, int threadCount)
+{
+  ON_Brep* rc = NULL;
+  if( pConstMesh )
+  {
+    CRhCmnBrepFromMesh builder(*pConstMesh, angleTolerance, distanceTolerance);
+    rc = builder.Create(threadCount);
+  }
+  return rc;
+}
+
 RH_C_FUNCTION ON_Brep* ON_Brep_FromBox( ON_3DPOINT_STRUCT boxmin, ON_3DPOINT_STRUCT boxmax)
 {
   ON_Brep* rc = NULL;
@@ -433,6 +1280,395 @@ RH_C_FUNCTION void ON_Brep_DuplicateEdgeCurves(const ON_Brep* pConstBrep, ON_Sim
   }
 }
 
+// Appends points on curve between t0 and t1 to points so that no point of
+// the curve is further than tolerance from the polyline. The point at t0 is
+// never added; the caller appends it before the first call.
+static void RhCmnFlattenCurveHelper(const ON_Curve& curve, double t0, const ON_3dPoint& P0, double t1, const ON_3dPoint& P1, double tolerance, int depth, ON_3dPointArray& points)
+{
+  if( depth < 12 )
+  {
+    // quarter points catch S shapes that cross the chord at the middle
+    const ON_Line chord(P0, P1);
+    const double length = chord.Length();
+    for( int i=1; i<4; i++ )
+    {
+      const ON_3dPoint P = curve.PointAt(t0 + 0.25*i*(t1-t0));
+      double d;
+      if( length > 0.0 )
+      {
+        double s = 0.0;
+        chord.ClosestPointTo(P, &s);
+        d = P.DistanceTo(chord.PointAt(s < 0.0 ? 0.0 : (s > 1.0 ? 1.0 : s)));
+      }
+      else
+        d = P.DistanceTo(P0);
+      if( d > tolerance )
+      {
+        const double tm = 0.5*(t0+t1);
+        const ON_3dPoint Pm = curve.PointAt(tm);
+        RhCmnFlattenCurveHelper(curve, t0, P0, tm, Pm, tolerance, depth+1, points);
+        RhCmnFlattenCurveHelper(curve, tm, Pm, t1, P1, tolerance, depth+1, points);
+        return;
+      }
+    }
+  }
+  points.Append(P1);
+}
+
+// Appends a polyline approximation of curve over domain to points. Spans
+// are flattened one at a time so kinks at knots are kept.
+static void RhCmnFlattenCurve(const ON_Curve& curve, ON_Interval domain, double tolerance, ON_3dPointArray& points)
+{
+  const int span_count = curve.SpanCount();
+  ON_SimpleArray<double> knots(span_count+1);
+  knots.SetCount(span_count+1);
+  if( span_count < 1 || !curve.GetSpanVector(knots.Array()) )
+  {
+    knots.SetCount(2);
+    knots[0] = domain[0];
+    knots[1] = domain[1];
+  }
+
+  double t0 = domain[0];
+  ON_3dPoint P0 = curve.PointAt(t0);
+  points.Append(P0);
+  for( int i=0; i<knots.Count(); i++ )
+  {
+    const double t1 = (i == knots.Count()-1 || knots[i] >= domain[1]) ? domain[1] : knots[i];
+    if( t1 > t0 )
+    {
+      const ON_3dPoint P1 = curve.PointAt(t1);
+      RhCmnFlattenCurveHelper(curve, t0, P0, t1, P1, tolerance, 0, points);
+      t0 = t1;
+      P0 = P1;
+    }
+    if( t1 >= domain[1] )
+      break;
+  }
+}
+
+// Edges and trimmed isocurves of a list of breps. Every edge and every face
+// is an independent work item; items are spread over worker threads and the
+// pieces they make are put back in item order at the end, so the results do
+// not depend on the number of threads.
+class CRhCmnBrepWireframe
+{
+public:
+  enum KIND
+  {
+    edge_curve = 0,
+    iso_curve_u = 1, // runs in the u direction at a constant v
+    iso_curve_v = 2  // runs in the v direction at a constant u
+  };
+
+  // edge_filter: 0 = all edges, 1 = naked edges, 2 = interior edges.
+  // iso_count isocurves in each direction are placed evenly on every face.
+  // When tolerance > 0 the curves are returned as polylines.
+  CRhCmnBrepWireframe(const ON_Brep* const* breps, int brep_count, int edge_filter, int iso_count, double tolerance);
+  ~CRhCmnBrepWireframe();
+
+  // info gets 4 ints per piece: brep index, KIND, edge or face index and
+  // the number of polyline points. Curves are only returned when not
+  // flattening, points only when flattening.
+  int Create(int thread_count, ON_SimpleArray<int>& info, ON_SimpleArray<ON_Curve*>* curves, ON_3dPointArray* points);
+
+private:
+  struct CPiece
+  {
+    int m_item;
+    int m_kind;
+    ON_Curve* m_curve;  // when not flattening
+    int m_point_index;  // first point in the thread's m_points
+    int m_point_count;
+  };
+  struct CThreadData
+  {
+    ON_SimpleArray<CPiece> m_pieces;
+    ON_3dPointArray m_points;
+    ON_SimpleArray<double> m_crossings;
+  };
+  struct CItem
+  {
+    int m_brep;
+    int m_edge; // -1 for faces
+    int m_face;
+  };
+
+  static bool RunItem(void* context, int index, int thread_index);
+  static int ComparePiece(const CPiece* a, const CPiece* b);
+  void AddPiece(int item, int kind, ON_Curve* curve, const ON_Interval& domain, CThreadData& data) const;
+  void DoEdge(int item, const ON_Brep& brep, const ON_BrepEdge& edge, CThreadData& data) const;
+  void DoFace(int item, const ON_BrepFace& face, CThreadData& data) const;
+  static void GetCrossings(const ON_BrepFace& face, int k, double c, ON_SimpleArray<double>& crossings);
+
+  const ON_Brep* const* m_breps;
+  const int m_brep_count;
+  const int m_edge_filter;
+  const int m_iso_count;
+  const double m_tolerance;
+  ON_SimpleArray<CItem> m_items;
+  ON_ClassArray<CThreadData> m_thread_data;
+};
+
+CRhCmnBrepWireframe::CRhCmnBrepWireframe(const ON_Brep* const* breps, int brep_count, int edge_filter, int iso_count, double tolerance)
+: m_breps(breps)
+, m_brep_count(breps ? brep_count : 0)
+, m_edge_filter(edge_filter)
+, m_iso_count(iso_count > 0 ? iso_count : 0)
+, m_tolerance(ON_IsValid(tolerance) && tolerance > 0.0 ? tolerance : 0.0)
+{
+}
+
+CRhCmnBrepWireframe::~CRhCmnBrepWireframe()
+{
+  // curves that were not handed out
+  for( int i=0; i<m_thread_data.Count(); i++ )
+  {
+    for( int j=0; j<m_thread_data[i].m_pieces.Count(); j++ )
+    {
+      if( m_thread_data[i].m_pieces[j].m_curve )
+        delete m_thread_data[i].m_pieces[j].m_curve;
+    }
+  }
+}
+
+int CRhCmnBrepWireframe::ComparePiece(const CPiece* a, const CPiece* b)
+{
+  if( a->m_item != b->m_item )
+    return a->m_item < b->m_item ? -1 : 1;
+  if( a->m_kind != b->m_kind )
+    return a->m_kind < b->m_kind ? -1 : 1;
+  // pieces of one item are made in order by one thread
+  if( a->m_point_index != b->m_point_index )
+    return a->m_point_index < b->m_point_index ? -1 : 1;
+  return 0;
+}
+
+void CRhCmnBrepWireframe::AddPiece(int item, int kind, ON_Curve* curve, const ON_Interval& domain, CThreadData& data) const
+{
+  CPiece& piece = data.m_pieces.AppendNew();
+  piece.m_item = item;
+  piece.m_kind = kind;
+  piece.m_curve = 0;
+  piece.m_point_index = data.m_points.Count();
+  piece.m_point_count = 0;
+  if( m_tolerance > 0.0 )
+  {
+    RhCmnFlattenCurve(*curve, domain, m_tolerance, data.m_points);
+    piece.m_point_count = data.m_points.Count() - piece.m_point_index;
+    delete curve;
+  }
+  else
+  {
+    // m_point_index still orders the pieces of an item
+    piece.m_point_index = data.m_pieces.Count();
+    if( domain != curve->Domain() )
+      curve->Trim(domain);
+    piece.m_curve = curve;
+  }
+}
+
+void CRhCmnBrepWireframe::DoEdge(int item, const ON_Brep& brep, const ON_BrepEdge& edge, CThreadData& data) const
+{
+  const int trim_count = edge.m_ti.Count();
+  if( trim_count < 1 )
+    return;
+  if( 1 == m_edge_filter && 1 != trim_count )
+    return;
+  if( 2 == m_edge_filter && trim_count < 2 )
+    return;
+  ON_Curve* curve = edge.DuplicateCurve();
+  if( 0 == curve )
+    return;
+  // same direction as ON_Brep_DuplicateEdgeCurves
+  const ON_BrepTrim& trim = brep.m_T[edge.m_ti[0]];
+  if( trim.m_bRev3d )
+    curve->Reverse();
+  if( trim.Face() && trim.Face()->m_bRev )
+    curve->Reverse();
+  AddPiece(item, edge_curve, curve, curve->Domain(), data);
+}
+
+// Parameters along the other coordinate where the line with coordinate k
+// equal to c crosses the face's trims, sorted.
+void CRhCmnBrepWireframe::GetCrossings(const ON_BrepFace& face, int k, double c, ON_SimpleArray<double>& crossings)
+{
+  crossings.SetCount(0);
+  const int m = 1-k;
+  for( int li=0; li<face.LoopCount(); li++ )
+  {
+    const ON_BrepLoop* loop = face.Loop(li);
+    if( 0 == loop || (ON_BrepLoop::outer != loop->m_type && ON_BrepLoop::inner != loop->m_type) )
+      continue;
+    for( int ti=0; ti<loop->TrimCount(); ti++ )
+    {
+      const ON_BrepTrim* trim = loop->Trim(ti);
+      if( 0 == trim || ON_BrepTrim::singular == trim->m_type )
+        continue;
+      // Sample every span so crossings are not missed, then bisect each
+      // sign change on the trim itself.
+      const int span_count = trim->SpanCount();
+      ON_SimpleArray<double> knots(span_count+1);
+      knots.SetCount(span_count+1);
+      if( span_count < 1 || !trim->GetSpanVector(knots.Array()) )
+        continue;
+      const int per_span = trim->Degree() > 1 ? 8 : 1;
+      double ta = knots[0];
+      double ya = trim->PointAt(ta)[k];
+      for( int s=0; s<span_count; s++ )
+      {
+        for( int j=1; j<=per_span; j++ )
+        {
+          const double tb = (j == per_span) ? knots[s+1] : knots[s] + j*(knots[s+1]-knots[s])/per_span;
+          const double yb = trim->PointAt(tb)[k];
+          // half open test so a crossing at a sample point is counted once
+          if( (ya > c) != (yb > c) )
+          {
+            double t0 = ta, t1 = tb;
+            const bool bUp = yb > c;
+            for( int n=0; n<50 && t1 - t0 > ON_EPSILON*(fabs(t0)+fabs(t1)); n++ )
+            {
+              const double tm = 0.5*(t0+t1);
+              if( (trim->PointAt(tm)[k] > c) == bUp )
+                t1 = tm;
+              else
+                t0 = tm;
+            }
+            crossings.Append(trim->PointAt(0.5*(t0+t1))[m]);
+          }
+          ta = tb;
+          ya = yb;
+        }
+      }
+    }
+  }
+  crossings.QuickSort(ON_CompareIncreasing<double>);
+}
+
+void CRhCmnBrepWireframe::DoFace(int item, const ON_BrepFace& face, CThreadData& data) const
+{
+  for( int dir=0; dir<2; dir++ )
+  {
+    // dir is the direction the isocurve runs in, k the constant coordinate
+    const int k = 1-dir;
+    const ON_Interval domain = face.Domain(k);
+    for( int i=0; i<m_iso_count; i++ )
+    {
+      const double c = domain.ParameterAt((i+1.0)/(m_iso_count+1.0));
+      GetCrossings(face, k, c, data.m_crossings);
+      ON_Curve* iso = 0;
+      for( int j=0; j+1<data.m_crossings.Count(); j += 2 )
+      {
+        const ON_Interval piece(data.m_crossings[j], data.m_crossings[j+1]);
+        if( !(piece.Length() > ON_ZERO_TOLERANCE) )
+          continue;
+        if( 0 == iso )
+          iso = face.IsoCurve(dir, c);
+        if( 0 == iso )
+          break;
+        ON_Curve* curve = iso->DuplicateCurve();
+        if( curve )
+          AddPiece(item, 0 == dir ? iso_curve_u : iso_curve_v, curve, piece, data);
+      }
+      if( iso )
+        delete iso;
+    }
+  }
+}
+
+bool CRhCmnBrepWireframe::RunItem(void* context, int index, int thread_index)
+{
+  CRhCmnBrepWireframe* wireframe = (CRhCmnBrepWireframe*)context;
+  const CItem& item = wireframe->m_items[index];
+  const ON_Brep* brep = wireframe->m_breps[item.m_brep];
+  CThreadData& data = wireframe->m_thread_data[thread_index];
+  if( item.m_edge >= 0 )
+    wireframe->DoEdge(index, *brep, brep->m_E[item.m_edge], data);
+  else
+    wireframe->DoFace(index, brep->m_F[item.m_face], data);
+  return true;
+}
+
+int CRhCmnBrepWireframe::Create(int thread_count, ON_SimpleArray<int>& info, ON_SimpleArray<ON_Curve*>* curves, ON_3dPointArray* points)
+{
+  if( m_tolerance > 0.0 ? (0 == points) : (0 == curves) )
+    return 0;
+  for( int b=0; b<m_brep_count; b++ )
+  {
+    const ON_Brep* brep = m_breps[b];
+    if( 0 == brep )
+      continue;
+    for( int ei=0; ei<brep->m_E.Count(); ei++ )
+    {
+      CItem& item = m_items.AppendNew();
+      item.m_brep = b;
+      item.m_edge = ei;
+      item.m_face = -1;
+    }
+    for( int fi=0; fi<brep->m_F.Count() && m_iso_count > 0; fi++ )
+    {
+      CItem& item = m_items.AppendNew();
+      item.m_brep = b;
+      item.m_edge = -1;
+      item.m_face = fi;
+    }
+  }
+
+  if( thread_count < 1 )
+    thread_count = RhCmnMaxThreadCount();
+  m_thread_data.Reserve(thread_count);
+  for( int i=0; i<thread_count; i++ )
+    m_thread_data.AppendNew();
+  RhCmnParallelFor(thread_count, m_items.Count(), RunItem, this);
+
+  // put the pieces back in item order
+  ON_SimpleArray<CPiece> all;
+  ON_SimpleArray<int> thread_of;
+  for( int i=0; i<m_thread_data.Count(); i++ )
+  {
+    all.Append(m_thread_data[i].m_pieces.Count(), m_thread_data[i].m_pieces.Array());
+    for( int j=0; j<m_thread_data[i].m_pieces.Count(); j++ )
+      thread_of.Append(i);
+  }
+  ON_SimpleArray<int> order(all.Count());
+  order.SetCount(all.Count());
+  all.Sort(ON::quick_sort, order.Array(), ComparePiece);
+
+  const int count = all.Count();
+  info.Reserve(info.Count() + 4*count);
+  if( curves )
+    curves->Reserve(curves->Count() + count);
+  for( int i=0; i<count; i++ )
+  {
+    const CPiece& piece = all[order[i]];
+    const CItem& item = m_items[piece.m_item];
+    info.Append(item.m_brep);
+    info.Append(piece.m_kind);
+    info.Append(item.m_edge >= 0 ? item.m_edge : item.m_face);
+    info.Append(piece.m_point_count);
+    if( m_tolerance > 0.0 )
+      points->Append(piece.m_point_count, m_thread_data[thread_of[order[i]]].m_points.Array() + piece.m_point_index);
+    else
+      curves->Append(piece.m_curve);
+  }
+  // the curves now belong to the caller
+  for( int i=0; i<m_thread_data.Count(); i++ )
+    m_thread_data[i].m_pieces.SetCount(0);
+  return count;
+}
+
+// Edges and trimmed isocurves of many breps at once. See CRhCmnBrepWireframe.
+RH_C_FUNCTION int ON_Brep_GetWireframes(const ON_SimpleArray<const ON_Brep*>* pConstBreps, int edgeFilter, int isoCount, double tolerance, int threadCount, ON_SimpleArray<int>* info, ON_SimpleArray<ON_Curve*>* curves, ON_3dPointArray* points)
+{
+  int rc = 0;
+  if( pConstBreps && info )
+  {
+    CRhCmnBrepWireframe wireframe(pConstBreps->Array(), pConstBreps->Count(), edgeFilter, isoCount, tolerance);
+    rc = wireframe.Create(threadCount, *info, curves, points);
+  }
+  return rc;
+}
+
 RH_C_FUNCTION void ON_Brep_DuplicateVertices( const ON_Brep* pBrep, ON_3dPointArray* outPoints)
 {
   if( pBrep && outPoints )
@@ -894,14 +2130,12 @@ RH_C_FUNCTION int ON_Brep_FaceFaceIndices( const ON_Brep* pConstBrep, int face_i
   if( pConstBrep && fi )
   {
     int faceCount = pConstBrep->m_F.Count();
-    if( face_index >= faceCount )
+    if( face_index < 0 || face_index >= faceCount )
       return 0;
 
-    ON_SimpleArray<bool> map(faceCount);
-    for( int i = 0; i < faceCount; i++ )
-      map[i] = false;
-    map[face_index] = true;
-
+    // A face has few neighbors, so duplicates are found by looking through
+    // the faces found so far instead of clearing a flag per brep face.
+    const int first = fi->Count();
     const ON_BrepFace* pFace = pConstBrep->Face(face_index);
     
     int loopCount = pFace->LoopCount();
@@ -931,11 +2165,13 @@ RH_C_FUNCTION int ON_Brep_FaceFaceIndices( const ON_Brep* pConstBrep, int face_i
           if( NULL==peTrimFace )
             continue;
           int index = peTrimFace->m_face_index;
-          if (!map[index])
-          {
+          if( index == face_index )
+            continue;
+          bool bFound = false;
+          for( int m = first; m < fi->Count() && !bFound; m++ )
+            bFound = ((*fi)[m] == index);
+          if( !bFound )
             fi->Append(index);
-            map[index] = true;
-          }
         }
       }
     }
@@ -944,6 +2180,400 @@ RH_C_FUNCTION int ON_Brep_FaceFaceIndices( const ON_Brep* pConstBrep, int face_i
   return rc;
 }
 
+// Face, edge and vertex adjacency of a brep, built in one pass and stored
+// in compressed sparse row (CSR) form: the neighbors of element i are
+// indices[offsets[i]] ... indices[offsets[i+1]-1]. All arrays are sections
+// of one int buffer so the whole graph can be copied out at once.
+class CRhCmnBrepTopology
+{
+public:
+  enum SECTION
+  {
+    face_face_offsets = 0,   // F+1
+    face_face = 1,           // faces that share an edge, not including the face itself
+    face_edge_offsets = 2,   // F+1
+    face_edge = 3,           // edges of all loops of the face, each edge once
+    edge_face_offsets = 4,   // E+1
+    edge_face = 5,           // face of every trim of the edge, in m_ti order
+    edge_vertex = 6,         // 2E, m_vi of every edge
+    vertex_edge_offsets = 7, // V+1
+    vertex_edge = 8,         // m_ei of every vertex
+    edge_valence = 9,        // E, number of trims, 3 for three or more
+    section_count = 10
+  };
+
+  CRhCmnBrepTopology();
+
+  bool Create(const ON_Brep& brep);
+
+  const int* Section(SECTION section, int* count) const;
+
+  // angles gets the angle between the outward normals of the two faces at
+  // the middle of every edge of brep. Positive where the edge is convex,
+  // negative where it is concave and ON_UNSET_VALUE for edges that do not
+  // have two trims. The angles are evaluated on every call, so they always
+  // match the brep's current geometry.
+  static void GetEdgeAngles(const ON_Brep& brep, int thread_count, double* angles);
+
+  int m_face_count;
+  int m_edge_count;
+  int m_vertex_count;
+  ON_SimpleArray<int> m_data;
+  int m_section[section_count+1]; // start of each section in m_data
+
+private:
+  struct CAngleTask
+  {
+    const ON_Brep* m_brep;
+    double* m_angles;
+  };
+  static bool GetEdgeAngle(void* context, int index, int thread_index);
+  void BeginSection(SECTION section);
+};
+
+CRhCmnBrepTopology::CRhCmnBrepTopology()
+: m_face_count(0)
+, m_edge_count(0)
+, m_vertex_count(0)
+{
+  memset(m_section, 0, sizeof(m_section));
+}
+
+void CRhCmnBrepTopology::BeginSection(SECTION section)
+{
+  m_section[section] = m_data.Count();
+}
+
+const int* CRhCmnBrepTopology::Section(SECTION section, int* count) const
+{
+  if( count )
+    *count = m_section[section+1] - m_section[section];
+  return m_data.Array() + m_section[section];
+}
+
+bool CRhCmnBrepTopology::GetEdgeAngle(void* context, int index, int)
+{
+  const CAngleTask* task = (const CAngleTask*)context;
+  const ON_Brep& brep = *task->m_brep;
+  const ON_BrepEdge& edge = brep.m_E[index];
+  double& angle = task->m_angles[index];
+  angle = ON_UNSET_VALUE;
+  if( 2 != edge.m_ti.Count() )
+    return true;
+
+  const double t = edge.Domain().ParameterAt(0.5);
+  const ON_3dVector T = edge.TangentAt(t);
+  ON_3dVector inside[2];  // into each face, perpendicular to the edge
+  ON_3dVector normal[2];  // outward face normals
+  for( int k=0; k<2; k++ )
+  {
+    const ON_BrepTrim& trim = brep.m_T[edge.m_ti[k]];
+    const ON_BrepFace* face = trim.Face();
+    if( 0 == face )
+      return true;
+    // The middle of the trim is close enough to the middle of the edge.
+    // Outer loops go counter-clockwise in the surface's parameter space, so
+    // the face is to the left of the trim there.
+    const ON_3dPoint uv = trim.PointAt(trim.Domain().ParameterAt(0.5));
+    const ON_3dVector N = face->NormalAt(uv.x, uv.y);
+    inside[k] = ON_CrossProduct(N, trim.m_bRev3d ? -T : T);
+    normal[k] = face->m_bRev ? -N : N;
+  }
+
+  double d = ON_DotProduct(normal[0], normal[1]);
+  if( d > 1.0 ) d = 1.0;
+  if( d < -1.0 ) d = -1.0;
+  angle = acos(d);
+  // each face bends away below the other face at a convex edge
+  if( ON_DotProduct(inside[0], normal[1]) + ON_DotProduct(inside[1], normal[0]) > 0.0 )
+    angle = -angle;
+  return true;
+}
+
+void CRhCmnBrepTopology::GetEdgeAngles(const ON_Brep& brep, int thread_count, double* angles)
+{
+  if( 0 == angles )
+    return;
+  // evaluating the surfaces is the expensive part
+  CAngleTask task;
+  task.m_brep = &brep;
+  task.m_angles = angles;
+  RhCmnParallelFor(thread_count, brep.m_E.Count(), GetEdgeAngle, &task);
+}
+
+bool CRhCmnBrepTopology::Create(const ON_Brep& brep)
+{
+  m_face_count = brep.m_F.Count();
+  m_edge_count = brep.m_E.Count();
+  m_vertex_count = brep.m_V.Count();
+  const int trim_count = brep.m_T.Count();
+  m_data.SetCount(0);
+  m_data.Reserve(3*(m_face_count + m_edge_count + m_vertex_count) + 4*trim_count + 4*m_edge_count + 8);
+
+  // "last seen" marks so duplicates are skipped without clearing a flag
+  // array for every face
+  ON_SimpleArray<int> edge_mark(m_edge_count);
+  edge_mark.SetCount(m_edge_count);
+  for( int i=0; i<m_edge_count; i++ )
+    edge_mark[i] = -1;
+  ON_SimpleArray<int> face_mark(m_face_count);
+  face_mark.SetCount(m_face_count);
+  for( int i=0; i<m_face_count; i++ )
+    face_mark[i] = -1;
+
+  // faces -> edges
+  ON_SimpleArray<int> face_edge_start(m_face_count+1);
+  ON_SimpleArray<int> face_edge_list(trim_count);
+  for( int fi=0; fi<m_face_count; fi++ )
+  {
+    face_edge_start.Append(face_edge_list.Count());
+    const ON_BrepFace& face = brep.m_F[fi];
+    for( int li=0; li<face.m_li.Count(); li++ )
+    {
+      const ON_BrepLoop* loop = brep.m_L.At(face.m_li[li]);
+      if( 0 == loop )
+        continue;
+      for( int ti=0; ti<loop->m_ti.Count(); ti++ )
+      {
+        const ON_BrepTrim* trim = brep.m_T.At(loop->m_ti[ti]);
+        if( 0 == trim || trim->m_ei < 0 || trim->m_ei >= m_edge_count )
+          continue;
+        if( edge_mark[trim->m_ei] != fi )
+        {
+          edge_mark[trim->m_ei] = fi;
+          face_edge_list.Append(trim->m_ei);
+        }
+      }
+    }
+  }
+  face_edge_start.Append(face_edge_list.Count());
+
+  // edges -> faces
+  ON_SimpleArray<int> edge_face_start(m_edge_count+1);
+  ON_SimpleArray<int> edge_face_list(trim_count);
+  for( int ei=0; ei<m_edge_count; ei++ )
+  {
+    edge_face_start.Append(edge_face_list.Count());
+    const ON_BrepEdge& edge = brep.m_E[ei];
+    for( int i=0; i<edge.m_ti.Count(); i++ )
+    {
+      const ON_BrepTrim* trim = brep.m_T.At(edge.m_ti[i]);
+      const ON_BrepLoop* loop = trim ? brep.m_L.At(trim->m_li) : 0;
+      if( loop && loop->m_fi >= 0 && loop->m_fi < m_face_count )
+        edge_face_list.Append(loop->m_fi);
+    }
+  }
+  edge_face_start.Append(edge_face_list.Count());
+
+  // faces -> faces through the shared edges
+  BeginSection(face_face_offsets);
+  m_data.SetCount(m_data.Count() + m_face_count + 1);
+  BeginSection(face_face);
+  for( int fi=0; fi<m_face_count; fi++ )
+  {
+    m_data[m_section[face_face_offsets] + fi] = m_data.Count() - m_section[face_face];
+    face_mark[fi] = fi;
+    for( int i=face_edge_start[fi]; i<face_edge_start[fi+1]; i++ )
+    {
+      const int ei = face_edge_list[i];
+      for( int j=edge_face_start[ei]; j<edge_face_start[ei+1]; j++ )
+      {
+        const int other = edge_face_list[j];
+        if( face_mark[other] != fi )
+        {
+          face_mark[other] = fi;
+          m_data.Append(other);
+        }
+      }
+    }
+  }
+  m_data[m_section[face_face_offsets] + m_face_count] = m_data.Count() - m_section[face_face];
+
+  BeginSection(face_edge_offsets);
+  m_data.Append(face_edge_start.Count(), face_edge_start.Array());
+  BeginSection(face_edge);
+  m_data.Append(face_edge_list.Count(), face_edge_list.Array());
+  BeginSection(edge_face_offsets);
+  m_data.Append(edge_face_start.Count(), edge_face_start.Array());
+  BeginSection(edge_face);
+  m_data.Append(edge_face_list.Count(), edge_face_list.Array());
+
+  BeginSection(edge_vertex);
+  for( int ei=0; ei<m_edge_count; ei++ )
+  {
+    m_data.Append(brep.m_E[ei].m_vi[0]);
+    m_data.Append(brep.m_E[ei].m_vi[1]);
+  }
+
+  BeginSection(vertex_edge_offsets);
+  m_data.SetCount(m_data.Count() + m_vertex_count + 1);
+  BeginSection(vertex_edge);
+  for( int vi=0; vi<m_vertex_count; vi++ )
+  {
+    m_data[m_section[vertex_edge_offsets] + vi] = m_data.Count() - m_section[vertex_edge];
+    const ON_BrepVertex& vertex = brep.m_V[vi];
+    m_data.Append(vertex.m_ei.Count(), vertex.m_ei.Array());
+  }
+  m_data[m_section[vertex_edge_offsets] + m_vertex_count] = m_data.Count() - m_section[vertex_edge];
+
+  BeginSection(edge_valence);
+  for( int ei=0; ei<m_edge_count; ei++ )
+  {
+    const int trims = brep.m_E[ei].m_ti.Count();
+    m_data.Append(trims > 3 ? 3 : trims);
+  }
+  m_section[section_count] = m_data.Count();
+  return true;
+}
+
+// Keeps the topology graph of a brep so it is only built once. Every
+// RhinoCommon function that changes a brep's topology adds components or
+// compacts the brep, so a graph whose component counts still match the brep
+// is reused without looking at the topology again. Edge angles depend on
+// the geometry and are not cached. Looking up and building run under
+// CRhCmnCacheLock. Not saved in files.
+class CRhCmnBrepTopologyCache : public ON_UserData
+{
+  ON_OBJECT_DECLARE(CRhCmnBrepTopologyCache);
+public:
+  CRhCmnBrepTopologyCache();
+  CRhCmnBrepTopologyCache(const CRhCmnBrepTopologyCache& src);
+  CRhCmnBrepTopologyCache& operator=(const CRhCmnBrepTopologyCache& src);
+
+  // Returns the cached graph of brep, building it as needed.
+  static const CRhCmnBrepTopology* Topology(const ON_Brep& brep);
+
+  ON_BOOL32 GetDescription( ON_wString& description );
+  ON_BOOL32 Archive() const;
+  unsigned int SizeOf() const;
+
+private:
+  bool Matches(const ON_Brep& brep) const;
+
+  bool m_bValid;
+  int m_counts[5]; // V, E, T, L, F
+  CRhCmnBrepTopology m_topology;
+};
+
+ON_OBJECT_IMPLEMENT(CRhCmnBrepTopologyCache, ON_UserData, "5D0A6F57-2E7B-4E8C-93A6-6B4D3C29A1E2");
+
+CRhCmnBrepTopologyCache::CRhCmnBrepTopologyCache()
+: m_bValid(false)
+{
+  m_userdata_uuid = ON_CLASS_ID(CRhCmnBrepTopologyCache);
+  m_application_uuid = RhCmnCacheApplicationId;
+  m_userdata_copycount = 1;
+  memset(m_counts, 0, sizeof(m_counts));
+}
+
+CRhCmnBrepTopologyCache::CRhCmnBrepTopologyCache(const CRhCmnBrepTopologyCache& src)
+: ON_UserData(src)
+, m_bValid(false)
+{
+  m_userdata_uuid = ON_CLASS_ID(CRhCmnBrepTopologyCache);
+  m_application_uuid = RhCmnCacheApplicationId;
+  memset(m_counts, 0, sizeof(m_counts));
+  *this = src;
+}
+
+CRhCmnBrepTopologyCache& CRhCmnBrepTopologyCache::operator=(const CRhCmnBrepTopologyCache& src)
+{
+  if( this != &src )
+  {
+    ON_UserData::operator=(src);
+    m_bValid = src.m_bValid;
+    memcpy(m_counts, src.m_counts, sizeof(m_counts));
+    m_topology = src.m_topology;
+  }
+  return *this;
+}
+
+bool CRhCmnBrepTopologyCache::Matches(const ON_Brep& brep) const
+{
+  return ( m_bValid &&
+           m_counts[0] == brep.m_V.Count() &&
+           m_counts[1] == brep.m_E.Count() &&
+           m_counts[2] == brep.m_T.Count() &&
+           m_counts[3] == brep.m_L.Count() &&
+           m_counts[4] == brep.m_F.Count() );
+}
+
+const CRhCmnBrepTopology* CRhCmnBrepTopologyCache::Topology(const ON_Brep& brep)
+{
+  CRhCmnCacheLock lock;
+  CRhCmnBrepTopologyCache* cache = CRhCmnBrepTopologyCache::Cast(brep.GetUserData(ON_CLASS_ID(CRhCmnBrepTopologyCache)));
+  if( cache && cache->Matches(brep) )
+    return &cache->m_topology;
+
+  if( 0 == cache )
+  {
+    cache = new CRhCmnBrepTopologyCache();
+    if( !const_cast<ON_Brep&>(brep).AttachUserData(cache) )
+    {
+      delete cache;
+      return 0;
+    }
+  }
+  cache->m_bValid = cache->m_topology.Create(brep);
+  cache->m_counts[0] = brep.m_V.Count();
+  cache->m_counts[1] = brep.m_E.Count();
+  cache->m_counts[2] = brep.m_T.Count();
+  cache->m_counts[3] = brep.m_L.Count();
+  cache->m_counts[4] = brep.m_F.Count();
+  return cache->m_bValid ? &cache->m_topology : 0;
+}
+
+ON_BOOL32 CRhCmnBrepTopologyCache::GetDescription( ON_wString& description )
+{
+  description = L"Brep topology graph cache";
+  return TRUE;
+}
+
+ON_BOOL32 CRhCmnBrepTopologyCache::Archive() const
+{
+  return FALSE;
+}
+
+unsigned int CRhCmnBrepTopologyCache::SizeOf() const
+{
+  return ON_UserData::SizeOf() + m_topology.m_data.SizeOfArray();
+}
+
+// Gets the brep's cached topology graph. The pointer stays valid until the
+// brep changes or is deleted. counts gets the face, edge and vertex counts
+// followed by the length of every section.
+RH_C_FUNCTION const CRhCmnBrepTopology* ON_Brep_GetTopologyGraph(const ON_Brep* pConstBrep, /*ARRAY*/int* counts)
+{
+  const CRhCmnBrepTopology* rc = 0;
+  if( pConstBrep && counts )
+  {
+    rc = CRhCmnBrepTopologyCache::Topology(*pConstBrep);
+    if( rc )
+    {
+      counts[0] = rc->m_face_count;
+      counts[1] = rc->m_edge_count;
+      counts[2] = rc->m_vertex_count;
+      for( int i=0; i<CRhCmnBrepTopology::section_count; i++ )
+        rc->Section((CRhCmnBrepTopology::SECTION)i, counts + 3 + i);
+    }
+  }
+  return rc;
+}
+
+// Copies the whole graph of pConstBrep. data must have room for every
+// section, in the order given by CRhCmnBrepTopology::SECTION, and
+// edgeAngles one value per edge. The angles are evaluated from the brep's
+// current geometry.
+RH_C_FUNCTION void ON_BrepTopologyGraph_Copy(const ON_Brep* pConstBrep, const CRhCmnBrepTopology* pConstTopology, /*ARRAY*/int* data, /*ARRAY*/double* edgeAngles)
+{
+  if( pConstBrep && pConstTopology && data && edgeAngles && pConstBrep->m_E.Count() == pConstTopology->m_edge_count )
+  {
+    if( pConstTopology->m_data.Count() > 0 )
+      memcpy(data, pConstTopology->m_data.Array(), pConstTopology->m_data.Count()*sizeof(int));
+    CRhCmnBrepTopology::GetEdgeAngles(*pConstBrep, 0, edgeAngles);
+  }
+}
+
 // not currently available in stand alone OpenNURBS build
 #if !defined(OPENNURBS_BUILD)
 
@@ -338,6 +338,48 @@ RH_C_FUNCTION bool ON_Curve_GetLength( const ON_Curve* pCurve, double* length, d
   return rc;
 }
 
+class CRhCmnCurveLengths
+{
+public:
+  CRhCmnCurveLengths(const ON_Curve* const* curves, double fractional_tol, double* lengths)
+  : m_curves(curves), m_fractional_tol(fractional_tol), m_lengths(lengths)
+  {
+  }
+
+  static bool Run(void* context, int index, int)
+  {
+    const CRhCmnCurveLengths* pThis = (const CRhCmnCurveLengths*)context;
+    const ON_Curve* curve = pThis->m_curves[index];
+    double length = 0.0;
+    if( !curve || !curve->GetLength(&length, pThis->m_fractional_tol) )
+      length = 0.0;
+    pThis->m_lengths[index] = length;
+    return true;
+  }
+
+private:
+  const ON_Curve* const* m_curves;
+  const double m_fractional_tol;
+  double* m_lengths;
+};
+
+// Fills lengths with one value per curve, 0.0 where GetLength fails like
+// ON_Curve_GetLength reports, and returns the sum. The sum is added up in
+// curve order so it does not depend on the thread count.
+RH_C_FUNCTION double ON_Curve_GetLengthBatch(const ON_SimpleArray<const ON_Curve*>* pConstCurves, double fractional_tol, int threadCount, /*ARRAY*/double* lengths)
+{
+  double rc = 0.0;
+  if( pConstCurves && lengths )
+  {
+    const int count = pConstCurves->Count();
+    CRhCmnCurveLengths calc(pConstCurves->Array(), fractional_tol, lengths);
+    RhCmnParallelFor(threadCount, count, CRhCmnCurveLengths::Run, &calc);
+    for( int i=0; i<count; i++ )
+      rc += lengths[i];
+  }
+  return rc;
+}
+
 RH_C_FUNCTION bool ON_Curve_IsShort( const ON_Curve* pCurve, double tolerance, ON_INTERVAL_STRUCT sub_domain, bool ignoreSubDomain)
 {
   const ON_Interval* _sub_domain = NULL;
@@ -489,6 +531,353 @@ RH_C_FUNCTION bool ON_Curve_IsContinuous(const ON_Curve* curvePtr, int continuit
   return rc;
 }
 
+// Appends every discontinuity GetNextDiscontinuity reports between t0 and t1
+// to t, stepping from one to the next. Works in both directions.
+static int RhCmnGetCurveDiscontinuities(const ON_Curve& curve, ON::continuity c, double t0, double t1, ON_SimpleArray<double>& t)
+{
+  const int count0 = t.Count();
+  if( !ON_IsValid(t0) || !ON_IsValid(t1) || t0 == t1 )
+    return 0;
+  const bool bIncreasing = (t0 < t1);
+  double s = ON_UNSET_VALUE;
+  while( curve.GetNextDiscontinuity(c, t0, t1, &s) )
+  {
+    // stop when the search does not move toward t1
+    if( bIncreasing ? !(s > t0) : !(s < t0) )
+      break;
+    t.Append(s);
+    if( s == t1 )
+      break;
+    t0 = s;
+  }
+  return t.Count() - count0;
+}
+
+RH_C_FUNCTION int ON_Curve_GetDiscontinuities(const ON_Curve* curvePtr, int continuityType, double t0, double t1, ON_SimpleArray<double>* t)
+{
+  int rc = 0;
+  if( curvePtr && t )
+    rc = RhCmnGetCurveDiscontinuities(*curvePtr, ON::Continuity(continuityType), t0, t1, *t);
+  return rc;
+}
+
+class CRhCmnCurveDiscontinuities
+{
+public:
+  CRhCmnCurveDiscontinuities(const ON_Curve* const* curves, int count, ON::continuity c)
+  : m_curves(curves), m_c(c)
+  {
+    m_results.Reserve(count);
+    for( int i=0; i<count; i++ )
+      m_results.AppendNew();
+  }
+
+  static bool Run(void* context, int index, int)
+  {
+    CRhCmnCurveDiscontinuities* pThis = (CRhCmnCurveDiscontinuities*)context;
+    const ON_Curve* curve = pThis->m_curves[index];
+    if( curve )
+    {
+      const ON_Interval domain = curve->Domain();
+      RhCmnGetCurveDiscontinuities(*curve, pThis->m_c, domain[0], domain[1], pThis->m_results[index]);
+    }
+    return true;
+  }
+
+  const ON_Curve* const* m_curves;
+  const ON::continuity m_c;
+  ON_ClassArray< ON_SimpleArray<double> > m_results;
+
+private:
+  // no copies
+  CRhCmnCurveDiscontinuities(const CRhCmnCurveDiscontinuities&);
+  CRhCmnCurveDiscontinuities& operator=(const CRhCmnCurveDiscontinuities&);
+};
+
+// Finds the discontinuities of every curve over its whole domain. counts gets
+// one int per curve and t gets the parameters of all curves back to back.
+RH_C_FUNCTION int ON_Curve_GetDiscontinuitiesBatch(const ON_SimpleArray<const ON_Curve*>* pConstCurves, int continuityType, int threadCount, ON_SimpleArray<int>* counts, ON_SimpleArray<double>* t)
+{
+  int rc = 0;
+  if( pConstCurves && counts && t )
+  {
+    const int count = pConstCurves->Count();
+    CRhCmnCurveDiscontinuities search(pConstCurves->Array(), count, ON::Continuity(continuityType));
+    RhCmnParallelFor(threadCount, count, CRhCmnCurveDiscontinuities::Run, &search);
+    counts->Reserve(counts->Count() + count);
+    for( int i=0; i<count; i++ )
+    {
+      const ON_SimpleArray<double>& result = search.m_results[i];
+      counts->Append(result.Count());
+      t->Append(result.Count(), result.Array());
+      rc += result.Count();
+    }
+  }
+  return rc;
+}
+
+// Intersects many curves with a family of parallel planes. Each curve is
+// converted to NURBS form once and the control points of every span bound
+// the span's extent along the plane normal, so a span only visits the planes
+// whose offsets fall inside that extent. Crossings are found by sampling the
+// span and refining every sign change.
+class CRhCmnCurveContours
+{
+public:
+  // Plane i passes through base + offsets[i]*normal.
+  CRhCmnCurveContours(const ON_Curve* const* curves, int curve_count, const ON_3dPoint& base, const ON_3dVector& normal, const double* offsets, int plane_count, double tolerance);
+
+  // info gets 2 ints per point: plane index and curve index. Points are
+  // grouped by plane and then ordered by curve and curve parameter.
+  int Create(int thread_count, ON_SimpleArray<int>& info, ON_SimpleArray<double>& parameters, ON_3dPointArray& points);
+
+private:
+  struct CHit
+  {
+    int m_plane;
+    int m_curve;
+    double m_t;
+    ON_3dPoint m_P;
+  };
+
+  static bool RunCurve(void* context, int index, int thread_index);
+  static int CompareHit(const CHit* a, const CHit* b);
+  double Height(const ON_NurbsCurve& nurbs, double t) const;
+  void AddHit(int curve_index, const ON_Curve& curve, const ON_NurbsCurve& nurbs, bool bNurbParameters, int plane, double t, ON_SimpleArray<CHit>& hits) const;
+  void DoSpan(int curve_index, const ON_Curve& curve, const ON_NurbsCurve& nurbs, bool bNurbParameters, const ON_Interval& span, bool bIncludeEnd, double lo, double hi, ON_SimpleArray<CHit>& hits) const;
+
+  const ON_Curve* const* m_curves;
+  const int m_curve_count;
+  const ON_3dPoint m_base;
+  ON_3dVector m_normal;
+  double m_tolerance;
+  ON_SimpleArray<double> m_offsets; // sorted
+  ON_SimpleArray<int> m_plane_index; // sorted position -> caller's plane index
+  ON_ClassArray< ON_SimpleArray<CHit> > m_thread_hits;
+};
+
+CRhCmnCurveContours::CRhCmnCurveContours(const ON_Curve* const* curves, int curve_count, const ON_3dPoint& base, const ON_3dVector& normal, const double* offsets, int plane_count, double tolerance)
+: m_curves(curves)
+, m_curve_count(curve_count > 0 ? curve_count : 0)
+, m_base(base)
+, m_normal(normal)
+, m_tolerance(tolerance > 0.0 ? tolerance : ON_ZERO_TOLERANCE)
+{
+  if( !m_normal.Unitize() )
+    return;
+  if( offsets && plane_count > 0 )
+  {
+    m_offsets.Append(plane_count, offsets);
+    m_plane_index.SetCapacity(plane_count);
+    m_plane_index.SetCount(plane_count);
+    m_offsets.Sort(ON::quick_sort, m_plane_index.Array(), ON_CompareIncreasing<double>);
+    m_offsets.Permute(m_plane_index.Array());
+  }
+}
+
+int CRhCmnCurveContours::CompareHit(const CHit* a, const CHit* b)
+{
+  if( a->m_plane != b->m_plane )
+    return a->m_plane < b->m_plane ? -1 : 1;
+  if( a->m_curve != b->m_curve )
+    return a->m_curve < b->m_curve ? -1 : 1;
+  if( a->m_t < b->m_t )
+    return -1;
+  if( a->m_t > b->m_t )
+    return 1;
+  return 0;
+}
+
+double CRhCmnCurveContours::Height(const ON_NurbsCurve& nurbs, double t) const
+{
+  return (nurbs.PointAt(t) - m_base)*m_normal;
+}
+
+void CRhCmnCurveContours::AddHit(int curve_index, const ON_Curve& curve, const ON_NurbsCurve& nurbs, bool bNurbParameters, int plane, double t, ON_SimpleArray<CHit>& hits) const
+{
+  CHit& hit = hits.AppendNew();
+  hit.m_plane = m_plane_index[plane];
+  hit.m_curve = curve_index;
+  hit.m_P = nurbs.PointAt(t);
+  hit.m_t = t;
+  if( bNurbParameters )
+    curve.GetCurveParameterFromNurbFormParameter(t, &hit.m_t);
+}
+
+void CRhCmnCurveContours::DoSpan(int curve_index, const ON_Curve& curve, const ON_NurbsCurve& nurbs, bool bNurbParameters, const ON_Interval& span, bool bIncludeEnd, double lo, double hi, ON_SimpleArray<CHit>& hits) const
+{
+  // planes whose offsets are in [lo, hi]
+  const int plane_count = m_offsets.Count();
+  const double* offsets = m_offsets.Array();
+  int first = 0, last = plane_count;
+  while( first < last )
+  {
+    const int mid = (first+last)/2;
+    if( offsets[mid] < lo - m_tolerance )
+      first = mid+1;
+    else
+      last = mid;
+  }
+  if( first >= plane_count || offsets[first] > hi + m_tolerance )
+    return;
+
+  // a polynomial of degree d changes sign at most d times on the span, so
+  // 2*order samples separate the roots in all but near tangent cases
+  const int sample_count = 2*nurbs.Order()+1;
+  double h[64];
+  double s[64];
+  const int n = sample_count < 64 ? sample_count : 64;
+  for( int i=0; i<n; i++ )
+  {
+    s[i] = span.ParameterAt((double)i/(double)(n-1));
+    h[i] = Height(nurbs, s[i]);
+  }
+
+  for( int p=first; p<plane_count && offsets[p] <= hi + m_tolerance; p++ )
+  {
+    const double d = offsets[p];
+    for( int i=0; i+1<n; i++ )
+    {
+      const double f0 = h[i]-d;
+      const double f1 = h[i+1]-d;
+      if( 0.0 == f0 )
+      {
+        AddHit(curve_index, curve, nurbs, bNurbParameters, p, s[i], hits);
+        continue;
+      }
+      if( 0.0 == f1 )
+      {
+        if( i+2 == n && bIncludeEnd )
+          AddHit(curve_index, curve, nurbs, bNurbParameters, p, s[i+1], hits);
+        continue;
+      }
+      if( (f0 < 0.0) == (f1 < 0.0) )
+        continue;
+
+      // Illinois variant of regula falsi
+      double a = s[i], b = s[i+1], fa = f0, fb = f1;
+      double t = a;
+      int side = 0;
+      for( int iter=0; iter<64; iter++ )
+      {
+        t = (a*fb - b*fa)/(fb - fa);
+        const double ft = Height(nurbs, t) - d;
+        if( fabs(ft) <= 0.01*m_tolerance || fabs(b-a) <= ON_EPSILON*(fabs(a)+fabs(b)) )
+          break;
+        if( (ft < 0.0) == (fb < 0.0) )
+        {
+          b = t;
+          fb = ft;
+          if( -1 == side )
+            fa *= 0.5;
+          side = -1;
+        }
+        else
+        {
+          a = t;
+          fa = ft;
+          if( 1 == side )
+            fb *= 0.5;
+          side = 1;
+        }
+      }
+      AddHit(curve_index, curve, nurbs, bNurbParameters, p, t, hits);
+    }
+  }
+}
+
+bool CRhCmnCurveContours::RunCurve(void* context, int index, int thread_index)
+{
+  const CRhCmnCurveContours* pThis = (const CRhCmnCurveContours*)context;
+  const ON_Curve* curve = pThis->m_curves[index];
+  if( 0 == curve )
+    return true;
+  ON_NurbsCurve nurbs;
+  const int nurb_rc = curve->GetNurbForm(nurbs);
+  if( nurb_rc < 1 || nurbs.Order() < 2 )
+    return true;
+  const bool bNurbParameters = (2 == nurb_rc);
+  ON_SimpleArray<CHit>& hits = ((CRhCmnCurveContours*)pThis)->m_thread_hits[thread_index];
+
+  // the last span keeps its end point unless the curve closes onto its start
+  const bool bClosed = curve->IsClosed() ? true : false;
+  const int order = nurbs.Order();
+  const int cv_count = nurbs.CVCount();
+  int last_span = -1;
+  int k;
+  for( k=order-2; k<cv_count-1; k++ )
+  {
+    if( nurbs.Knot(k) < nurbs.Knot(k+1) )
+      last_span = k;
+  }
+  for( k=order-2; k<cv_count-1; k++ )
+  {
+    const ON_Interval span(nurbs.Knot(k), nurbs.Knot(k+1));
+    if( !(span[0] < span[1]) )
+      continue;
+    // the span's control points bound its heights
+    double lo = 0.0, hi = 0.0;
+    for( int i=k-order+2; i<=k+1; i++ )
+    {
+      ON_3dPoint cv;
+      nurbs.GetCV(i, cv);
+      const double z = (cv - pThis->m_base)*pThis->m_normal;
+      if( i == k-order+2 || z < lo )
+        lo = z;
+      if( i == k-order+2 || z > hi )
+        hi = z;
+    }
+    pThis->DoSpan(index, *curve, nurbs, bNurbParameters, span, k == last_span && !bClosed, lo, hi, hits);
+  }
+  return true;
+}
+
+int CRhCmnCurveContours::Create(int thread_count, ON_SimpleArray<int>& info, ON_SimpleArray<double>& parameters, ON_3dPointArray& points)
+{
+  if( m_offsets.Count() < 1 || m_curve_count < 1 || !m_normal.IsUnitVector() )
+    return 0;
+  if( thread_count < 1 )
+    thread_count = RhCmnMaxThreadCount();
+  m_thread_hits.Reserve(thread_count);
+  for( int i=0; i<thread_count; i++ )
+    m_thread_hits.AppendNew();
+  RhCmnParallelFor(thread_count, m_curve_count, RunCurve, this);
+
+  ON_SimpleArray<CHit> all;
+  for( int i=0; i<m_thread_hits.Count(); i++ )
+  {
+    all.Append(m_thread_hits[i].Count(), m_thread_hits[i].Array());
+    m_thread_hits[i].Destroy();
+  }
+  all.QuickSort(CompareHit);
+
+  const int count = all.Count();
+  info.Reserve(info.Count() + 2*count);
+  parameters.Reserve(parameters.Count() + count);
+  points.Reserve(points.Count() + count);
+  for( int i=0; i<count; i++ )
+  {
+    info.Append(all[i].m_plane);
+    info.Append(all[i].m_curve);
+    parameters.Append(all[i].m_t);
+    points.Append(all[i].m_P);
+  }
+  return count;
+}
+
+RH_C_FUNCTION int ON_Curve_ContourPlanes(const ON_SimpleArray<const ON_Curve*>* pConstCurves, ON_3DPOINT_STRUCT basePoint, ON_3DVECTOR_STRUCT normal, int planeCount, /*ARRAY*/const double* offsets, double tolerance, int threadCount, ON_SimpleArray<int>* info, ON_SimpleArray<double>* parameters, ON_3dPointArray* points)
+{
+  int rc = 0;
+  if( pConstCurves && offsets && info && parameters && points )
+  {
+    const ON_3dPoint* _base = (const ON_3dPoint*)&basePoint;
+    const ON_3dVector* _normal = (const ON_3dVector*)&normal;
+    CRhCmnCurveContours contours(pConstCurves->Array(), pConstCurves->Count(), *_base, *_normal, offsets, planeCount, tolerance);
+    rc = contours.Create(threadCount, *info, *parameters, *points);
+  }
+  return rc;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Meshing, intersections and mass property calculations are not available in
 // stand alone opennurbs
@@ -540,6 +929,62 @@ RH_C_FUNCTION ON_MassProperties* ON_Curve_AreaMassProperties(const ON_Curve* pCu
   return rc;
 }
 
+class CRhCmnCurveAreas
+{
+public:
+  CRhCmnCurveAreas(const ON_Curve* const* curves, double rel_tol, double abs_tol, double curve_planar_tol, double* areas)
+  : m_curves(curves), m_rel_tol(rel_tol), m_abs_tol(abs_tol), m_curve_planar_tol(curve_planar_tol), m_areas(areas)
+  {
+  }
+
+  // Same test and base point as ON_Curve_AreaMassProperties, but only the
+  // area is integrated.
+  static bool Run(void* context, int index, int)
+  {
+    const CRhCmnCurveAreas* pThis = (const CRhCmnCurveAreas*)context;
+    const ON_Curve* curve = pThis->m_curves[index];
+    double area = ON_UNSET_VALUE;
+    ON_Plane plane;
+    if( curve && curve->IsPlanar(&plane, pThis->m_curve_planar_tol) && curve->IsClosed() )
+    {
+      ON_BoundingBox bbox = curve->BoundingBox();
+      ON_3dPoint basepoint = plane.ClosestPointTo(bbox.Center());
+      ON_MassProperties mp;
+      if( curve->AreaMassProperties(basepoint, plane.Normal(), mp, true, false, false, false, pThis->m_rel_tol, pThis->m_abs_tol) )
+        area = fabs(mp.m_mass);
+    }
+    pThis->m_areas[index] = area;
+    return true;
+  }
+
+private:
+  const ON_Curve* const* m_curves;
+  const double m_rel_tol;
+  const double m_abs_tol;
+  const double m_curve_planar_tol;
+  double* m_areas;
+};
+
+// Fills areas with one value per curve, ON_UNSET_VALUE for curves that are
+// not closed and planar or fail to integrate, and returns the sum of the
+// others in curve order.
+RH_C_FUNCTION double ON_Curve_GetAreaBatch(const ON_SimpleArray<const ON_Curve*>* pConstCurves, double rel_tol, double abs_tol, double curve_planar_tol, int threadCount, /*ARRAY*/double* areas)
+{
+  double rc = 0.0;
+  if( pConstCurves && areas )
+  {
+    const int count = pConstCurves->Count();
+    CRhCmnCurveAreas calc(pConstCurves->Array(), rel_tol, abs_tol, curve_planar_tol, areas);
+    RhCmnParallelFor(threadCount, count, CRhCmnCurveAreas::Run, &calc);
+    for( int i=0; i<count; i++ )
+    {
+      if( ON_UNSET_VALUE != areas[i] )
+        rc += areas[i];
+    }
+  }
+  return rc;
+}
+
 RH_C_FUNCTION bool RHC_RhinoTweenCurves( const ON_Curve* pStartCurve, const ON_Curve* pEndCurve, int num_curves, ON_SimpleArray<ON_Curve*>* outputCurves )
 {
   bool rc = false;
@@ -563,4 +1008,89 @@ RH_C_FUNCTION bool RHC_RhinoTweenCurveWithSampling( const ON_Curve* pStartCurve,
     rc = RhinoTweenCurveWithSampling( pStartCurve, pEndCurve, num_curves, num_samples, *outputCurves );
   return rc;
 }
+
+class CRhCmnTweenCurvesBatch
+{
+public:
+  enum METHOD
+  {
+    control_points = 0, // RhinoTweenCurves
+    matching = 1,       // RhinoTweenCurvesWithMatching
+    sampling = 2        // RhinoTweenCurveWithSampling
+  };
+
+  CRhCmnTweenCurvesBatch(const ON_Curve* const* start_curves, const ON_Curve* const* end_curves, int pair_count, int method, int num_curves, int num_samples)
+  : m_start_curves(start_curves), m_end_curves(end_curves), m_method(method), m_num_curves(num_curves), m_num_samples(num_samples)
+  {
+    m_results.Reserve(pair_count);
+    for( int i=0; i<pair_count; i++ )
+      m_results.AppendNew();
+  }
+
+  void Tween(int index)
+  {
+    const ON_Curve* start = m_start_curves[index];
+    const ON_Curve* end = m_end_curves[index];
+    ON_SimpleArray<ON_Curve*>& result = m_results[index];
+    if( start && end )
+    {
+      bool rc = false;
+      switch( m_method )
+      {
+      case control_points:
+        rc = RhinoTweenCurves(start, end, m_num_curves, result);
+        break;
+      case matching:
+        rc = RhinoTweenCurvesWithMatching(start, end, m_num_curves, result);
+        break;
+      case sampling:
+        rc = RhinoTweenCurveWithSampling(start, end, m_num_curves, m_num_samples, result);
+        break;
+      }
+      if( !rc )
+      {
+        for( int i=0; i<result.Count(); i++ )
+          delete result[i];
+        result.SetCount(0);
+      }
+    }
+  }
+
+  const ON_Curve* const* m_start_curves;
+  const ON_Curve* const* m_end_curves;
+  const int m_method;
+  const int m_num_curves;
+  const int m_num_samples;
+  ON_ClassArray< ON_SimpleArray<ON_Curve*> > m_results;
+
+private:
+  // no copies
+  CRhCmnTweenCurvesBatch(const CRhCmnTweenCurvesBatch&);
+  CRhCmnTweenCurvesBatch& operator=(const CRhCmnTweenCurvesBatch&);
+};
+
+// Tweens many curve pairs at once. counts gets the number of curves made for
+// each pair, 0 when a pair fails, and outputCurves gets the curves of all
+// pairs back to back in pair order. The Rhino tween functions make no thread
+// safety promises, so the pairs are tweened one after the other.
+RH_C_FUNCTION int RHC_RhinoTweenCurvesBatch( const ON_SimpleArray<const ON_Curve*>* pStartCurves, const ON_SimpleArray<const ON_Curve*>* pEndCurves, int method, int num_curves, int num_samples, ON_SimpleArray<int>* counts, ON_SimpleArray<ON_Curve*>* outputCurves )
+{
+  int rc = 0;
+  if( pStartCurves && pEndCurves && counts && outputCurves && pStartCurves->Count() == pEndCurves->Count() )
+  {
+    const int pair_count = pStartCurves->Count();
+    CRhCmnTweenCurvesBatch batch(pStartCurves->Array(), pEndCurves->Array(), pair_count, method, num_curves, num_samples);
+    for( int i=0; i<pair_count; i++ )
+      batch.Tween(i);
+    counts->Reserve(counts->Count() + pair_count);
+    for( int i=0; i<pair_count; i++ )
+    {
+      const ON_SimpleArray<ON_Curve*>& result = batch.m_results[i];
+      counts->Append(result.Count());
+      outputCurves->Append(result.Count(), result.Array());
+      rc += result.Count();
+    }
+  }
+  return rc;
+}
 #endif
@@ -447,6 +447,15 @@ RH_C_FUNCTION double ON_Intersect_MeshRay1(const ON_Mesh* pMesh, ON_3dRay* ray,
   // it is ok if face_indices is null
   if( pMesh && ray )
   {
+    // a tree cache restored from a file saves building the mesh tree
+    ON_SimpleArray<int> cached_faces;
+    if( RhCmnMeshCachedRayIntersect(*pMesh, ray->m_P, ray->m_V, ON_DBL_MAX, true, &rc, NULL, face_indices ? &cached_faces : NULL) )
+    {
+      if( face_indices && rc >= 0.0 )
+        face_indices->Append(cached_faces.Count(), cached_faces.Array());
+      return rc;
+    }
+
     const ON_MeshTree* mt = pMesh->MeshTree(true);
 
     ON_3dVector rayVec = ray->m_V;
@@ -31,6 +31,9 @@ RH_C_FUNCTION bool ON_Mesh_EvaluateMeshGeometry(ON_Mesh* pMesh, const ON_Surface
   return rc;
 }
 
+// defined with the mesh face tree cache below
+static void RhCmnSetMeshTreeCacheDirty(const ON_Mesh* mesh);
+
 RH_C_FUNCTION bool ON_Mesh_SetVertex(ON_Mesh* pMesh, int vertexIndex, float x, float y, float z)
 {
   bool rc = false;
@@ -38,6 +41,7 @@ RH_C_FUNCTION bool ON_Mesh_SetVertex(ON_Mesh* pMesh, int vertexIndex, float x, f
   {
     rc = pMesh->SetVertex(vertexIndex, ON_3fPoint(x,y,z));
     pMesh->DestroyRuntimeCache();
+    RhCmnSetMeshTreeCacheDirty(pMesh);
   }
   return rc;
 }
@@ -49,6 +53,7 @@ RH_C_FUNCTION bool ON_Mesh_SetFace(ON_Mesh* pMesh, int faceIndex, int vertex1, i
   {
     rc = pMesh->SetQuad(faceIndex, vertex1, vertex2, vertex3, vertex4);
     pMesh->DestroyRuntimeCache();
+    RhCmnSetMeshTreeCacheDirty(pMesh);
   }
   return rc;
 }
@@ -779,7 +784,12 @@ RH_C_FUNCTION bool ON_Mesh_IsPointInside(const ON_Mesh* pConstMesh, ON_3DPOINT_S
       ON_BoundingBox bbox = pConstMesh->BoundingBox();
       ON_Line line(_point, bbox.m_max + ON_3dPoint(100,100,100));
 
-      const ON_MeshTree* mesh_tree = pConstMesh->MeshTree(true);
+      int crossings = 0;
+      const ON_MeshTree* mesh_tree = NULL;
+      if( RhCmnMeshCachedRayIntersect(*pConstMesh, line.from, line.to - line.from, 1.0, false, NULL, &crossings, NULL) )
+        rc = (crossings % 2)==1;
+      else
+        mesh_tree = pConstMesh->MeshTree(true);
       if( mesh_tree )
       {
         ON_SimpleArray<ON_CMX_EVENT> events;
@@ -1475,6 +1485,7 @@ RH_C_FUNCTION void ON_Mesh_SetTopologyVertex(ON_Mesh* pMesh, int index, ON_3FPOI
         int vertex=vi[i];
         pMesh->m_V[vertex] = _pt;
       }
+      RhCmnSetMeshTreeCacheDirty(pMesh);
     }
   }
 }
@@ -2469,4 +2480,889 @@ RH_C_FUNCTION bool ON_Mesh_GetMeshPart(const ON_Mesh* pConstMesh, int which, int
     }
   }
   return rc;
-}
\ No newline at end of file
+}
+/////////////////////////////////////////////////////////////////////////////
+// Mesh face tree cache
+//
+// ON_Mesh::MeshTree() is rebuilt the first time it is needed in every
+// process. CRhCmnMeshTreeCache is user data that keeps a packed face RTree
+// with the mesh. It is written to 3dm files along with the mesh and on read
+// the packed tree is kept as raw bytes until the first query needs it. The
+// mesh is fingerprinted (vertex and face counts plus a CRC of the vertex and
+// face arrays) so a cache that no longer matches its mesh is rebuilt rather
+// than used.
+//
+// The CRC costs a pass over the whole mesh, so it is only computed when the
+// tree is built, written or first used after reading, and again after
+// SetDirty(). Every other query only compares the counts. The functions in
+// this file that move vertices or rewire faces in place call SetDirty();
+// other in place edits that keep the counts must turn the cache off and on
+// again. Queries build the tree under CRhCmnCacheLock.
+
+#define RHCMN_MESH_TREE_CACHE_VERSION 1
+
+class CRhCmnMeshTreeCache : public ON_UserData
+{
+  ON_OBJECT_DECLARE(CRhCmnMeshTreeCache);
+public:
+  CRhCmnMeshTreeCache();
+  CRhCmnMeshTreeCache(const CRhCmnMeshTreeCache& src);
+  CRhCmnMeshTreeCache& operator=(const CRhCmnMeshTreeCache& src);
+  ~CRhCmnMeshTreeCache();
+
+  static CRhCmnMeshTreeCache* FromMesh(const ON_Mesh* mesh);
+
+  // Makes the next query check the mesh crc again
+  static void SetDirty(const ON_Mesh* mesh);
+
+  // Returns the face tree for mesh, restoring or rebuilding it as needed.
+  // Element ids are face indices.
+  const CRhCmnPackedRTree* FaceTree(const ON_Mesh& mesh);
+
+  ON_BOOL32 GetDescription( ON_wString& description );
+  ON_BOOL32 Archive() const;
+  ON_BOOL32 Write( ON_BinaryArchive& binary_archive ) const;
+  ON_BOOL32 Read( ON_BinaryArchive& binary_archive );
+  ON_BOOL32 Transform( const ON_Xform& xform );
+  unsigned int SizeOf() const;
+
+private:
+  static ON__UINT32 MeshCRC(const ON_Mesh& mesh);
+  bool Matches(const ON_Mesh& mesh) const;
+  bool Build(const ON_Mesh& mesh);
+  void Destroy();
+
+  int m_vertex_count;
+  int m_face_count;
+  ON__UINT32 m_mesh_crc;
+  bool m_bCrcChecked; // m_mesh_crc was compared with the mesh since the last read or SetDirty()
+  void* m_buffer; // packed tree, onmalloc'd
+  unsigned int m_buffer_size;
+  CRhCmnPackedRTree m_tree; // attached to m_buffer on first use
+  bool m_bVerified; // m_tree is attached to m_buffer and its crc was checked
+};
+
+ON_OBJECT_IMPLEMENT(CRhCmnMeshTreeCache, ON_UserData, "FE33F4A4-8C0C-4E27-9850-CE443C79CC6A");
+
+CRhCmnMeshTreeCache::CRhCmnMeshTreeCache()
+: m_vertex_count(0)
+, m_face_count(0)
+, m_mesh_crc(0)
+, m_bCrcChecked(false)
+, m_buffer(0)
+, m_buffer_size(0)
+, m_bVerified(false)
+{
+  m_userdata_uuid = ON_CLASS_ID(CRhCmnMeshTreeCache);
+  m_application_uuid = RhCmnCacheApplicationId;
+  m_userdata_copycount = 1;
+}
+
+CRhCmnMeshTreeCache::CRhCmnMeshTreeCache(const CRhCmnMeshTreeCache& src)
+: ON_UserData(src)
+, m_vertex_count(0)
+, m_face_count(0)
+, m_mesh_crc(0)
+, m_bCrcChecked(false)
+, m_buffer(0)
+, m_buffer_size(0)
+, m_bVerified(false)
+{
+  m_userdata_uuid = ON_CLASS_ID(CRhCmnMeshTreeCache);
+  m_application_uuid = RhCmnCacheApplicationId;
+  *this = src;
+}
+
+CRhCmnMeshTreeCache& CRhCmnMeshTreeCache::operator=(const CRhCmnMeshTreeCache& src)
+{
+  if( this != &src )
+  {
+    ON_UserData::operator=(src);
+    Destroy();
+    if( src.m_buffer && src.m_buffer_size > 0 )
+    {
+      m_buffer = onmalloc(src.m_buffer_size);
+      memcpy(m_buffer, src.m_buffer, src.m_buffer_size);
+      m_buffer_size = src.m_buffer_size;
+      m_vertex_count = src.m_vertex_count;
+      m_face_count = src.m_face_count;
+      m_mesh_crc = src.m_mesh_crc;
+      m_bCrcChecked = src.m_bCrcChecked;
+      // the tree has to point at this copy's buffer
+      m_bVerified = src.m_bVerified && m_tree.Attach(m_buffer, m_buffer_size, false, false);
+    }
+  }
+  return *this;
+}
+
+CRhCmnMeshTreeCache::~CRhCmnMeshTreeCache()
+{
+  Destroy();
+}
+
+void CRhCmnMeshTreeCache::Destroy()
+{
+  m_tree.Destroy();
+  if( m_buffer )
+    onfree(m_buffer);
+  m_buffer = 0;
+  m_buffer_size = 0;
+  m_vertex_count = 0;
+  m_face_count = 0;
+  m_mesh_crc = 0;
+  m_bCrcChecked = false;
+  m_bVerified = false;
+}
+
+CRhCmnMeshTreeCache* CRhCmnMeshTreeCache::FromMesh(const ON_Mesh* mesh)
+{
+  CRhCmnMeshTreeCache* rc = NULL;
+  if( mesh )
+    rc = CRhCmnMeshTreeCache::Cast(mesh->GetUserData(ON_CLASS_ID(CRhCmnMeshTreeCache)));
+  return rc;
+}
+
+void CRhCmnMeshTreeCache::SetDirty(const ON_Mesh* mesh)
+{
+  CRhCmnMeshTreeCache* cache = FromMesh(mesh);
+  if( cache )
+  {
+    CRhCmnCacheLock lock;
+    cache->m_bCrcChecked = false;
+  }
+}
+
+ON__UINT32 CRhCmnMeshTreeCache::MeshCRC(const ON_Mesh& mesh)
+{
+  ON__UINT32 crc = 0;
+  crc = ON_CRC32(crc, mesh.m_V.Count()*sizeof(ON_3fPoint), mesh.m_V.Array());
+  crc = ON_CRC32(crc, mesh.m_F.Count()*sizeof(ON_MeshFace), mesh.m_F.Array());
+  return crc;
+}
+
+bool CRhCmnMeshTreeCache::Matches(const ON_Mesh& mesh) const
+{
+  // the crc catches vertices that moved without changing the counts
+  return ( m_buffer &&
+           m_vertex_count == mesh.m_V.Count() &&
+           m_face_count == mesh.m_F.Count() &&
+           (m_bCrcChecked || m_mesh_crc == MeshCRC(mesh)) );
+}
+
+bool CRhCmnMeshTreeCache::Build(const ON_Mesh& mesh)
+{
+  Destroy();
+  ON_RTree tree;
+  if( !tree.CreateMeshFaceTree(&mesh) )
+    return false;
+  unsigned int size = CRhCmnPackedRTree::PackedSizeOf(tree);
+  if( size < 1 )
+    return false;
+  m_buffer = onmalloc(size);
+  if( !CRhCmnPackedRTree::Pack(tree, size, m_buffer) )
+  {
+    Destroy();
+    return false;
+  }
+  m_buffer_size = size;
+  m_vertex_count = mesh.m_V.Count();
+  m_face_count = mesh.m_F.Count();
+  m_mesh_crc = MeshCRC(mesh);
+  m_bCrcChecked = true;
+  m_bVerified = m_tree.Attach(m_buffer, m_buffer_size, false, false);
+  return m_bVerified;
+}
+
+const CRhCmnPackedRTree* CRhCmnMeshTreeCache::FaceTree(const ON_Mesh& mesh)
+{
+  CRhCmnCacheLock lock;
+  if( !Matches(mesh) )
+    return Build(mesh) ? &m_tree : NULL;
+  m_bCrcChecked = true;
+
+  // The tree's own crc is only checked on first use after reading
+  if( !m_bVerified )
+    m_bVerified = m_tree.Attach(m_buffer, m_buffer_size, false, true);
+  if( !m_bVerified && !Build(mesh) )
+    return NULL;
+  return &m_tree;
+}
+
+ON_BOOL32 CRhCmnMeshTreeCache::GetDescription( ON_wString& description )
+{
+  description = L"Mesh face tree cache";
+  return TRUE;
+}
+
+ON_BOOL32 CRhCmnMeshTreeCache::Archive() const
+{
+  return TRUE;
+}
+
+ON_BOOL32 CRhCmnMeshTreeCache::Write( ON_BinaryArchive& binary_archive ) const
+{
+  // The tree is brought up to date here, crc included, so files always get
+  // a usable cache
+  CRhCmnCacheLock lock;
+  const ON_Mesh* mesh = ON_Mesh::Cast(Owner());
+  if( mesh && !(Matches(*mesh) && m_mesh_crc == MeshCRC(*mesh)) )
+    const_cast<CRhCmnMeshTreeCache*>(this)->Build(*mesh);
+
+  bool rc = binary_archive.BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK, RHCMN_MESH_TREE_CACHE_VERSION, 0);
+  if( !rc )
+    return false;
+  for(;;)
+  {
+    rc = binary_archive.WriteInt(m_vertex_count);
+    if( !rc ) break;
+    rc = binary_archive.WriteInt(m_face_count);
+    if( !rc ) break;
+    rc = binary_archive.WriteInt(m_mesh_crc);
+    if( !rc ) break;
+    rc = binary_archive.WriteInt(m_buffer_size);
+    if( !rc ) break;
+    if( m_buffer_size > 0 )
+      rc = binary_archive.WriteByte(m_buffer_size, m_buffer);
+    break;
+  }
+  if( !binary_archive.EndWrite3dmChunk() )
+    rc = false;
+  return rc;
+}
+
+ON_BOOL32 CRhCmnMeshTreeCache::Read( ON_BinaryArchive& binary_archive )
+{
+  Destroy();
+  int major_version = 0;
+  int minor_version = 0;
+  bool rc = binary_archive.BeginRead3dmChunk(TCODE_ANONYMOUS_CHUNK, &major_version, &minor_version);
+  if( !rc )
+    return false;
+  for(;;)
+  {
+    // Caches written by a newer version are skipped and rebuilt on demand
+    if( RHCMN_MESH_TREE_CACHE_VERSION != major_version )
+      break;
+    rc = binary_archive.ReadInt(&m_vertex_count);
+    if( !rc ) break;
+    rc = binary_archive.ReadInt(&m_face_count);
+    if( !rc ) break;
+    rc = binary_archive.ReadInt(&m_mesh_crc);
+    if( !rc ) break;
+    unsigned int size = 0;
+    rc = binary_archive.ReadInt(&size);
+    if( !rc ) break;
+    if( size > 0 )
+    {
+      m_buffer = onmalloc(size);
+      rc = (0 != m_buffer) && binary_archive.ReadByte(size, m_buffer);
+      if( !rc ) break;
+      m_buffer_size = size;
+    }
+    break;
+  }
+  if( !binary_archive.EndRead3dmChunk() )
+    rc = false;
+  if( !rc )
+    Destroy();
+  return rc;
+}
+
+ON_BOOL32 CRhCmnMeshTreeCache::Transform( const ON_Xform& xform )
+{
+  // the boxes no longer fit the faces
+  Destroy();
+  return ON_UserData::Transform(xform);
+}
+
+unsigned int CRhCmnMeshTreeCache::SizeOf() const
+{
+  return ON_UserData::SizeOf() + sizeof(*this) - sizeof(ON_UserData) + m_buffer_size;
+}
+
+static void RhCmnSetMeshTreeCacheDirty(const ON_Mesh* mesh)
+{
+  CRhCmnMeshTreeCache::SetDirty(mesh);
+}
+
+RH_C_FUNCTION bool ON_Mesh_GetTreeCacheEnabled(const ON_Mesh* pConstMesh)
+{
+  return (NULL != CRhCmnMeshTreeCache::FromMesh(pConstMesh));
+}
+
+RH_C_FUNCTION void ON_Mesh_SetTreeCacheEnabled(ON_Mesh* pMesh, bool enable)
+{
+  if( pMesh )
+  {
+    CRhCmnMeshTreeCache* pCache = CRhCmnMeshTreeCache::FromMesh(pMesh);
+    if( enable && NULL == pCache )
+    {
+      pCache = new CRhCmnMeshTreeCache();
+      if( !pMesh->AttachUserData(pCache) )
+        delete pCache;
+    }
+    else if( !enable && pCache )
+    {
+      delete pCache;
+    }
+  }
+}
+
+struct CRhCmnMeshRayContext
+{
+  const ON_Mesh* m_mesh;
+  const double* m_P;
+  const double* m_D;
+  bool m_bFirstHit; // true: keep closest hits and shrink the limit, false: count crossings
+  double m_t;
+  ON_SimpleArray<int>* m_faces;
+  int m_crossings;
+};
+
+static bool RhCmnRayTriangle(const double P[3], const double D[3], const ON_3fPoint& A, const ON_3fPoint& B, const ON_3fPoint& C, double* t)
+{
+  // Moller-Trumbore
+  const double e1[3] = { B.x-A.x, B.y-A.y, B.z-A.z };
+  const double e2[3] = { C.x-A.x, C.y-A.y, C.z-A.z };
+  const double p[3] = { D[1]*e2[2]-D[2]*e2[1], D[2]*e2[0]-D[0]*e2[2], D[0]*e2[1]-D[1]*e2[0] };
+  const double det = e1[0]*p[0] + e1[1]*p[1] + e1[2]*p[2];
+  if( 0.0 == det )
+    return false;
+  const double inv = 1.0/det;
+  const double s[3] = { P[0]-A.x, P[1]-A.y, P[2]-A.z };
+  const double u = (s[0]*p[0] + s[1]*p[1] + s[2]*p[2])*inv;
+  if( u < 0.0 || u > 1.0 )
+    return false;
+  const double q[3] = { s[1]*e1[2]-s[2]*e1[1], s[2]*e1[0]-s[0]*e1[2], s[0]*e1[1]-s[1]*e1[0] };
+  const double v = (D[0]*q[0] + D[1]*q[1] + D[2]*q[2])*inv;
+  if( v < 0.0 || u+v > 1.0 )
+    return false;
+  *t = (e2[0]*q[0] + e2[1]*q[1] + e2[2]*q[2])*inv;
+  return true;
+}
+
+static bool RhCmnMeshRayFace(void* context, ON__INT_PTR id, double, double* limit)
+{
+  CRhCmnMeshRayContext* ctx = (CRhCmnMeshRayContext*)context;
+  const int fi = (int)id;
+  if( fi < 0 || fi >= ctx->m_mesh->m_F.Count() )
+    return true;
+  const ON_MeshFace& f = ctx->m_mesh->m_F[fi];
+  const ON_3fPoint* V = ctx->m_mesh->m_V.Array();
+  double t;
+  bool bHit = RhCmnRayTriangle(ctx->m_P, ctx->m_D, V[f.vi[0]], V[f.vi[1]], V[f.vi[2]], &t);
+  if( !bHit && f.IsQuad() )
+    bHit = RhCmnRayTriangle(ctx->m_P, ctx->m_D, V[f.vi[0]], V[f.vi[2]], V[f.vi[3]], &t);
+  if( !bHit || t < 0.0 || t > *limit )
+    return true;
+
+  if( !ctx->m_bFirstHit )
+  {
+    ctx->m_crossings++;
+    return true;
+  }
+  if( t < ctx->m_t )
+  {
+    ctx->m_t = t;
+    if( ctx->m_faces )
+      ctx->m_faces->SetCount(0);
+  }
+  if( ctx->m_faces )
+    ctx->m_faces->Append(fi);
+  *limit = t;
+  return true;
+}
+
+bool RhCmnMeshCachedRayIntersect(const ON_Mesh& mesh, const ON_3dPoint& P, const ON_3dVector& V, double t1, bool bFirstHit, double* t, int* crossings, ON_SimpleArray<int>* face_indices)
+{
+  CRhCmnMeshTreeCache* pCache = CRhCmnMeshTreeCache::FromMesh(&mesh);
+  const CRhCmnPackedRTree* pTree = pCache ? pCache->FaceTree(mesh) : NULL;
+  if( NULL == pTree )
+    return false;
+
+  CRhCmnMeshRayContext context;
+  context.m_mesh = &mesh;
+  context.m_P = &P.x;
+  context.m_D = &V.x;
+  context.m_bFirstHit = bFirstHit;
+  context.m_t = ON_UNSET_POSITIVE_VALUE;
+  context.m_faces = face_indices;
+  context.m_crossings = 0;
+  CRhCmnRTreeRaySearch ray;
+  ray.SetRay(&P.x, &V.x, 0.0, t1);
+  pTree->SearchRay(ray, RhCmnMeshRayFace, &context);
+  if( t )
+    *t = (context.m_t < ON_UNSET_POSITIVE_VALUE) ? context.m_t : -1.0;
+  if( crossings )
+    *crossings = context.m_crossings;
+  return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Signed distance field
+//
+// Distances are sampled at the corners of a regular grid that covers the
+// mesh bounding box grown by the band width. Only distances inside the
+// narrow band are computed exactly; everything farther away is clamped to
+// +/- band width. The grid is filled one z layer at a time on worker
+// threads. Each layer finds the faces within band width of it with a face
+// RTree, computes unsigned distances in the face neighborhoods and then
+// signs the layer row by row with a scanline crossing count, which requires
+// a closed mesh.
+
+void RhCmnClosestPointOnTriangle(const double P[3], const double A[3], const double B[3], const double C[3], double Q[3])
+{
+  // Ericson, Real-Time Collision Detection, 5.1.5
+  double ab[3], ac[3], ap[3];
+  for( int i=0; i<3; i++ )
+  {
+    ab[i] = B[i]-A[i];
+    ac[i] = C[i]-A[i];
+    ap[i] = P[i]-A[i];
+  }
+  const double d1 = ab[0]*ap[0] + ab[1]*ap[1] + ab[2]*ap[2];
+  const double d2 = ac[0]*ap[0] + ac[1]*ap[1] + ac[2]*ap[2];
+  if( d1 <= 0.0 && d2 <= 0.0 )
+  {
+    Q[0] = A[0]; Q[1] = A[1]; Q[2] = A[2];
+    return;
+  }
+  double bp[3];
+  for( int i=0; i<3; i++ )
+    bp[i] = P[i]-B[i];
+  const double d3 = ab[0]*bp[0] + ab[1]*bp[1] + ab[2]*bp[2];
+  const double d4 = ac[0]*bp[0] + ac[1]*bp[1] + ac[2]*bp[2];
+  if( d3 >= 0.0 && d4 <= d3 )
+  {
+    Q[0] = B[0]; Q[1] = B[1]; Q[2] = B[2];
+    return;
+  }
+  const double vc = d1*d4 - d3*d2;
+  if( vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 )
+  {
+    const double v = d1/(d1-d3);
+    for( int i=0; i<3; i++ )
+      Q[i] = A[i] + v*ab[i];
+    return;
+  }
+  double cp[3];
+  for( int i=0; i<3; i++ )
+    cp[i] = P[i]-C[i];
+  const double d5 = ab[0]*cp[0] + ab[1]*cp[1] + ab[2]*cp[2];
+  const double d6 = ac[0]*cp[0] + ac[1]*cp[1] + ac[2]*cp[2];
+  if( d6 >= 0.0 && d5 <= d6 )
+  {
+    Q[0] = C[0]; Q[1] = C[1]; Q[2] = C[2];
+    return;
+  }
+  const double vb = d5*d2 - d1*d6;
+  if( vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 )
+  {
+    const double w = d2/(d2-d6);
+    for( int i=0; i<3; i++ )
+      Q[i] = A[i] + w*ac[i];
+    return;
+  }
+  const double va = d3*d6 - d5*d4;
+  if( va <= 0.0 && (d4-d3) >= 0.0 && (d5-d6) >= 0.0 )
+  {
+    const double w = (d4-d3)/((d4-d3) + (d5-d6));
+    for( int i=0; i<3; i++ )
+      Q[i] = B[i] + w*(C[i]-B[i]);
+    return;
+  }
+  const double denom = 1.0/(va + vb + vc);
+  const double v = vb*denom;
+  const double w = vc*denom;
+  for( int i=0; i<3; i++ )
+    Q[i] = A[i] + ab[i]*v + ac[i]*w;
+}
+
+class CRhCmnMeshDistanceField
+{
+public:
+  CRhCmnMeshDistanceField();
+  ~CRhCmnMeshDistanceField();
+
+  bool Create(const ON_Mesh& mesh, double voxel_size, double band_width, int thread_count);
+
+  // Trilinear interpolation of the grid. Points outside of the grid get
+  // the band width.
+  double ValueAt(const ON_3dPoint& P) const;
+  void ValuesAt(int count, const ON_3dPoint* points, double* values, int thread_count) const;
+
+  unsigned int SizeOf() const;
+
+  ON_3dPoint m_origin;  // location of grid point (0,0,0)
+  double m_voxel_size;
+  double m_band_width;
+  int m_count[3];       // grid points in x, y and z
+  float* m_values;      // m_count[0]*m_count[1]*m_count[2] values, x fastest
+
+private:
+  struct CTriangle
+  {
+    int m_vi[3];
+  };
+  struct CScratch
+  {
+    ON_SimpleArray<int> m_triangles;
+    ON_ClassArray< ON_SimpleArray<double> > m_crossings; // one per row
+  };
+  struct CSampleContext
+  {
+    const CRhCmnMeshDistanceField* m_field;
+    const ON_3dPoint* m_points;
+    double* m_values;
+  };
+
+  static bool AddTriangle(void* context, ON__INT_PTR id);
+  static bool FillLayer(void* context, int k, int thread_index);
+  static bool Sample(void* context, int index, int thread_index);
+  void FillLayer(int k, CScratch& scratch) const;
+
+  // only used while the field is created
+  ON_SimpleArray<ON_3dPoint> m_V;
+  ON_SimpleArray<CTriangle> m_T;
+  ON_RTree m_tree;
+  ON_ClassArray<CScratch> m_scratch;
+
+private:
+  // no copies
+  CRhCmnMeshDistanceField(const CRhCmnMeshDistanceField&);
+  CRhCmnMeshDistanceField& operator=(const CRhCmnMeshDistanceField&);
+};
+
+CRhCmnMeshDistanceField::CRhCmnMeshDistanceField()
+: m_origin(ON_3dPoint::Origin)
+, m_voxel_size(0.0)
+, m_band_width(0.0)
+, m_values(0)
+{
+  m_count[0] = m_count[1] = m_count[2] = 0;
+}
+
+CRhCmnMeshDistanceField::~CRhCmnMeshDistanceField()
+{
+  if( m_values )
+    onfree(m_values);
+}
+
+bool CRhCmnMeshDistanceField::AddTriangle(void* context, ON__INT_PTR id)
+{
+  ((ON_SimpleArray<int>*)context)->Append((int)id);
+  return true;
+}
+
+void CRhCmnMeshDistanceField::FillLayer(int k, CScratch& scratch) const
+{
+  const int nx = m_count[0];
+  const int ny = m_count[1];
+  const double h = m_voxel_size;
+  const double band = m_band_width;
+  const double z = m_origin.z + k*h;
+  float* layer = m_values + (size_t)k*nx*ny;
+  for( int i=0; i<nx*ny; i++ )
+    layer[i] = (float)band;
+
+  // triangles within band width of this layer
+  ON_RTreeBBox box;
+  box.m_min[0] = m_origin.x;
+  box.m_min[1] = m_origin.y;
+  box.m_min[2] = z - band;
+  box.m_max[0] = m_origin.x + (nx-1)*h;
+  box.m_max[1] = m_origin.y + (ny-1)*h;
+  box.m_max[2] = z + band;
+  scratch.m_triangles.SetCount(0);
+  m_tree.Search(&box, AddTriangle, &scratch.m_triangles);
+
+  for( int j=0; j<ny; j++ )
+    scratch.m_crossings[j].SetCount(0);
+
+  // Rows are shifted by a tiny odd amount for the crossing count so rows
+  // do not run exactly through vertices or edges of meshes that are
+  // aligned with the grid.
+  const double zs = z + 1.234567e-6*h;
+  const double ys_offset = 2.345678e-6*h;
+  const double* V = &m_V[0].x;
+  for( int t=0; t<scratch.m_triangles.Count(); t++ )
+  {
+    const CTriangle& tri = m_T[scratch.m_triangles[t]];
+    const double* A = V + 3*tri.m_vi[0];
+    const double* B = V + 3*tri.m_vi[1];
+    const double* C = V + 3*tri.m_vi[2];
+    double tmin[3], tmax[3];
+    for( int c=0; c<3; c++ )
+    {
+      tmin[c] = A[c] < B[c] ? (A[c] < C[c] ? A[c] : C[c]) : (B[c] < C[c] ? B[c] : C[c]);
+      tmax[c] = A[c] > B[c] ? (A[c] > C[c] ? A[c] : C[c]) : (B[c] > C[c] ? B[c] : C[c]);
+    }
+
+    // unsigned distance around the triangle
+    int i0 = (int)floor((tmin[0] - band - m_origin.x)/h);
+    int i1 = (int)ceil((tmax[0] + band - m_origin.x)/h);
+    int j0 = (int)floor((tmin[1] - band - m_origin.y)/h);
+    int j1 = (int)ceil((tmax[1] + band - m_origin.y)/h);
+    if( i0 < 0 ) i0 = 0;
+    if( j0 < 0 ) j0 = 0;
+    if( i1 > nx-1 ) i1 = nx-1;
+    if( j1 > ny-1 ) j1 = ny-1;
+    for( int j=j0; j<=j1; j++ )
+    {
+      for( int i=i0; i<=i1; i++ )
+      {
+        const double P[3] = { m_origin.x + i*h, m_origin.y + j*h, z };
+        double Q[3];
+        RhCmnClosestPointOnTriangle(P, A, B, C, Q);
+        const double d = sqrt((P[0]-Q[0])*(P[0]-Q[0]) + (P[1]-Q[1])*(P[1]-Q[1]) + (P[2]-Q[2])*(P[2]-Q[2]));
+        float& value = layer[i + j*nx];
+        if( d < value )
+          value = (float)d;
+      }
+    }
+
+    // where rows in +x direction cross the triangle
+    if( zs < tmin[2] || zs > tmax[2] )
+      continue;
+    j0 = (int)ceil((tmin[1] - ys_offset - m_origin.y)/h);
+    j1 = (int)floor((tmax[1] - ys_offset - m_origin.y)/h);
+    if( j0 < 0 ) j0 = 0;
+    if( j1 > ny-1 ) j1 = ny-1;
+    for( int j=j0; j<=j1; j++ )
+    {
+      const double ys = m_origin.y + j*h + ys_offset;
+      // barycentric coordinates of (ys,zs) in the yz projection
+      const double wa = (B[1]-ys)*(C[2]-zs) - (B[2]-zs)*(C[1]-ys);
+      const double wb = (C[1]-ys)*(A[2]-zs) - (C[2]-zs)*(A[1]-ys);
+      const double wc = (A[1]-ys)*(B[2]-zs) - (A[2]-zs)*(B[1]-ys);
+      const bool bPositive = (wa >= 0.0 && wb >= 0.0 && wc >= 0.0);
+      const bool bNegative = (wa <= 0.0 && wb <= 0.0 && wc <= 0.0);
+      const double w = wa + wb + wc;
+      if( (!bPositive && !bNegative) || 0.0 == w )
+        continue;
+      scratch.m_crossings[j].Append((wa*A[0] + wb*B[0] + wc*C[0])/w);
+    }
+  }
+
+  // odd number of crossings before a grid point means it is inside
+  for( int j=0; j<ny; j++ )
+  {
+    ON_SimpleArray<double>& crossings = scratch.m_crossings[j];
+    if( crossings.Count() < 2 )
+      continue;
+    crossings.QuickSort(ON_CompareIncreasing<double>);
+    int c = 0;
+    for( int i=0; i<nx; i++ )
+    {
+      const double x = m_origin.x + i*h;
+      while( c < crossings.Count() && crossings[c] < x )
+        c++;
+      if( c % 2 )
+        layer[i + j*nx] = -layer[i + j*nx];
+    }
+  }
+}
+
+bool CRhCmnMeshDistanceField::FillLayer(void* context, int k, int thread_index)
+{
+  CRhCmnMeshDistanceField* field = (CRhCmnMeshDistanceField*)context;
+  field->FillLayer(k, field->m_scratch[thread_index]);
+  return true;
+}
+
+bool CRhCmnMeshDistanceField::Create(const ON_Mesh& mesh, double voxel_size, double band_width, int thread_count)
+{
+  const int vertex_count = mesh.VertexCount();
+  const int face_count = mesh.FaceCount();
+  if( vertex_count < 3 || face_count < 1 || !ON_IsValid(voxel_size) || voxel_size <= 0.0 )
+    return false;
+  if( !ON_IsValid(band_width) || band_width < voxel_size )
+    band_width = voxel_size;
+
+  ON_BoundingBox bbox = mesh.BoundingBox();
+  if( !bbox.IsValid() )
+    return false;
+  const double pad = band_width + voxel_size;
+  // the grid is a single block of floats; check the size in double
+  // precision before anything is narrowed to int
+  const double max_count = (double)(0x7FFFFFFF/sizeof(float));
+  double n[3];
+  double count = 1.0;
+  for( int c=0; c<3; c++ )
+  {
+    n[c] = ceil((bbox.m_max[c] - bbox.m_min[c] + 2.0*pad)/voxel_size) + 1.0;
+    if( !ON_IsValid(n[c]) || n[c] > max_count )
+      return false;
+    count *= n[c];
+  }
+  if( count > max_count )
+    return false;
+  for( int c=0; c<3; c++ )
+    m_count[c] = (int)n[c];
+
+  m_origin.Set(bbox.m_min.x - pad, bbox.m_min.y - pad, bbox.m_min.z - pad);
+  m_voxel_size = voxel_size;
+  m_band_width = band_width;
+  m_values = (float*)onmalloc(((size_t)count)*sizeof(float));
+  if( 0 == m_values )
+    return false;
+
+  m_V.Reserve(vertex_count);
+  for( int i=0; i<vertex_count; i++ )
+    m_V.Append(mesh.Vertex(i));
+  m_T.Reserve(2*face_count);
+  for( int i=0; i<face_count; i++ )
+  {
+    const ON_MeshFace& f = mesh.m_F[i];
+    if( !f.IsValid(vertex_count) )
+      continue;
+    CTriangle& tri = m_T.AppendNew();
+    tri.m_vi[0] = f.vi[0]; tri.m_vi[1] = f.vi[1]; tri.m_vi[2] = f.vi[2];
+    if( f.IsQuad() )
+    {
+      CTriangle& tri2 = m_T.AppendNew();
+      tri2.m_vi[0] = f.vi[0]; tri2.m_vi[1] = f.vi[2]; tri2.m_vi[2] = f.vi[3];
+    }
+  }
+  for( int i=0; i<m_T.Count(); i++ )
+  {
+    ON_BoundingBox tbox;
+    for( int c=0; c<3; c++ )
+      tbox.Set(m_V[m_T[i].m_vi[c]], c > 0);
+    m_tree.Insert(&(tbox.m_min.x), &(tbox.m_max.x), i);
+  }
+
+  if( thread_count < 1 )
+    thread_count = RhCmnMaxThreadCount();
+  m_scratch.Reserve(thread_count);
+  for( int i=0; i<thread_count; i++ )
+  {
+    CScratch& scratch = m_scratch.AppendNew();
+    scratch.m_crossings.Reserve(m_count[1]);
+    for( int j=0; j<m_count[1]; j++ )
+      scratch.m_crossings.AppendNew();
+  }
+  RhCmnParallelFor(thread_count, m_count[2], FillLayer, this);
+
+  // free everything that is only needed while filling
+  m_scratch.Destroy();
+  m_tree.RemoveAll();
+  m_T.Destroy();
+  m_V.Destroy();
+  return true;
+}
+
+double CRhCmnMeshDistanceField::ValueAt(const ON_3dPoint& P) const
+{
+  if( 0 == m_values )
+    return ON_UNSET_VALUE;
+  const double p[3] = { (P.x - m_origin.x)/m_voxel_size, (P.y - m_origin.y)/m_voxel_size, (P.z - m_origin.z)/m_voxel_size };
+  int i[3];
+  double f[3];
+  for( int c=0; c<3; c++ )
+  {
+    if( !(p[c] >= 0.0 && p[c] <= m_count[c]-1) )
+      return m_band_width;
+    i[c] = (int)p[c];
+    if( i[c] > m_count[c]-2 )
+      i[c] = m_count[c]-2;
+    f[c] = p[c] - i[c];
+  }
+  const int nx = m_count[0];
+  const size_t nxy = (size_t)nx*m_count[1];
+  const float* v = m_values + i[0] + (size_t)i[1]*nx + i[2]*nxy;
+  const double c00 = v[0]*(1.0-f[0]) + v[1]*f[0];
+  const double c10 = v[nx]*(1.0-f[0]) + v[nx+1]*f[0];
+  const double c01 = v[nxy]*(1.0-f[0]) + v[nxy+1]*f[0];
+  const double c11 = v[nxy+nx]*(1.0-f[0]) + v[nxy+nx+1]*f[0];
+  const double c0 = c00*(1.0-f[1]) + c10*f[1];
+  const double c1 = c01*(1.0-f[1]) + c11*f[1];
+  return c0*(1.0-f[2]) + c1*f[2];
+}
+
+bool CRhCmnMeshDistanceField::Sample(void* context, int index, int)
+{
+  CSampleContext* ctx = (CSampleContext*)context;
+  ctx->m_values[index] = ctx->m_field->ValueAt(ctx->m_points[index]);
+  return true;
+}
+
+void CRhCmnMeshDistanceField::ValuesAt(int count, const ON_3dPoint* points, double* values, int thread_count) const
+{
+  CSampleContext context;
+  context.m_field = this;
+  context.m_points = points;
+  context.m_values = values;
+  RhCmnParallelFor(thread_count, count, Sample, &context);
+}
+
+unsigned int CRhCmnMeshDistanceField::SizeOf() const
+{
+  return (unsigned int)(sizeof(*this) + sizeof(float)*(size_t)m_count[0]*m_count[1]*m_count[2]);
+}
+
+RH_C_FUNCTION CRhCmnMeshDistanceField* ON_MeshDistanceField_New(const ON_Mesh* pConstMesh, double voxelSize, double bandWidth, int threadCount)
+{
+  CRhCmnMeshDistanceField* rc = NULL;
+  if( pConstMesh )
+  {
+    rc = new CRhCmnMeshDistanceField();
+    if( !rc->Create(*pConstMesh, voxelSize, bandWidth, threadCount) )
+    {
+      delete rc;
+      rc = NULL;
+    }
+  }
+  return rc;
+}
+
+RH_C_FUNCTION void ON_MeshDistanceField_Delete(CRhCmnMeshDistanceField* pField)
+{
+  if( pField )
+    delete pField;
+}
+
+RH_C_FUNCTION void ON_MeshDistanceField_GetGrid(const CRhCmnMeshDistanceField* pConstField, ON_3dPoint* origin, double* voxelSize, double* bandWidth, int* countX, int* countY, int* countZ)
+{
+  if( pConstField && origin && voxelSize && bandWidth && countX && countY && countZ )
+  {
+    *origin = pConstField->m_origin;
+    *voxelSize = pConstField->m_voxel_size;
+    *bandWidth = pConstField->m_band_width;
+    *countX = pConstField->m_count[0];
+    *countY = pConstField->m_count[1];
+    *countZ = pConstField->m_count[2];
+  }
+}
+
+// The values are stored as floats, x index fastest, then y, then z.
+// The buffer is owned by the field.
+RH_C_FUNCTION const void* ON_MeshDistanceField_Values(const CRhCmnMeshDistanceField* pConstField)
+{
+  const void* rc = NULL;
+  if( pConstField )
+    rc = pConstField->m_values;
+  return rc;
+}
+
+RH_C_FUNCTION double ON_MeshDistanceField_ValueAt(const CRhCmnMeshDistanceField* pConstField, ON_3DPOINT_STRUCT point)
+{
+  double rc = ON_UNSET_VALUE;
+  if( pConstField )
+    rc = pConstField->ValueAt(ON_3dPoint(point.val));
+  return rc;
+}
+
+RH_C_FUNCTION void ON_MeshDistanceField_ValuesAt(const CRhCmnMeshDistanceField* pConstField, int count, /*ARRAY*/const ON_3dPoint* points, /*ARRAY*/double* values, int threadCount)
+{
+  if( pConstField && count > 0 && points && values )
+    pConstField->ValuesAt(count, points, values, threadCount);
+}
+
+RH_C_FUNCTION unsigned int ON_MeshDistanceField_SizeOf(const CRhCmnMeshDistanceField* pConstField)
+{
+  unsigned int rc = 0;
+  if( pConstField )
+    rc = pConstField->SizeOf();
+  return rc;
+}
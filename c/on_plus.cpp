@@ -38,4 +38,1046 @@ RH_C_FUNCTION int ONC_MeshClashSearch(const ON_SimpleArray<const ON_Mesh*>* pMes
   return rc;
 }
 
-#endif
\ No newline at end of file
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+// Clash search that does not depend on rhino.exe, so it is also available
+// in the stand alone openNURBS build. Breps and extrusions are searched
+// using the render meshes that are stored on them; nothing is meshed here.
+//
+// Every object gets an RTree of its faces. Object pairs whose boxes are
+// closer than the clash distance are split into blocks of faces and the
+// blocks are searched on worker threads. Faces that pass the box test get
+// an exact triangle to triangle distance.
+
+static double RhCmnDistanceSquared(const double P[3], const double Q[3])
+{
+  return (P[0]-Q[0])*(P[0]-Q[0]) + (P[1]-Q[1])*(P[1]-Q[1]) + (P[2]-Q[2])*(P[2]-Q[2]);
+}
+
+static double RhCmnClamp01(double t)
+{
+  return t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+}
+
+// Closest points PA on segment P0P1 and PB on segment Q0Q1.
+// Ericson, Real-Time Collision Detection, 5.1.9
+static void RhCmnSegmentClosestPoints(const double P0[3], const double P1[3], const double Q0[3], const double Q1[3], double PA[3], double PB[3])
+{
+  double d1[3], d2[3], r[3];
+  for( int i=0; i<3; i++ )
+  {
+    d1[i] = P1[i]-P0[i];
+    d2[i] = Q1[i]-Q0[i];
+    r[i] = P0[i]-Q0[i];
+  }
+  const double a = d1[0]*d1[0] + d1[1]*d1[1] + d1[2]*d1[2];
+  const double e = d2[0]*d2[0] + d2[1]*d2[1] + d2[2]*d2[2];
+  const double f = d2[0]*r[0] + d2[1]*r[1] + d2[2]*r[2];
+  double s = 0.0;
+  double t = 0.0;
+  if( a <= 0.0 )
+  {
+    if( e > 0.0 )
+      t = RhCmnClamp01(f/e);
+  }
+  else
+  {
+    const double c = d1[0]*r[0] + d1[1]*r[1] + d1[2]*r[2];
+    if( e <= 0.0 )
+      s = RhCmnClamp01(-c/a);
+    else
+    {
+      const double b = d1[0]*d2[0] + d1[1]*d2[1] + d1[2]*d2[2];
+      const double denom = a*e - b*b;
+      if( denom > 0.0 )
+        s = RhCmnClamp01((b*f - c*e)/denom);
+      t = (b*s + f)/e;
+      if( t < 0.0 )
+      {
+        t = 0.0;
+        s = RhCmnClamp01(-c/a);
+      }
+      else if( t > 1.0 )
+      {
+        t = 1.0;
+        s = RhCmnClamp01((b - c)/a);
+      }
+    }
+  }
+  for( int i=0; i<3; i++ )
+  {
+    PA[i] = P0[i] + s*d1[i];
+    PB[i] = Q0[i] + t*d2[i];
+  }
+}
+
+// Returns true if segment P0P1 crosses triangle ABC and sets X to the point
+// where it does. Segments in the plane of the triangle are not reported.
+static bool RhCmnSegmentCrossesTriangle(const double P0[3], const double P1[3], const double A[3], const double B[3], const double C[3], double X[3])
+{
+  double e1[3], e2[3], d[3], s[3];
+  for( int i=0; i<3; i++ )
+  {
+    e1[i] = B[i]-A[i];
+    e2[i] = C[i]-A[i];
+    d[i] = P1[i]-P0[i];
+    s[i] = P0[i]-A[i];
+  }
+  const double p[3] = { d[1]*e2[2]-d[2]*e2[1], d[2]*e2[0]-d[0]*e2[2], d[0]*e2[1]-d[1]*e2[0] };
+  const double det = e1[0]*p[0] + e1[1]*p[1] + e1[2]*p[2];
+  if( 0.0 == det )
+    return false;
+  const double inv = 1.0/det;
+  const double u = (s[0]*p[0] + s[1]*p[1] + s[2]*p[2])*inv;
+  if( u < 0.0 || u > 1.0 )
+    return false;
+  const double q[3] = { s[1]*e1[2]-s[2]*e1[1], s[2]*e1[0]-s[0]*e1[2], s[0]*e1[1]-s[1]*e1[0] };
+  const double v = (d[0]*q[0] + d[1]*q[1] + d[2]*q[2])*inv;
+  if( v < 0.0 || u+v > 1.0 )
+    return false;
+  const double t = (e2[0]*q[0] + e2[1]*q[1] + e2[2]*q[2])*inv;
+  if( t < 0.0 || t > 1.0 )
+    return false;
+  for( int i=0; i<3; i++ )
+    X[i] = P0[i] + t*d[i];
+  return true;
+}
+
+// Exact distance between triangles A and B. PA and PB are set to the
+// closest points. Intersecting triangles have distance 0 and PA == PB is a
+// point on the intersection.
+static double RhCmnTriangleDistance(const double* const A[3], const double* const B[3], double PA[3], double PB[3])
+{
+  for( int i=0; i<3; i++ )
+  {
+    if( RhCmnSegmentCrossesTriangle(A[i], A[(i+1)%3], B[0], B[1], B[2], PA)
+        || RhCmnSegmentCrossesTriangle(B[i], B[(i+1)%3], A[0], A[1], A[2], PA) )
+    {
+      PB[0] = PA[0]; PB[1] = PA[1]; PB[2] = PA[2];
+      return 0.0;
+    }
+  }
+
+  double best = ON_UNSET_POSITIVE_VALUE;
+  double Q[3], QA[3], QB[3];
+  for( int i=0; i<3; i++ )
+  {
+    RhCmnClosestPointOnTriangle(A[i], B[0], B[1], B[2], Q);
+    double d = RhCmnDistanceSquared(A[i], Q);
+    if( d < best )
+    {
+      best = d;
+      PA[0] = A[i][0]; PA[1] = A[i][1]; PA[2] = A[i][2];
+      PB[0] = Q[0]; PB[1] = Q[1]; PB[2] = Q[2];
+    }
+    RhCmnClosestPointOnTriangle(B[i], A[0], A[1], A[2], Q);
+    d = RhCmnDistanceSquared(B[i], Q);
+    if( d < best )
+    {
+      best = d;
+      PA[0] = Q[0]; PA[1] = Q[1]; PA[2] = Q[2];
+      PB[0] = B[i][0]; PB[1] = B[i][1]; PB[2] = B[i][2];
+    }
+    for( int j=0; j<3; j++ )
+    {
+      RhCmnSegmentClosestPoints(A[i], A[(i+1)%3], B[j], B[(j+1)%3], QA, QB);
+      d = RhCmnDistanceSquared(QA, QB);
+      if( d < best )
+      {
+        best = d;
+        PA[0] = QA[0]; PA[1] = QA[1]; PA[2] = QA[2];
+        PB[0] = QB[0]; PB[1] = QB[1]; PB[2] = QB[2];
+      }
+    }
+  }
+  return sqrt(best);
+}
+
+// Faces of one object in a clash search.
+class CRhCmnClashMesh
+{
+public:
+  CRhCmnClashMesh();
+
+  // Collects the faces of an ON_Mesh, the render meshes of the faces of an
+  // ON_Brep or the render mesh of an ON_Extrusion. Returns false when there
+  // are no faces to search.
+  bool Create(const ON_Geometry* geometry);
+
+  // Exact distance between face fi of this object, moved by xform when it
+  // is not null, and face other_fi of other.
+  double FaceDistance(int fi, const ON_Xform* xform, const CRhCmnClashMesh& other, int other_fi, ON_3dPoint& P, ON_3dPoint& other_P) const;
+
+  ON_BoundingBox FaceBoundingBox(int fi) const;
+
+  struct CFace
+  {
+    int m_vi[4];     // m_vi[2] == m_vi[3] for triangles
+    int m_component; // mesh face index, or brep face index for breps
+  };
+  ON_3dPointArray m_V;
+  ON_SimpleArray<CFace> m_F;
+  ON_RTree m_tree; // element ids are indices into m_F
+  ON_BoundingBox m_bbox;
+
+private:
+  void AddMesh(const ON_Mesh& mesh, int component);
+
+  // no copies
+  CRhCmnClashMesh(const CRhCmnClashMesh&);
+  CRhCmnClashMesh& operator=(const CRhCmnClashMesh&);
+};
+
+CRhCmnClashMesh::CRhCmnClashMesh()
+{
+}
+
+void CRhCmnClashMesh::AddMesh(const ON_Mesh& mesh, int component)
+{
+  const int v0 = m_V.Count();
+  const int vertex_count = mesh.VertexCount();
+  const int face_count = mesh.FaceCount();
+  m_V.Reserve(v0 + vertex_count);
+  for( int i=0; i<vertex_count; i++ )
+    m_V.Append(mesh.Vertex(i));
+  m_F.Reserve(m_F.Count() + face_count);
+  for( int i=0; i<face_count; i++ )
+  {
+    const ON_MeshFace& f = mesh.m_F[i];
+    if( !f.IsValid(vertex_count) )
+      continue;
+    CFace& face = m_F.AppendNew();
+    for( int j=0; j<4; j++ )
+      face.m_vi[j] = v0 + f.vi[j];
+    face.m_component = component < 0 ? i : component;
+  }
+}
+
+bool CRhCmnClashMesh::Create(const ON_Geometry* geometry)
+{
+  const ON_Mesh* mesh = ON_Mesh::Cast(geometry);
+  const ON_Brep* brep = ON_Brep::Cast(geometry);
+  const ON_Extrusion* extrusion = ON_Extrusion::Cast(geometry);
+  if( mesh )
+    AddMesh(*mesh, -1);
+  else if( brep )
+  {
+    for( int fi=0; fi<brep->m_F.Count(); fi++ )
+    {
+      const ON_Mesh* face_mesh = brep->m_F[fi].Mesh(ON::render_mesh);
+      if( face_mesh )
+        AddMesh(*face_mesh, fi);
+    }
+  }
+  else if( extrusion )
+  {
+    const ON_Mesh* render_mesh = extrusion->Mesh(ON::render_mesh);
+    if( render_mesh )
+      AddMesh(*render_mesh, -1);
+  }
+
+  for( int i=0; i<m_F.Count(); i++ )
+  {
+    const ON_BoundingBox bbox = FaceBoundingBox(i);
+    m_tree.Insert(&(bbox.m_min.x), &(bbox.m_max.x), i);
+    m_bbox.Union(bbox);
+  }
+  return m_F.Count() > 0;
+}
+
+ON_BoundingBox CRhCmnClashMesh::FaceBoundingBox(int fi) const
+{
+  const CFace& face = m_F[fi];
+  ON_BoundingBox bbox;
+  for( int j=0; j<4; j++ )
+    bbox.Set(m_V[face.m_vi[j]], j > 0);
+  return bbox;
+}
+
+double CRhCmnClashMesh::FaceDistance(int fi, const ON_Xform* xform, const CRhCmnClashMesh& other, int other_fi, ON_3dPoint& P, ON_3dPoint& other_P) const
+{
+  // quads are split along the 0-2 diagonal
+  const CFace& a = m_F[fi];
+  const CFace& b = other.m_F[other_fi];
+  ON_3dPoint V[4];
+  for( int j=0; j<4; j++ )
+  {
+    V[j] = m_V[a.m_vi[j]];
+    if( xform )
+      V[j] = (*xform)*V[j];
+  }
+  const double* A[2][3] = {
+    { &V[0].x, &V[1].x, &V[2].x },
+    { &V[0].x, &V[2].x, &V[3].x } };
+  const double* B[2][3] = {
+    { &other.m_V[b.m_vi[0]].x, &other.m_V[b.m_vi[1]].x, &other.m_V[b.m_vi[2]].x },
+    { &other.m_V[b.m_vi[0]].x, &other.m_V[b.m_vi[2]].x, &other.m_V[b.m_vi[3]].x } };
+  const int a_count = a.m_vi[2] == a.m_vi[3] ? 1 : 2;
+  const int b_count = b.m_vi[2] == b.m_vi[3] ? 1 : 2;
+
+  double best = ON_UNSET_POSITIVE_VALUE;
+  double PA[3], PB[3];
+  for( int i=0; i<a_count && best > 0.0; i++ )
+  {
+    for( int j=0; j<b_count && best > 0.0; j++ )
+    {
+      const double d = RhCmnTriangleDistance(A[i], B[j], PA, PB);
+      if( d < best )
+      {
+        best = d;
+        P.Set(PA[0], PA[1], PA[2]);
+        other_P.Set(PB[0], PB[1], PB[2]);
+      }
+    }
+  }
+  return best;
+}
+
+struct CRhCmnClashEvent
+{
+  int m_index[2];     // object indices in set A and set B
+  int m_component[2]; // face indices, brep face indices for breps
+  ON_3dPoint m_point[2];
+  double m_distance;
+};
+
+// Searches for faces of objects in set A that are within a distance of faces
+// of objects in set B. Results are produced in batches by Next() so callers
+// can stop early.
+class CRhCmnClashSearch
+{
+public:
+  CRhCmnClashSearch();
+  ~CRhCmnClashSearch();
+
+  // maxEventsPerPair < 1 means no limit. The same object in both sets is
+  // not searched against itself.
+  bool Create(const ON_Geometry* const* a, int countA, const ON_Geometry* const* b, int countB, double distance, int max_events_per_pair, int thread_count);
+
+  // Appends up to max_count events to events and returns the number
+  // appended. Returns 0 when the search is done.
+  int Next(int max_count, ON_SimpleArray<CRhCmnClashEvent>& events);
+  bool IsDone() const;
+
+private:
+  struct CTask
+  {
+    int m_pair;
+    int m_fi0; // faces [m_fi0, m_fi1) of the object from set A
+    int m_fi1;
+  };
+  static bool Prepare(void* context, int index, int thread_index);
+  static bool RunTask(void* context, int index, int thread_index);
+  static bool AddCandidate(void* context, ON__INT_PTR id);
+  void Run(const CTask& task, ON_SimpleArray<int>& candidates, ON_SimpleArray<CRhCmnClashEvent>& events);
+  void RunWave();
+
+  const ON_Geometry* const* m_geometry[2];
+  int m_count[2];
+  double m_distance;
+  int m_max_events_per_pair;
+  int m_thread_count;
+
+  ON_SimpleArray<CRhCmnClashMesh*> m_meshes; // set A followed by set B, null if nothing to search
+  ON_SimpleArray<ON_2dex> m_pairs;           // (index in set A, index in set B)
+  ON_SimpleArray<int> m_pair_event_counts;   // updated with RhCmnAtomicAdd
+  ON_SimpleArray<CTask> m_tasks;
+  int m_next_task;
+
+  // events of the tasks in the last wave, one array per task so results
+  // come out in task order no matter which thread ran them
+  int m_wave_first_task;
+  ON_ClassArray< ON_SimpleArray<CRhCmnClashEvent> > m_wave_events;
+  ON_ClassArray< ON_SimpleArray<int> > m_candidates; // per thread
+  ON_SimpleArray<CRhCmnClashEvent> m_pending;
+  int m_pending_index;
+
+private:
+  // no copies
+  CRhCmnClashSearch(const CRhCmnClashSearch&);
+  CRhCmnClashSearch& operator=(const CRhCmnClashSearch&);
+};
+
+CRhCmnClashSearch::CRhCmnClashSearch()
+: m_distance(0.0)
+, m_max_events_per_pair(0)
+, m_thread_count(1)
+, m_next_task(0)
+, m_wave_first_task(0)
+, m_pending_index(0)
+{
+  m_geometry[0] = m_geometry[1] = 0;
+  m_count[0] = m_count[1] = 0;
+}
+
+CRhCmnClashSearch::~CRhCmnClashSearch()
+{
+  for( int i=0; i<m_meshes.Count(); i++ )
+  {
+    if( m_meshes[i] )
+      delete m_meshes[i];
+  }
+}
+
+bool CRhCmnClashSearch::Prepare(void* context, int index, int)
+{
+  CRhCmnClashSearch* search = (CRhCmnClashSearch*)context;
+  const ON_Geometry* geometry = index < search->m_count[0]
+    ? search->m_geometry[0][index]
+    : search->m_geometry[1][index - search->m_count[0]];
+  CRhCmnClashMesh* mesh = new CRhCmnClashMesh();
+  if( !mesh->Create(geometry) )
+  {
+    delete mesh;
+    mesh = 0;
+  }
+  search->m_meshes[index] = mesh;
+  return true;
+}
+
+bool CRhCmnClashSearch::Create(const ON_Geometry* const* a, int countA, const ON_Geometry* const* b, int countB, double distance, int max_events_per_pair, int thread_count)
+{
+  if( 0 == a || 0 == b || countA < 1 || countB < 1 || !ON_IsValid(distance) || distance < 0.0 )
+    return false;
+  m_geometry[0] = a;
+  m_geometry[1] = b;
+  m_count[0] = countA;
+  m_count[1] = countB;
+  m_distance = distance;
+  m_max_events_per_pair = max_events_per_pair > 0 ? max_events_per_pair : 0;
+  m_thread_count = thread_count > 0 ? thread_count : RhCmnMaxThreadCount();
+
+  m_meshes.Reserve(countA + countB);
+  m_meshes.SetCount(countA + countB);
+  m_meshes.Zero();
+  RhCmnParallelFor(m_thread_count, countA + countB, Prepare, this);
+
+  // broad phase on the object boxes
+  ON_RTree tree;
+  for( int j=0; j<countB; j++ )
+  {
+    const CRhCmnClashMesh* mesh = m_meshes[countA + j];
+    if( mesh )
+      tree.Insert(&(mesh->m_bbox.m_min.x), &(mesh->m_bbox.m_max.x), j);
+  }
+  ON_SimpleArray<int> candidates;
+  for( int i=0; i<countA; i++ )
+  {
+    const CRhCmnClashMesh* mesh = m_meshes[i];
+    if( 0 == mesh )
+      continue;
+    ON_RTreeBBox box;
+    for( int k=0; k<3; k++ )
+    {
+      box.m_min[k] = mesh->m_bbox.m_min[k] - distance;
+      box.m_max[k] = mesh->m_bbox.m_max[k] + distance;
+    }
+    candidates.SetCount(0);
+    tree.Search(&box, AddCandidate, &candidates);
+    candidates.QuickSort(ON_CompareIncreasing<int>);
+    for( int c=0; c<candidates.Count(); c++ )
+    {
+      const int j = candidates[c];
+      if( a[i] == b[j] )
+        continue;
+      ON_2dex& pair = m_pairs.AppendNew();
+      pair.i = i;
+      pair.j = j;
+      // blocks of faces small enough to spread a single pair of large
+      // meshes over all threads
+      const int face_count = mesh->m_F.Count();
+      for( int fi=0; fi<face_count; fi += 256 )
+      {
+        CTask& task = m_tasks.AppendNew();
+        task.m_pair = m_pairs.Count()-1;
+        task.m_fi0 = fi;
+        task.m_fi1 = fi+256 < face_count ? fi+256 : face_count;
+      }
+    }
+  }
+  m_pair_event_counts.Reserve(m_pairs.Count());
+  m_pair_event_counts.SetCount(m_pairs.Count());
+  m_pair_event_counts.Zero();
+
+  m_candidates.Reserve(m_thread_count);
+  for( int i=0; i<m_thread_count; i++ )
+    m_candidates.AppendNew();
+  return true;
+}
+
+bool CRhCmnClashSearch::AddCandidate(void* context, ON__INT_PTR id)
+{
+  ((ON_SimpleArray<int>*)context)->Append((int)id);
+  return true;
+}
+
+void CRhCmnClashSearch::Run(const CTask& task, ON_SimpleArray<int>& candidates, ON_SimpleArray<CRhCmnClashEvent>& events)
+{
+  const ON_2dex& pair = m_pairs[task.m_pair];
+  volatile int* event_count = m_pair_event_counts.At(task.m_pair);
+  const CRhCmnClashMesh& a = *m_meshes[pair.i];
+  const CRhCmnClashMesh& b = *m_meshes[m_count[0] + pair.j];
+  ON_3dPoint PA, PB;
+  for( int fi=task.m_fi0; fi<task.m_fi1; fi++ )
+  {
+    // stop as soon as another task filled up this pair
+    if( m_max_events_per_pair > 0 && *event_count >= m_max_events_per_pair )
+      return;
+    const ON_BoundingBox bbox = a.FaceBoundingBox(fi);
+    ON_RTreeBBox box;
+    for( int k=0; k<3; k++ )
+    {
+      box.m_min[k] = bbox.m_min[k] - m_distance;
+      box.m_max[k] = bbox.m_max[k] + m_distance;
+    }
+    candidates.SetCount(0);
+    b.m_tree.Search(&box, AddCandidate, &candidates);
+    for( int c=0; c<candidates.Count(); c++ )
+    {
+      const double d = a.FaceDistance(fi, 0, b, candidates[c], PA, PB);
+      if( d > m_distance )
+        continue;
+      if( m_max_events_per_pair > 0 && RhCmnAtomicAdd(event_count, 1) > m_max_events_per_pair )
+        return;
+      CRhCmnClashEvent& e = events.AppendNew();
+      e.m_index[0] = pair.i;
+      e.m_index[1] = pair.j;
+      e.m_component[0] = a.m_F[fi].m_component;
+      e.m_component[1] = b.m_F[candidates[c]].m_component;
+      e.m_point[0] = PA;
+      e.m_point[1] = PB;
+      e.m_distance = d;
+    }
+  }
+}
+
+bool CRhCmnClashSearch::RunTask(void* context, int index, int thread_index)
+{
+  CRhCmnClashSearch* search = (CRhCmnClashSearch*)context;
+  search->Run(search->m_tasks[search->m_wave_first_task + index], search->m_candidates[thread_index], search->m_wave_events[index]);
+  return true;
+}
+
+void CRhCmnClashSearch::RunWave()
+{
+  // Starting threads is not free, so every wave has enough tasks to keep
+  // them busy for a while.
+  int wave_count = m_tasks.Count() - m_next_task;
+  if( wave_count > 16*m_thread_count )
+    wave_count = 16*m_thread_count;
+  m_wave_first_task = m_next_task;
+  m_next_task += wave_count;
+  while( m_wave_events.Count() < wave_count )
+    m_wave_events.AppendNew();
+  for( int i=0; i<wave_count; i++ )
+    m_wave_events[i].SetCount(0);
+  RhCmnParallelFor(m_thread_count, wave_count, RunTask, this);
+
+  m_pending.SetCount(0);
+  m_pending_index = 0;
+  for( int i=0; i<wave_count; i++ )
+    m_pending.Append(m_wave_events[i].Count(), m_wave_events[i].Array());
+}
+
+int CRhCmnClashSearch::Next(int max_count, ON_SimpleArray<CRhCmnClashEvent>& events)
+{
+  int rc = 0;
+  while( rc < max_count )
+  {
+    if( m_pending_index >= m_pending.Count() )
+    {
+      if( m_next_task >= m_tasks.Count() )
+        break;
+      RunWave();
+      continue;
+    }
+    int count = m_pending.Count() - m_pending_index;
+    if( count > max_count - rc )
+      count = max_count - rc;
+    events.Append(count, m_pending.Array() + m_pending_index);
+    m_pending_index += count;
+    rc += count;
+  }
+  return rc;
+}
+
+bool CRhCmnClashSearch::IsDone() const
+{
+  return m_pending_index >= m_pending.Count() && m_next_task >= m_tasks.Count();
+}
+
+RH_C_FUNCTION CRhCmnClashSearch* ON_ClashSearch_New(const ON_SimpleArray<const ON_Geometry*>* pConstGeometryA, const ON_SimpleArray<const ON_Geometry*>* pConstGeometryB, double distance, int maxEventsPerPair, int threadCount)
+{
+  CRhCmnClashSearch* rc = 0;
+  if( pConstGeometryA && pConstGeometryB )
+  {
+    rc = new CRhCmnClashSearch();
+    if( !rc->Create(pConstGeometryA->Array(), pConstGeometryA->Count(), pConstGeometryB->Array(), pConstGeometryB->Count(), distance, maxEventsPerPair, threadCount) )
+    {
+      delete rc;
+      rc = 0;
+    }
+  }
+  return rc;
+}
+
+RH_C_FUNCTION void ON_ClashSearch_Delete(CRhCmnClashSearch* pSearch)
+{
+  if( pSearch )
+    delete pSearch;
+}
+
+// Each event is 4 ints (index A, index B, face A, face B) and 7 doubles
+// (point on A, point on B, distance).
+RH_C_FUNCTION int ON_ClashSearch_Next(CRhCmnClashSearch* pSearch, int maxCount, ON_SimpleArray<int>* pIndices, ON_SimpleArray<double>* pValues)
+{
+  int rc = 0;
+  if( pSearch && pIndices && pValues && maxCount > 0 )
+  {
+    ON_SimpleArray<CRhCmnClashEvent> events;
+    rc = pSearch->Next(maxCount, events);
+    pIndices->Reserve(pIndices->Count() + 4*rc);
+    pValues->Reserve(pValues->Count() + 7*rc);
+    for( int i=0; i<rc; i++ )
+    {
+      const CRhCmnClashEvent& e = events[i];
+      pIndices->Append(e.m_index[0]);
+      pIndices->Append(e.m_index[1]);
+      pIndices->Append(e.m_component[0]);
+      pIndices->Append(e.m_component[1]);
+      pValues->Append(3, &(e.m_point[0].x));
+      pValues->Append(3, &(e.m_point[1].x));
+      pValues->Append(e.m_distance);
+    }
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_ClashSearch_IsDone(const CRhCmnClashSearch* pConstSearch)
+{
+  bool rc = true;
+  if( pConstSearch )
+    rc = pConstSearch->IsDone();
+  return rc;
+}
+
+
+////////////////////////////////////////////////////////////////////////////
+// Clearance along a path. The objects in set A are moved by a list of rigid
+// transformations and the smallest distance to set B is computed at every
+// sample. Face trees are built once: set A in its own coordinates and set B
+// in world coordinates. Each (sample, object in A) combination is an
+// independent branch and bound search run on a worker thread.
+
+class CRhCmnClearanceSweep
+{
+public:
+  CRhCmnClearanceSweep();
+  ~CRhCmnClearanceSweep();
+
+  // Distances larger than max_distance are not computed exactly. A
+  // max_distance <= 0 means no limit.
+  bool Create(const ON_Geometry* const* a, int countA, const ON_Geometry* const* b, int countB, double max_distance, int thread_count);
+
+  // xforms are 16 doubles per sample in row major order.
+  bool Sweep(int xform_count, const double* xforms);
+
+  struct CResult
+  {
+    double m_distance; // max_distance when nothing is closer
+    int m_index_b;     // -1 when nothing is closer than max_distance
+    ON_3dPoint m_point[2];
+  };
+
+  // Results of the last sweep, sample s and object a of set A at [s*countA + a].
+  ON_SimpleArray<CResult> m_results;
+  int m_count[2];
+
+private:
+  struct CQuery
+  {
+    ON_Xform m_xform;
+    const CRhCmnClashMesh* m_a;
+    const CRhCmnClashMesh* m_b;
+    CResult* m_result;
+    int m_index_b;
+  };
+  struct CCandidate
+  {
+    double m_distance; // between the object boxes
+    int m_index_b;
+  };
+  static int CompareCandidate(const CCandidate* a, const CCandidate* b);
+  static bool Prepare(void* context, int index, int thread_index);
+  static bool SearchSample(void* context, int index, int thread_index);
+  static bool AddCandidate(void* context, ON__INT_PTR id);
+  static void TransformBox(const ON_Xform& xform, const ON_RTreeBBox& box, ON_RTreeBBox& world_box);
+  static double BoxDistance(const ON_RTreeBBox& a, const ON_RTreeBBox& b);
+  static ON_RTreeBranch RootBranch(const CRhCmnClashMesh& mesh);
+  void Search(CQuery& query, const ON_RTreeBranch& a, bool a_element, const ON_RTreeBranch& b, bool b_element) const;
+
+  const ON_Geometry* const* m_geometry[2];
+  double m_max_distance;
+  int m_thread_count;
+  ON_SimpleArray<CRhCmnClashMesh*> m_meshes; // set A followed by set B, null if nothing to search
+  ON_RTree m_tree_b;                         // object boxes of set B
+  const double* m_xforms;
+
+private:
+  // no copies
+  CRhCmnClearanceSweep(const CRhCmnClearanceSweep&);
+  CRhCmnClearanceSweep& operator=(const CRhCmnClearanceSweep&);
+};
+
+CRhCmnClearanceSweep::CRhCmnClearanceSweep()
+: m_max_distance(ON_UNSET_POSITIVE_VALUE)
+, m_thread_count(1)
+, m_xforms(0)
+{
+  m_geometry[0] = m_geometry[1] = 0;
+  m_count[0] = m_count[1] = 0;
+}
+
+CRhCmnClearanceSweep::~CRhCmnClearanceSweep()
+{
+  for( int i=0; i<m_meshes.Count(); i++ )
+  {
+    if( m_meshes[i] )
+      delete m_meshes[i];
+  }
+}
+
+bool CRhCmnClearanceSweep::Prepare(void* context, int index, int)
+{
+  CRhCmnClearanceSweep* sweep = (CRhCmnClearanceSweep*)context;
+  const ON_Geometry* geometry = index < sweep->m_count[0]
+    ? sweep->m_geometry[0][index]
+    : sweep->m_geometry[1][index - sweep->m_count[0]];
+  CRhCmnClashMesh* mesh = new CRhCmnClashMesh();
+  if( !mesh->Create(geometry) )
+  {
+    delete mesh;
+    mesh = 0;
+  }
+  sweep->m_meshes[index] = mesh;
+  return true;
+}
+
+bool CRhCmnClearanceSweep::Create(const ON_Geometry* const* a, int countA, const ON_Geometry* const* b, int countB, double max_distance, int thread_count)
+{
+  if( 0 == a || 0 == b || countA < 1 || countB < 1 )
+    return false;
+  m_geometry[0] = a;
+  m_geometry[1] = b;
+  m_count[0] = countA;
+  m_count[1] = countB;
+  m_max_distance = ON_IsValid(max_distance) && max_distance > 0.0 ? max_distance : ON_UNSET_POSITIVE_VALUE;
+  m_thread_count = thread_count > 0 ? thread_count : RhCmnMaxThreadCount();
+
+  m_meshes.Reserve(countA + countB);
+  m_meshes.SetCount(countA + countB);
+  m_meshes.Zero();
+  RhCmnParallelFor(m_thread_count, countA + countB, Prepare, this);
+
+  for( int j=0; j<countB; j++ )
+  {
+    const CRhCmnClashMesh* mesh = m_meshes[countA + j];
+    if( mesh )
+      m_tree_b.Insert(&(mesh->m_bbox.m_min.x), &(mesh->m_bbox.m_max.x), j);
+  }
+  return true;
+}
+
+void CRhCmnClearanceSweep::TransformBox(const ON_Xform& xform, const ON_RTreeBBox& box, ON_RTreeBBox& world_box)
+{
+  // Arvo's method: transform the center and add up the absolute values
+  // of the transformed half extents.
+  double c[3], r[3];
+  for( int k=0; k<3; k++ )
+  {
+    c[k] = 0.5*(box.m_min[k] + box.m_max[k]);
+    r[k] = 0.5*(box.m_max[k] - box.m_min[k]);
+  }
+  for( int i=0; i<3; i++ )
+  {
+    const double* row = xform.m_xform[i];
+    const double wc = row[0]*c[0] + row[1]*c[1] + row[2]*c[2] + row[3];
+    const double wr = fabs(row[0])*r[0] + fabs(row[1])*r[1] + fabs(row[2])*r[2];
+    world_box.m_min[i] = wc - wr;
+    world_box.m_max[i] = wc + wr;
+  }
+}
+
+double CRhCmnClearanceSweep::BoxDistance(const ON_RTreeBBox& a, const ON_RTreeBBox& b)
+{
+  double d = 0.0;
+  for( int k=0; k<3; k++ )
+  {
+    double gap = a.m_min[k] - b.m_max[k];
+    if( b.m_min[k] - a.m_max[k] > gap )
+      gap = b.m_min[k] - a.m_max[k];
+    if( gap > 0.0 )
+      d += gap*gap;
+  }
+  return sqrt(d);
+}
+
+ON_RTreeBranch CRhCmnClearanceSweep::RootBranch(const CRhCmnClashMesh& mesh)
+{
+  ON_RTreeBranch root;
+  memset(&root, 0, sizeof(root));
+  for( int k=0; k<3; k++ )
+  {
+    root.m_rect.m_min[k] = mesh.m_bbox.m_min[k];
+    root.m_rect.m_max[k] = mesh.m_bbox.m_max[k];
+  }
+  root.m_child = const_cast<ON_RTreeNode*>(mesh.m_tree.Root());
+  return root;
+}
+
+// a is in the coordinates of query.m_a and is moved by query.m_xform, b is
+// in world coordinates. Elements are branches of leaf nodes, their m_id is
+// a face index.
+void CRhCmnClearanceSweep::Search(CQuery& query, const ON_RTreeBranch& a, bool a_element, const ON_RTreeBranch& b, bool b_element) const
+{
+  if( a_element && b_element )
+  {
+    ON_3dPoint PA, PB;
+    const double d = query.m_a->FaceDistance((int)a.m_id, &query.m_xform, *query.m_b, (int)b.m_id, PA, PB);
+    if( d < query.m_result->m_distance )
+    {
+      query.m_result->m_distance = d;
+      query.m_result->m_index_b = query.m_index_b;
+      query.m_result->m_point[0] = PA;
+      query.m_result->m_point[1] = PB;
+    }
+    return;
+  }
+
+  // Open the side that is not an element, or the larger box when both can
+  // be opened, and visit the children closest first so the bound tightens
+  // quickly.
+  ON_RTreeBBox a_box;
+  TransformBox(query.m_xform, a.m_rect, a_box);
+  bool bOpenA = !a_element;
+  if( bOpenA && !b_element )
+  {
+    double size_a = 0.0, size_b = 0.0;
+    for( int k=0; k<3; k++ )
+    {
+      size_a += a_box.m_max[k] - a_box.m_min[k];
+      size_b += b.m_rect.m_max[k] - b.m_rect.m_min[k];
+    }
+    bOpenA = size_a >= size_b;
+  }
+  const ON_RTreeNode* node = bOpenA ? a.m_child : b.m_child;
+  if( 0 == node || node->m_count < 1 )
+    return;
+
+  double distance[ON_RTree_MAX_NODE_COUNT];
+  int order[ON_RTree_MAX_NODE_COUNT];
+  for( int i=0; i<node->m_count; i++ )
+  {
+    if( bOpenA )
+    {
+      ON_RTreeBBox child_box;
+      TransformBox(query.m_xform, node->m_branch[i].m_rect, child_box);
+      distance[i] = BoxDistance(child_box, b.m_rect);
+    }
+    else
+      distance[i] = BoxDistance(a_box, node->m_branch[i].m_rect);
+    // insertion sort, there are at most ON_RTree_MAX_NODE_COUNT children
+    int j = i;
+    for( ; j > 0 && distance[order[j-1]] > distance[i]; j-- )
+      order[j] = order[j-1];
+    order[j] = i;
+  }
+  const bool bChildIsElement = node->IsLeaf();
+  for( int i=0; i<node->m_count; i++ )
+  {
+    if( distance[order[i]] >= query.m_result->m_distance )
+      break;
+    const ON_RTreeBranch& child = node->m_branch[order[i]];
+    if( bOpenA )
+      Search(query, child, bChildIsElement, b, b_element);
+    else
+      Search(query, a, a_element, child, bChildIsElement);
+  }
+}
+
+int CRhCmnClearanceSweep::CompareCandidate(const CCandidate* a, const CCandidate* b)
+{
+  if( a->m_distance < b->m_distance )
+    return -1;
+  if( a->m_distance > b->m_distance )
+    return 1;
+  return a->m_index_b - b->m_index_b;
+}
+
+bool CRhCmnClearanceSweep::AddCandidate(void* context, ON__INT_PTR id)
+{
+  ((ON_SimpleArray<int>*)context)->Append((int)id);
+  return true;
+}
+
+bool CRhCmnClearanceSweep::SearchSample(void* context, int index, int)
+{
+  CRhCmnClearanceSweep* sweep = (CRhCmnClearanceSweep*)context;
+  const int countA = sweep->m_count[0];
+  CResult& result = sweep->m_results[index];
+  const CRhCmnClashMesh* mesh = sweep->m_meshes[index % countA];
+  if( 0 == mesh )
+    return true;
+
+  CQuery query;
+  query.m_xform = ON_Xform(sweep->m_xforms + 16*(index / countA));
+  query.m_a = mesh;
+  query.m_result = &result;
+
+  const ON_RTreeBranch root_a = RootBranch(*mesh);
+  ON_RTreeBBox a_box;
+  TransformBox(query.m_xform, root_a.m_rect, a_box);
+  ON_RTreeBBox box = a_box;
+  if( result.m_distance < ON_UNSET_POSITIVE_VALUE )
+  {
+    for( int k=0; k<3; k++ )
+    {
+      box.m_min[k] -= result.m_distance;
+      box.m_max[k] += result.m_distance;
+    }
+  }
+  ON_SimpleArray<int> candidates;
+  if( result.m_distance < ON_UNSET_POSITIVE_VALUE )
+    sweep->m_tree_b.Search(&box, AddCandidate, &candidates);
+  else
+  {
+    for( int j=0; j<sweep->m_count[1]; j++ )
+      candidates.Append(j);
+  }
+
+  // closest objects first
+  ON_SimpleArray<CCandidate> order(candidates.Count());
+  for( int c=0; c<candidates.Count(); c++ )
+  {
+    const CRhCmnClashMesh* b = sweep->m_meshes[countA + candidates[c]];
+    if( 0 == b )
+      continue;
+    ON_RTreeBBox b_box;
+    for( int k=0; k<3; k++ )
+    {
+      b_box.m_min[k] = b->m_bbox.m_min[k];
+      b_box.m_max[k] = b->m_bbox.m_max[k];
+    }
+    CCandidate& o = order.AppendNew();
+    o.m_distance = BoxDistance(a_box, b_box);
+    o.m_index_b = candidates[c];
+  }
+  order.QuickSort(CompareCandidate);
+
+  for( int c=0; c<order.Count(); c++ )
+  {
+    if( order[c].m_distance >= result.m_distance )
+      break;
+    query.m_index_b = order[c].m_index_b;
+    query.m_b = sweep->m_meshes[countA + query.m_index_b];
+    const ON_RTreeBranch root_b = RootBranch(*query.m_b);
+    sweep->Search(query, root_a, false, root_b, false);
+  }
+  return true;
+}
+
+bool CRhCmnClearanceSweep::Sweep(int xform_count, const double* xforms)
+{
+  if( xform_count < 1 || 0 == xforms || m_count[0] < 1 )
+    return false;
+  const int count = xform_count*m_count[0];
+  m_results.Reserve(count);
+  m_results.SetCount(count);
+  for( int i=0; i<count; i++ )
+  {
+    m_results[i].m_distance = m_max_distance;
+    m_results[i].m_index_b = -1;
+    m_results[i].m_point[0] = ON_3dPoint::UnsetPoint;
+    m_results[i].m_point[1] = ON_3dPoint::UnsetPoint;
+  }
+  m_xforms = xforms;
+  RhCmnParallelFor(m_thread_count, count, SearchSample, this);
+  m_xforms = 0;
+  return true;
+}
+
+// Moves every object of set A by each of the transformations in xforms (16
+// doubles per sample, row major) and finds the smallest distance to set B.
+// Per sample: distances gets the smallest distance over all objects of A,
+// closestIndices the indices in A and B of the closest pair (-1 when nothing
+// is closer than maxDistance) and closestPoints the points on A and B.
+// firstContact gets, for every object of A, the path parameter where its
+// distance first drops to clearance, interpolated between samples, or -1.
+// firstContactAll gets the first contact parameter of all of set A, or -1.
+// Returns false when nothing could be computed.
+RH_C_FUNCTION bool ON_ClearanceSweep(const ON_SimpleArray<const ON_Geometry*>* pConstGeometryA, const ON_SimpleArray<const ON_Geometry*>* pConstGeometryB, int xformCount, /*ARRAY*/const double* xforms, double clearance, double maxDistance, int threadCount, /*ARRAY*/double* distances, /*ARRAY*/int* closestIndices, /*ARRAY*/ON_3dPoint* closestPoints, /*ARRAY*/double* firstContact, double* firstContactAll)
+{
+  if( 0 == pConstGeometryA || 0 == pConstGeometryB || xformCount < 1 || 0 == xforms || 0 == distances || 0 == closestIndices || 0 == closestPoints || 0 == firstContact || 0 == firstContactAll )
+    return false;
+
+  CRhCmnClearanceSweep sweep;
+  if( !sweep.Create(pConstGeometryA->Array(), pConstGeometryA->Count(), pConstGeometryB->Array(), pConstGeometryB->Count(), maxDistance, threadCount) )
+    return false;
+  if( !sweep.Sweep(xformCount, xforms) )
+    return false;
+
+  const int countA = sweep.m_count[0];
+  for( int s=0; s<xformCount; s++ )
+  {
+    int best = -1;
+    for( int a=0; a<countA; a++ )
+    {
+      const CRhCmnClearanceSweep::CResult& r = sweep.m_results[s*countA + a];
+      if( r.m_index_b >= 0 && (best < 0 || r.m_distance < sweep.m_results[s*countA + best].m_distance) )
+        best = a;
+    }
+    if( best >= 0 )
+    {
+      const CRhCmnClearanceSweep::CResult& r = sweep.m_results[s*countA + best];
+      distances[s] = r.m_distance;
+      closestIndices[2*s] = best;
+      closestIndices[2*s+1] = r.m_index_b;
+      closestPoints[2*s] = r.m_point[0];
+      closestPoints[2*s+1] = r.m_point[1];
+    }
+    else
+    {
+      distances[s] = sweep.m_results[s*countA].m_distance;
+      closestIndices[2*s] = closestIndices[2*s+1] = -1;
+      closestPoints[2*s] = closestPoints[2*s+1] = ON_3dPoint::UnsetPoint;
+    }
+  }
+
+  double rc = -1.0;
+  for( int a=0; a<countA; a++ )
+  {
+    firstContact[a] = -1.0;
+    for( int s=0; s<xformCount; s++ )
+    {
+      // clamped samples (m_index_b < 0) carry max_distance, not a measurement
+      const CRhCmnClearanceSweep::CResult& r = sweep.m_results[s*countA + a];
+      if( r.m_index_b < 0 || r.m_distance > clearance )
+        continue;
+      double t = (double)s;
+      if( s > 0 )
+      {
+        // the distance is linear between samples as far as we know
+        const CRhCmnClearanceSweep::CResult& r0 = sweep.m_results[(s-1)*countA + a];
+        if( r0.m_index_b >= 0 && r0.m_distance > r.m_distance )
+          t = (s-1) + (r0.m_distance - clearance)/(r0.m_distance - r.m_distance);
+      }
+      firstContact[a] = t;
+      if( rc < 0.0 || t < rc )
+        rc = t;
+      break;
+    }
+  }
+  *firstContactAll = rc;
+  return true;
+}
@@ -79,6 +79,423 @@ RH_C_FUNCTION void ON_SimpleArray_PolylineCurve_Delete(ON_SimpleArray<ON_Polylin
 }
 
 
+static double RhCmnSegmentDistanceSquared(const ON_3dPoint& P, const ON_3dPoint& A, const ON_3dPoint& B)
+{
+  const ON_3dVector AB = B - A;
+  const ON_3dVector AP = P - A;
+  const double ab2 = AB*AB;
+  double t = (ab2 > 0.0) ? (AP*AB)/ab2 : 0.0;
+  if( t < 0.0 )
+    t = 0.0;
+  else if( t > 1.0 )
+    t = 1.0;
+  const ON_3dVector D = AP - t*AB;
+  return D*D;
+}
+
+static double RhCmnTriangleArea(const ON_3dPoint& A, const ON_3dPoint& B, const ON_3dPoint& C)
+{
+  return 0.5*ON_CrossProduct(B-A, C-A).Length();
+}
+
+struct CRhCmnAreaHeapItem
+{
+  double m_area;
+  int m_index;
+};
+
+static void RhCmnAreaHeapPush(ON_SimpleArray<CRhCmnAreaHeapItem>& heap, double area, int index)
+{
+  CRhCmnAreaHeapItem item;
+  item.m_area = area;
+  item.m_index = index;
+  int i = heap.Count();
+  heap.Append(item);
+  while( i > 0 )
+  {
+    const int parent = (i-1)/2;
+    if( !(heap[i].m_area < heap[parent].m_area) )
+      break;
+    const CRhCmnAreaHeapItem t = heap[i]; heap[i] = heap[parent]; heap[parent] = t;
+    i = parent;
+  }
+}
+
+static CRhCmnAreaHeapItem RhCmnAreaHeapPop(ON_SimpleArray<CRhCmnAreaHeapItem>& heap)
+{
+  const CRhCmnAreaHeapItem top = heap[0];
+  const int count = heap.Count()-1;
+  heap[0] = heap[count];
+  heap.SetCount(count);
+  int i = 0;
+  for(;;)
+  {
+    const int l = 2*i+1, r = l+1;
+    int m = i;
+    if( l < count && heap[l].m_area < heap[m].m_area )
+      m = l;
+    if( r < count && heap[r].m_area < heap[m].m_area )
+      m = r;
+    if( m == i )
+      break;
+    const CRhCmnAreaHeapItem t = heap[i]; heap[i] = heap[m]; heap[m] = t;
+    i = m;
+  }
+  return top;
+}
+
+// Directions a chord from an anchor vertex can take so that every vertex it
+// skips stays within tolerance of it. A skipped vertex V (relative to the
+// anchor) further than tolerance away allows the cone of directions within
+// asin(tolerance/|V|) of V. Cones are intersected one vertex at a time and
+// only the largest circular cone inside the intersection is kept, so every
+// step is O(1). That cone is never larger than the exact set of directions,
+// so the tolerance holds; a few more vertices may be kept than necessary.
+class CRhCmnChordCone
+{
+public:
+  CRhCmnChordCone(double tolerance);
+
+  void Reset();
+
+  // V is a skipped vertex relative to the anchor
+  void Add(const ON_3dVector& V);
+
+  // true when the chord from the anchor to D stays within tolerance of
+  // every vertex added since Reset()
+  bool Fits(const ON_3dVector& D) const;
+
+private:
+  const double m_tolerance;
+  ON_3dVector m_axis;
+  double m_angle; // half angle, > ON_PI for no limit, < 0 when empty
+  double m_reach; // largest distance from the anchor to an added vertex
+};
+
+CRhCmnChordCone::CRhCmnChordCone(double tolerance)
+: m_tolerance(tolerance)
+{
+  Reset();
+}
+
+void CRhCmnChordCone::Reset()
+{
+  m_axis = ON_3dVector(0,0,0);
+  m_angle = 2.0*ON_PI;
+  m_reach = 0.0;
+}
+
+void CRhCmnChordCone::Add(const ON_3dVector& V)
+{
+  const double d = V.Length();
+  if( d > m_reach )
+    m_reach = d;
+  // vertices near the anchor are within tolerance of any chord
+  if( d <= m_tolerance || m_angle < 0.0 )
+    return;
+  const ON_3dVector axis = V/d;
+  const double angle = asin(m_tolerance/d);
+  if( m_angle > ON_PI )
+  {
+    m_axis = axis;
+    m_angle = angle;
+    return;
+  }
+  double c = m_axis*axis;
+  if( c > 1.0 ) c = 1.0;
+  if( c < -1.0 ) c = -1.0;
+  const double g = acos(c);
+  if( g + angle <= m_angle )
+  {
+    m_axis = axis;
+    m_angle = angle;
+  }
+  else if( g + m_angle <= angle )
+  {
+    // the current cone is already inside the new one
+  }
+  else if( g > m_angle + angle )
+    m_angle = -1.0;
+  else
+  {
+    // inscribed cone of the lens, centered on the arc between the axes
+    const double s = 0.5*(g + m_angle - angle);
+    ON_3dVector w = axis - c*m_axis;
+    if( w.Unitize() )
+      m_axis = cos(s)*m_axis + sin(s)*w;
+    m_angle = 0.5*(m_angle + angle - g);
+  }
+}
+
+bool CRhCmnChordCone::Fits(const ON_3dVector& D) const
+{
+  if( m_angle > ON_PI )
+    return true;
+  if( m_angle < 0.0 )
+    return false;
+  // the chord has to reach past every skipped vertex, so they are measured
+  // against the segment and not the line through it
+  const double length = D.Length();
+  if( !(length > 0.0) || length < m_reach )
+    return false;
+  return D*m_axis >= length*cos(m_angle);
+}
+
+// Picks the vertices of a polyline to keep. kept gets increasing indices
+// that always include the first and last vertex.
+//   method 0: Douglas-Peucker, tolerance is the largest distance from a
+//             removed vertex to the simplified polyline.
+//   method 1: Visvalingam-Whyatt, vertices whose effective triangle area is
+//             below tolerance are removed, smallest first.
+//   method 2: chordal deviation, every chord is extended while all the
+//             vertices it skips stay within tolerance (see CRhCmnChordCone).
+// A closed polyline that would end up with fewer than 4 vertices is kept
+// as it is.
+static int RhCmnSimplifyPolyline(const ON_3dPoint* P, int count, int method, double tolerance, ON_SimpleArray<int>& kept)
+{
+  kept.SetCount(0);
+  if( count < 1 || 0 == P )
+    return 0;
+  int i;
+  if( count < 3 || !(tolerance > 0.0) || method < 0 || method > 2 )
+  {
+    kept.Reserve(count);
+    for( i=0; i<count; i++ )
+      kept.Append(i);
+    return count;
+  }
+
+  ON_SimpleArray<bool> keep(count);
+  keep.SetCount(count);
+  keep.Zero();
+  keep[0] = true;
+  keep[count-1] = true;
+
+  if( 0 == method )
+  {
+    const double tol2 = tolerance*tolerance;
+    ON_SimpleArray<int> stack(64);
+    stack.Append(0);
+    stack.Append(count-1);
+    while( stack.Count() > 0 )
+    {
+      const int b = stack[stack.Count()-1];
+      const int a = stack[stack.Count()-2];
+      stack.SetCount(stack.Count()-2);
+      double max_d2 = 0.0;
+      int max_i = -1;
+      for( i=a+1; i<b; i++ )
+      {
+        const double d2 = RhCmnSegmentDistanceSquared(P[i], P[a], P[b]);
+        if( d2 > max_d2 )
+        {
+          max_d2 = d2;
+          max_i = i;
+        }
+      }
+      if( max_i > 0 && max_d2 > tol2 )
+      {
+        keep[max_i] = true;
+        stack.Append(a);
+        stack.Append(max_i);
+        stack.Append(max_i);
+        stack.Append(b);
+      }
+    }
+  }
+  else if( 1 == method )
+  {
+    const bool bClosed = (count >= 4 && P[0] == P[count-1]);
+    ON_SimpleArray<int> prev(count), next(count);
+    ON_SimpleArray<double> area(count);
+    prev.SetCount(count);
+    next.SetCount(count);
+    area.SetCount(count);
+    ON_SimpleArray<CRhCmnAreaHeapItem> heap(count);
+    for( i=0; i<count; i++ )
+    {
+      prev[i] = i-1;
+      next[i] = i+1;
+      area[i] = (i > 0 && i < count-1) ? RhCmnTriangleArea(P[i-1], P[i], P[i+1]) : ON_UNSET_POSITIVE_VALUE;
+      if( i > 0 && i < count-1 )
+        RhCmnAreaHeapPush(heap, area[i], i);
+    }
+    int remaining = count;
+    const int min_remaining = bClosed ? 4 : 2;
+    double last_area = 0.0;
+    while( heap.Count() > 0 && remaining > min_remaining )
+    {
+      const CRhCmnAreaHeapItem item = RhCmnAreaHeapPop(heap);
+      const int v = item.m_index;
+      if( item.m_area != area[v] || -2 == prev[v] )
+        continue; // stale entry
+      if( !(item.m_area < tolerance) )
+        break;
+      // effective areas never decrease, so a vertex is not removed before
+      // the ones that were cheaper to remove
+      if( item.m_area > last_area )
+        last_area = item.m_area;
+      const int p = prev[v], n = next[v];
+      next[p] = n;
+      prev[n] = p;
+      prev[v] = -2;
+      remaining--;
+      if( p > 0 )
+      {
+        double a = RhCmnTriangleArea(P[prev[p]], P[p], P[n]);
+        area[p] = (a > last_area) ? a : last_area;
+        RhCmnAreaHeapPush(heap, area[p], p);
+      }
+      if( n < count-1 )
+      {
+        double a = RhCmnTriangleArea(P[p], P[n], P[next[n]]);
+        area[n] = (a > last_area) ? a : last_area;
+        RhCmnAreaHeapPush(heap, area[n], n);
+      }
+    }
+    for( i=1; i<count-1; i++ )
+      keep[i] = (-2 != prev[i]);
+  }
+  else
+  {
+    // j is the end of the current chord; the chord to j+1 skips j
+    CRhCmnChordCone cone(tolerance);
+    int anchor = 0;
+    int j = 1;
+    while( j+1 < count )
+    {
+      cone.Add(P[j] - P[anchor]);
+      if( !cone.Fits(P[j+1] - P[anchor]) )
+      {
+        anchor = j;
+        keep[anchor] = true;
+        cone.Reset();
+      }
+      j++;
+    }
+  }
+
+  kept.Reserve(count);
+  for( i=0; i<count; i++ )
+  {
+    if( keep[i] )
+      kept.Append(i);
+  }
+  if( kept.Count() < 4 && count >= 4 && P[0] == P[count-1] )
+  {
+    kept.SetCount(0);
+    for( i=0; i<count; i++ )
+      kept.Append(i);
+  }
+  return kept.Count();
+}
+
+// Simplifies a polyline curve in place and keeps the parameters of the
+// remaining vertices. Returns the number of vertices removed.
+static int RhCmnSimplifyPolylineCurve(ON_PolylineCurve& curve, int method, double tolerance, ON_SimpleArray<int>& kept)
+{
+  const int count = curve.m_pline.Count();
+  const int kept_count = RhCmnSimplifyPolyline(curve.m_pline.Array(), count, method, tolerance, kept);
+  if( kept_count < 2 || kept_count == count )
+    return 0;
+  const bool bHasParameters = (curve.m_t.Count() == count);
+  for( int i=0; i<kept_count; i++ )
+  {
+    curve.m_pline[i] = curve.m_pline[kept[i]];
+    if( bHasParameters )
+      curve.m_t[i] = curve.m_t[kept[i]];
+  }
+  curve.m_pline.SetCount(kept_count);
+  if( bHasParameters )
+    curve.m_t.SetCount(kept_count);
+  return count - kept_count;
+}
+
+RH_C_FUNCTION int ON_Polyline_Simplify(int point_count, /*ARRAY*/const ON_3dPoint* points, int method, double tolerance, ON_SimpleArray<int>* kept)
+{
+  int rc = 0;
+  if( kept )
+    rc = RhCmnSimplifyPolyline(points, point_count, method, tolerance, *kept);
+  return rc;
+}
+
+RH_C_FUNCTION int ON_PolylineCurve_Simplify(ON_PolylineCurve* pCurve, int method, double tolerance)
+{
+  int rc = 0;
+  if( pCurve )
+  {
+    ON_SimpleArray<int> kept;
+    rc = RhCmnSimplifyPolylineCurve(*pCurve, method, tolerance, kept);
+  }
+  return rc;
+}
+
+class CRhCmnPolylineCurveSimplifier
+{
+public:
+  CRhCmnPolylineCurveSimplifier(ON_Curve* const* curves, int method, double tolerance, int* removed)
+  : m_curves(curves), m_method(method), m_tolerance(tolerance), m_removed(removed)
+  {
+  }
+
+  static int CompareCurve(ON_Curve* const* a, ON_Curve* const* b)
+  {
+    if( *a == *b )
+      return 0;
+    return *a < *b ? -1 : 1;
+  }
+
+  static bool Run(void* context, int index, int)
+  {
+    const CRhCmnPolylineCurveSimplifier* pThis = (const CRhCmnPolylineCurveSimplifier*)context;
+    ON_PolylineCurve* curve = ON_PolylineCurve::Cast(pThis->m_curves[index]);
+    int removed = 0;
+    if( curve )
+    {
+      ON_SimpleArray<int> kept;
+      removed = RhCmnSimplifyPolylineCurve(*curve, pThis->m_method, pThis->m_tolerance, kept);
+    }
+    pThis->m_removed[index] = removed;
+    return true;
+  }
+
+private:
+  ON_Curve* const* m_curves;
+  const int m_method;
+  const double m_tolerance;
+  int* m_removed;
+};
+
+// Simplifies every polyline curve in the array in place, one curve per
+// work item. Other curve types are skipped and a curve that appears more
+// than once is only simplified once, so no two threads write to the same
+// curve. Returns the total number of vertices removed.
+RH_C_FUNCTION int ON_PolylineCurve_SimplifyBatch(ON_SimpleArray<ON_Curve*>* pCurves, int method, double tolerance, int threadCount)
+{
+  int rc = 0;
+  if( pCurves )
+  {
+    ON_SimpleArray<ON_Curve*> curves(*pCurves);
+    curves.QuickSort(CRhCmnPolylineCurveSimplifier::CompareCurve);
+    int count = 0;
+    for( int i=0; i<curves.Count(); i++ )
+    {
+      if( NULL == curves[i] || (count > 0 && curves[count-1] == curves[i]) )
+        continue;
+      curves[count++] = curves[i];
+    }
+    curves.SetCount(count);
+    ON_SimpleArray<int> removed(count);
+    removed.SetCount(count);
+    CRhCmnPolylineCurveSimplifier simplifier(curves.Array(), method, tolerance, removed.Array());
+    RhCmnParallelFor(threadCount, count, CRhCmnPolylineCurveSimplifier::Run, &simplifier);
+    for( int i=0; i<count; i++ )
+      rc += removed[i];
+  }
+  return rc;
+}
+
+
 #if !defined(OPENNURBS_BUILD)
 RH_C_FUNCTION void ON_PolylineCurve_Draw(const ON_PolylineCurve* pCrv, CRhinoDisplayPipeline* pDisplayPipeline, int argb, int thickness)
 {
@@ -48,4 +48,465 @@ RH_C_FUNCTION void ON_Quaternion_Rotate( const ON_Quaternion* q, ON_3DVECTOR_STR
   }
 }
 
-#endif
\ No newline at end of file
+#endif
+
+// Batched quaternion and rigid transformation kernels, for animating many
+// parts per frame. They only use the quaternion coefficients, so unlike the
+// functions above they are also in the stand alone OpenNURBS build. Items
+// are independent and processed in blocks with RhCmnParallelFor; results
+// do not depend on the thread count.
+
+static const int RHCMN_QUATERNION_BLOCK = 1024;
+
+static int RhCmnQuaternionBlockCount(int count)
+{
+  return count > 0 ? (count + RHCMN_QUATERNION_BLOCK - 1)/RHCMN_QUATERNION_BLOCK : 0;
+}
+
+// Interpolates between unit quaternions along the shorter arc. Nearly
+// parallel pairs and bNlerp use the normalized linear interpolation.
+static ON_Quaternion RhCmnQuaternionInterpolate(const ON_Quaternion& q0, const ON_Quaternion& q1, double t, bool bNlerp)
+{
+  double d = q0.a*q1.a + q0.b*q1.b + q0.c*q1.c + q0.d*q1.d;
+  double sign = 1.0;
+  if( d < 0.0 )
+  {
+    d = -d;
+    sign = -1.0;
+  }
+  double w0, w1;
+  const bool bLinear = bNlerp || d > 0.9995;
+  if( bLinear )
+  {
+    w0 = 1.0 - t;
+    w1 = t;
+  }
+  else
+  {
+    const double theta = acos(d);
+    const double sin_theta = sin(theta);
+    w0 = sin((1.0 - t)*theta)/sin_theta;
+    w1 = sin(t*theta)/sin_theta;
+  }
+  w1 *= sign;
+  ON_Quaternion q(w0*q0.a + w1*q1.a, w0*q0.b + w1*q1.b, w0*q0.c + w1*q1.c, w0*q0.d + w1*q1.d);
+  if( bLinear )
+  {
+    const double len = sqrt(q.a*q.a + q.b*q.b + q.c*q.c + q.d*q.d);
+    if( len > 0.0 )
+    {
+      const double s = 1.0/len;
+      q.a *= s; q.b *= s; q.c *= s; q.d *= s;
+    }
+  }
+  return q;
+}
+
+// R = rotation of q/|q|, the same rotation as ON_Quaternion::Rotate.
+// The zero quaternion gives the identity.
+static void RhCmnQuaternionRotation(const ON_Quaternion& q, double R[3][3])
+{
+  const double len2 = q.a*q.a + q.b*q.b + q.c*q.c + q.d*q.d;
+  const double s = (len2 > 0.0) ? 2.0/len2 : 0.0;
+  R[0][0] = 1.0 - s*(q.c*q.c + q.d*q.d);
+  R[0][1] = s*(q.b*q.c - q.a*q.d);
+  R[0][2] = s*(q.b*q.d + q.a*q.c);
+  R[1][0] = s*(q.b*q.c + q.a*q.d);
+  R[1][1] = 1.0 - s*(q.b*q.b + q.d*q.d);
+  R[1][2] = s*(q.c*q.d - q.a*q.b);
+  R[2][0] = s*(q.b*q.d - q.a*q.c);
+  R[2][1] = s*(q.c*q.d + q.a*q.b);
+  R[2][2] = 1.0 - s*(q.b*q.b + q.c*q.c);
+}
+
+// Unit quaternion with a >= 0 of the rotation part of a rigid transformation.
+// Returns false, and the zero quaternion, when the 3x3 part is not a rotation
+// within tolerance or the bottom row is not (0,0,0,1).
+static bool RhCmnXformToQuaternion(const ON_Xform& xform, double tolerance, ON_Quaternion& q)
+{
+  const double (*m)[4] = xform.m_xform;
+  q.a = q.b = q.c = q.d = 0.0;
+  if( m[3][0] != 0.0 || m[3][1] != 0.0 || m[3][2] != 0.0 || m[3][3] != 1.0 )
+    return false;
+  int i, j;
+  for( i=0; i<3; i++ )
+  {
+    for( j=i; j<3; j++ )
+    {
+      const double d = m[0][i]*m[0][j] + m[1][i]*m[1][j] + m[2][i]*m[2][j];
+      if( fabs(d - (i == j ? 1.0 : 0.0)) > tolerance )
+        return false;
+    }
+  }
+  const double det = m[0][0]*(m[1][1]*m[2][2] - m[1][2]*m[2][1])
+                   - m[0][1]*(m[1][0]*m[2][2] - m[1][2]*m[2][0])
+                   + m[0][2]*(m[1][0]*m[2][1] - m[1][1]*m[2][0]);
+  if( !(det > 0.0) )
+    return false;
+
+  // Shepperd: divide by the largest of 4a^2, 4b^2, 4c^2, 4d^2
+  const double tr = m[0][0] + m[1][1] + m[2][2];
+  double s;
+  if( tr > 0.0 )
+  {
+    s = 2.0*sqrt(tr + 1.0);
+    q.a = 0.25*s;
+    q.b = (m[2][1] - m[1][2])/s;
+    q.c = (m[0][2] - m[2][0])/s;
+    q.d = (m[1][0] - m[0][1])/s;
+  }
+  else if( m[0][0] > m[1][1] && m[0][0] > m[2][2] )
+  {
+    s = 2.0*sqrt(1.0 + m[0][0] - m[1][1] - m[2][2]);
+    q.a = (m[2][1] - m[1][2])/s;
+    q.b = 0.25*s;
+    q.c = (m[0][1] + m[1][0])/s;
+    q.d = (m[0][2] + m[2][0])/s;
+  }
+  else if( m[1][1] > m[2][2] )
+  {
+    s = 2.0*sqrt(1.0 + m[1][1] - m[0][0] - m[2][2]);
+    q.a = (m[0][2] - m[2][0])/s;
+    q.b = (m[0][1] + m[1][0])/s;
+    q.c = 0.25*s;
+    q.d = (m[1][2] + m[2][1])/s;
+  }
+  else
+  {
+    s = 2.0*sqrt(1.0 + m[2][2] - m[0][0] - m[1][1]);
+    q.a = (m[1][0] - m[0][1])/s;
+    q.b = (m[0][2] + m[2][0])/s;
+    q.c = (m[1][2] + m[2][1])/s;
+    q.d = 0.25*s;
+  }
+  if( q.a < 0.0 )
+  {
+    q.a = -q.a; q.b = -q.b; q.c = -q.c; q.d = -q.d;
+  }
+  return true;
+}
+
+class CRhCmnQuaternionBatch
+{
+public:
+  CRhCmnQuaternionBatch(int count);
+
+  // Every task handles one block of items. Arrays with a count of 1 are
+  // used for every item.
+  static bool Interpolate(void* context, int index, int thread_index);
+  static bool RotateVectors(void* context, int index, int thread_index);
+  static bool ToXforms(void* context, int index, int thread_index);
+  static bool FromXforms(void* context, int index, int thread_index);
+
+  const int m_count;
+  const ON_Quaternion* m_q0;
+  const ON_Quaternion* m_q1;
+  int m_q_count;
+  const double* m_t;
+  int m_t_count;
+  bool m_bNlerp;
+  const ON_3dVector* m_vin;
+  ON_3dVector* m_vout;
+  ON_Quaternion* m_qout;
+  const ON_Xform* m_xin;
+  ON_Xform* m_xout;
+  double m_tolerance;
+  ON_SimpleArray<int> m_block_result; // FromXforms: rigid transformations per block
+
+private:
+  void Range(int index, int& i0, int& i1) const;
+  // no copies
+  CRhCmnQuaternionBatch(const CRhCmnQuaternionBatch&);
+  CRhCmnQuaternionBatch& operator=(const CRhCmnQuaternionBatch&);
+};
+
+CRhCmnQuaternionBatch::CRhCmnQuaternionBatch(int count)
+: m_count(count)
+, m_q0(NULL)
+, m_q1(NULL)
+, m_q_count(0)
+, m_t(NULL)
+, m_t_count(0)
+, m_bNlerp(false)
+, m_vin(NULL)
+, m_vout(NULL)
+, m_qout(NULL)
+, m_xin(NULL)
+, m_xout(NULL)
+, m_tolerance(0.0)
+{
+}
+
+void CRhCmnQuaternionBatch::Range(int index, int& i0, int& i1) const
+{
+  i0 = index*RHCMN_QUATERNION_BLOCK;
+  i1 = (i0 + RHCMN_QUATERNION_BLOCK < m_count) ? i0 + RHCMN_QUATERNION_BLOCK : m_count;
+}
+
+bool CRhCmnQuaternionBatch::Interpolate(void* context, int index, int)
+{
+  const CRhCmnQuaternionBatch* pThis = (const CRhCmnQuaternionBatch*)context;
+  int i0, i1;
+  pThis->Range(index, i0, i1);
+  for( int i=i0; i<i1; i++ )
+  {
+    const double t = pThis->m_t[pThis->m_t_count > 1 ? i : 0];
+    pThis->m_qout[i] = RhCmnQuaternionInterpolate(pThis->m_q0[i], pThis->m_q1[i], t, pThis->m_bNlerp);
+  }
+  return true;
+}
+
+bool CRhCmnQuaternionBatch::RotateVectors(void* context, int index, int)
+{
+  const CRhCmnQuaternionBatch* pThis = (const CRhCmnQuaternionBatch*)context;
+  int i0, i1;
+  pThis->Range(index, i0, i1);
+  double R[3][3];
+  if( 1 == pThis->m_q_count )
+    RhCmnQuaternionRotation(pThis->m_q0[0], R);
+  for( int i=i0; i<i1; i++ )
+  {
+    if( pThis->m_q_count > 1 )
+      RhCmnQuaternionRotation(pThis->m_q0[i], R);
+    const ON_3dVector v = pThis->m_vin[i];
+    ON_3dVector& r = pThis->m_vout[i];
+    r.x = R[0][0]*v.x + R[0][1]*v.y + R[0][2]*v.z;
+    r.y = R[1][0]*v.x + R[1][1]*v.y + R[1][2]*v.z;
+    r.z = R[2][0]*v.x + R[2][1]*v.y + R[2][2]*v.z;
+  }
+  return true;
+}
+
+bool CRhCmnQuaternionBatch::ToXforms(void* context, int index, int)
+{
+  const CRhCmnQuaternionBatch* pThis = (const CRhCmnQuaternionBatch*)context;
+  int i0, i1;
+  pThis->Range(index, i0, i1);
+  double R[3][3];
+  for( int i=i0; i<i1; i++ )
+  {
+    RhCmnQuaternionRotation(pThis->m_q0[i], R);
+    double (*m)[4] = pThis->m_xout[i].m_xform;
+    for( int j=0; j<3; j++ )
+    {
+      m[j][0] = R[j][0];
+      m[j][1] = R[j][1];
+      m[j][2] = R[j][2];
+    }
+    m[0][3] = pThis->m_vin ? pThis->m_vin[i].x : 0.0;
+    m[1][3] = pThis->m_vin ? pThis->m_vin[i].y : 0.0;
+    m[2][3] = pThis->m_vin ? pThis->m_vin[i].z : 0.0;
+    m[3][0] = m[3][1] = m[3][2] = 0.0;
+    m[3][3] = 1.0;
+  }
+  return true;
+}
+
+bool CRhCmnQuaternionBatch::FromXforms(void* context, int index, int)
+{
+  CRhCmnQuaternionBatch* pThis = (CRhCmnQuaternionBatch*)context;
+  int i0, i1;
+  pThis->Range(index, i0, i1);
+  int rigid_count = 0;
+  for( int i=i0; i<i1; i++ )
+  {
+    const ON_Xform& xform = pThis->m_xin[i];
+    if( RhCmnXformToQuaternion(xform, pThis->m_tolerance, pThis->m_qout[i]) )
+      rigid_count++;
+    if( pThis->m_vout )
+      pThis->m_vout[i].Set(xform.m_xform[0][3], xform.m_xform[1][3], xform.m_xform[2][3]);
+  }
+  pThis->m_block_result[index] = rigid_count;
+  return true;
+}
+
+// tCount is 1, to use t[0] for every pair, or count
+RH_C_FUNCTION bool ON_Quaternion_InterpolateBatch(int count, /*ARRAY*/const ON_Quaternion* q0, /*ARRAY*/const ON_Quaternion* q1, int tCount, /*ARRAY*/const double* t, bool nlerp, /*ARRAY*/ON_Quaternion* result, int threadCount)
+{
+  bool rc = false;
+  if( count >= 0 && q0 && q1 && t && result && (1 == tCount || count == tCount) )
+  {
+    CRhCmnQuaternionBatch batch(count);
+    batch.m_q0 = q0;
+    batch.m_q1 = q1;
+    batch.m_t = t;
+    batch.m_t_count = tCount;
+    batch.m_bNlerp = nlerp;
+    batch.m_qout = result;
+    rc = RhCmnParallelFor(threadCount, RhCmnQuaternionBlockCount(count), CRhCmnQuaternionBatch::Interpolate, &batch);
+  }
+  return rc;
+}
+
+// quaternionCount is 1, to rotate every vector by q[0], or count
+RH_C_FUNCTION bool ON_Quaternion_RotateVectors(int quaternionCount, /*ARRAY*/const ON_Quaternion* q, int count, /*ARRAY*/const ON_3dVector* vectors, /*ARRAY*/ON_3dVector* result, int threadCount)
+{
+  bool rc = false;
+  if( count >= 0 && q && vectors && result && (1 == quaternionCount || count == quaternionCount) )
+  {
+    CRhCmnQuaternionBatch batch(count);
+    batch.m_q0 = q;
+    batch.m_q_count = quaternionCount;
+    batch.m_vin = vectors;
+    batch.m_vout = result;
+    rc = RhCmnParallelFor(threadCount, RhCmnQuaternionBlockCount(count), CRhCmnQuaternionBatch::RotateVectors, &batch);
+  }
+  return rc;
+}
+
+// xforms[i] rotates by q[i] and then translates by translations[i]. translations may be NULL.
+RH_C_FUNCTION bool ON_Quaternion_ToXformBatch(int count, /*ARRAY*/const ON_Quaternion* q, /*ARRAY*/const ON_3dVector* translations, /*ARRAY*/ON_Xform* xforms, int threadCount)
+{
+  bool rc = false;
+  if( count >= 0 && q && xforms )
+  {
+    CRhCmnQuaternionBatch batch(count);
+    batch.m_q0 = q;
+    batch.m_vin = translations;
+    batch.m_xout = xforms;
+    rc = RhCmnParallelFor(threadCount, RhCmnQuaternionBlockCount(count), CRhCmnQuaternionBatch::ToXforms, &batch);
+  }
+  return rc;
+}
+
+// Returns the number of rigid transformations. The others get the zero quaternion.
+RH_C_FUNCTION int ON_Xform_ToQuaternionBatch(int count, /*ARRAY*/const ON_Xform* xforms, double tolerance, /*ARRAY*/ON_Quaternion* q, /*ARRAY*/ON_3dVector* translations, int threadCount)
+{
+  int rc = 0;
+  if( count > 0 && xforms && q )
+  {
+    const int block_count = RhCmnQuaternionBlockCount(count);
+    CRhCmnQuaternionBatch batch(count);
+    batch.m_xin = xforms;
+    batch.m_tolerance = tolerance;
+    batch.m_qout = q;
+    batch.m_vout = translations;
+    batch.m_block_result.Reserve(block_count);
+    batch.m_block_result.SetCount(block_count);
+    RhCmnParallelFor(threadCount, block_count, CRhCmnQuaternionBatch::FromXforms, &batch);
+    for( int i=0; i<block_count; i++ )
+      rc += batch.m_block_result[i];
+  }
+  return rc;
+}
+
+// world[i] = world[parents[i]]*local[i], or local[i] when parents[i] < 0.
+// Parts are composed level by level, each level in parallel.
+class CRhCmnXformHierarchy
+{
+public:
+  CRhCmnXformHierarchy(int count, const ON_Xform* local, const int* parents, ON_Xform* world);
+  bool Compose(int thread_count);
+
+private:
+  static bool ComposeLevel(void* context, int index, int thread_index);
+
+  const int m_count;
+  const ON_Xform* m_local;
+  const int* m_parents;
+  ON_Xform* m_world;
+  ON_SimpleArray<int> m_order; // parts sorted by depth
+  int m_level_start;
+  int m_level_count;
+
+  // no copies
+  CRhCmnXformHierarchy(const CRhCmnXformHierarchy&);
+  CRhCmnXformHierarchy& operator=(const CRhCmnXformHierarchy&);
+};
+
+CRhCmnXformHierarchy::CRhCmnXformHierarchy(int count, const ON_Xform* local, const int* parents, ON_Xform* world)
+: m_count(count)
+, m_local(local)
+, m_parents(parents)
+, m_world(world)
+, m_level_start(0)
+, m_level_count(0)
+{
+}
+
+bool CRhCmnXformHierarchy::ComposeLevel(void* context, int index, int)
+{
+  const CRhCmnXformHierarchy* pThis = (const CRhCmnXformHierarchy*)context;
+  const int i0 = index*RHCMN_QUATERNION_BLOCK;
+  const int i1 = (i0 + RHCMN_QUATERNION_BLOCK < pThis->m_level_count) ? i0 + RHCMN_QUATERNION_BLOCK : pThis->m_level_count;
+  for( int k=i0; k<i1; k++ )
+  {
+    const int i = pThis->m_order[pThis->m_level_start + k];
+    const int parent = pThis->m_parents[i];
+    if( parent < 0 )
+      pThis->m_world[i] = pThis->m_local[i];
+    else
+      pThis->m_world[i] = pThis->m_world[parent]*pThis->m_local[i];
+  }
+  return true;
+}
+
+bool CRhCmnXformHierarchy::Compose(int thread_count)
+{
+  // depth of every part, -1 = not known yet, -2 = on the current path
+  ON_SimpleArray<int> depth(m_count);
+  depth.SetCount(m_count);
+  ON_SimpleArray<int> path;
+  int i, max_depth = 0;
+  for( i=0; i<m_count; i++ )
+  {
+    if( m_parents[i] >= m_count )
+      return false;
+    depth[i] = -1;
+  }
+  for( i=0; i<m_count; i++ )
+  {
+    int j = i;
+    while( j >= 0 && -1 == depth[j] )
+    {
+      depth[j] = -2;
+      path.Append(j);
+      j = m_parents[j];
+    }
+    if( j >= 0 && -2 == depth[j] )
+      return false; // cycle
+    int d = (j >= 0) ? depth[j] : -1;
+    while( path.Count() > 0 )
+    {
+      depth[*path.Last()] = ++d;
+      path.SetCount(path.Count()-1);
+    }
+    if( depth[i] > max_depth )
+      max_depth = depth[i];
+  }
+
+  // counting sort by depth
+  ON_SimpleArray<int> level_start(max_depth+2);
+  level_start.SetCount(max_depth+2);
+  level_start.Zero();
+  for( i=0; i<m_count; i++ )
+    level_start[depth[i]+1]++;
+  for( i=0; i<=max_depth; i++ )
+    level_start[i+1] += level_start[i];
+  ON_SimpleArray<int> next(max_depth+1);
+  next.Append(max_depth+1, level_start.Array());
+  m_order.Reserve(m_count);
+  m_order.SetCount(m_count);
+  for( i=0; i<m_count; i++ )
+    m_order[next[depth[i]]++] = i;
+
+  for( int level=0; level<=max_depth && m_count>0; level++ )
+  {
+    m_level_start = level_start[level];
+    m_level_count = level_start[level+1] - m_level_start;
+    RhCmnParallelFor(thread_count, RhCmnQuaternionBlockCount(m_level_count), ComposeLevel, this);
+  }
+  return true;
+}
+
+// Returns false when a parent index is out of range or the parents have a cycle.
+RH_C_FUNCTION bool ON_Xform_ComposeHierarchy(int count, /*ARRAY*/const ON_Xform* local, /*ARRAY*/const int* parents, /*ARRAY*/ON_Xform* world, int threadCount)
+{
+  bool rc = false;
+  if( count >= 0 && local && parents && world )
+  {
+    CRhCmnXformHierarchy hierarchy(count, local, parents, world);
+    rc = hierarchy.Compose(threadCount);
+  }
+  return rc;
+}
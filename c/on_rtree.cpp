@@ -37,13 +37,208 @@ RH_C_FUNCTION bool ON_RTree_CreatePointCloudTree(ON_RTree* pTree, const ON_Point
   return rc;
 }
 
+// defined in on_geometry.cpp
+extern "C" bool ON_Geometry_GetTightBoundingBox(const ON_Geometry* ptr, ON_BoundingBox* bbox, ON_Xform* xform, bool useXform);
+
+// Builds a tree over a list of geometry. Bounding boxes are computed on
+// worker threads. Some geometry caches its bounding box when asked for it,
+// so a piece of geometry that appears more than once in the list is only
+// measured once, by one thread. ON_RTree has no bulk loading interface, so
+// the boxes are sorted along a Morton (Z-order) curve of their centers and
+// then inserted in that order, which keeps insertions local and gives well
+// packed nodes.
+class CRhCmnRTreeGeometryBuilder
+{
+public:
+  CRhCmnRTreeGeometryBuilder(const ON_Geometry* const* geometry, int count, bool bTight);
+
+  bool Build(ON_RTree& tree, int thread_count);
+
+private:
+  struct CEntry
+  {
+    ON__UINT64 m_key;
+    int m_index;
+  };
+  struct CGeometryRef
+  {
+    const ON_Geometry* m_geometry;
+    int m_index;
+  };
+  static bool GetBox(void* context, int index, int thread_index);
+  static int CompareEntry(const CEntry* a, const CEntry* b);
+  static int CompareGeometryRef(const CGeometryRef* a, const CGeometryRef* b);
+  static ON__UINT64 SpreadBits(ON__UINT64 x);
+
+  const ON_Geometry* const* m_geometry;
+  const int m_count;
+  const bool m_bTight;
+  ON_SimpleArray<ON_BoundingBox> m_boxes;
+  ON_SimpleArray<int> m_distinct; // index of the first copy of every geometry
+};
+
+CRhCmnRTreeGeometryBuilder::CRhCmnRTreeGeometryBuilder(const ON_Geometry* const* geometry, int count, bool bTight)
+: m_geometry(geometry)
+, m_count(count)
+, m_bTight(bTight)
+{
+}
+
+bool CRhCmnRTreeGeometryBuilder::GetBox(void* context, int index, int)
+{
+  CRhCmnRTreeGeometryBuilder* builder = (CRhCmnRTreeGeometryBuilder*)context;
+  const int i = builder->m_distinct[index];
+  const ON_Geometry* geometry = builder->m_geometry[i];
+  ON_BoundingBox& bbox = builder->m_boxes[i];
+  if( !builder->m_bTight || !ON_Geometry_GetTightBoundingBox(geometry, &bbox, 0, false) )
+    bbox = geometry->BoundingBox();
+  return true;
+}
+
+int CRhCmnRTreeGeometryBuilder::CompareGeometryRef(const CGeometryRef* a, const CGeometryRef* b)
+{
+  if( a->m_geometry < b->m_geometry )
+    return -1;
+  if( a->m_geometry > b->m_geometry )
+    return 1;
+  return a->m_index - b->m_index;
+}
+
+int CRhCmnRTreeGeometryBuilder::CompareEntry(const CEntry* a, const CEntry* b)
+{
+  if( a->m_key < b->m_key )
+    return -1;
+  if( a->m_key > b->m_key )
+    return 1;
+  return a->m_index - b->m_index;
+}
+
+ON__UINT64 CRhCmnRTreeGeometryBuilder::SpreadBits(ON__UINT64 x)
+{
+  // spread the low 21 bits of x so there are two zero bits between each
+  x &= 0x1fffff;
+  x = (x | (x << 32)) & 0x001f00000000ffffULL;
+  x = (x | (x << 16)) & 0x001f0000ff0000ffULL;
+  x = (x | (x << 8))  & 0x100f00f00f00f00fULL;
+  x = (x | (x << 4))  & 0x10c30c30c30c30c3ULL;
+  x = (x | (x << 2))  & 0x1249249249249249ULL;
+  return x;
+}
+
+bool CRhCmnRTreeGeometryBuilder::Build(ON_RTree& tree, int thread_count)
+{
+  // empty input, or input without a single valid box, gives an empty tree
+  if( 0 == m_geometry || m_count < 1 )
+    return true;
+  m_boxes.SetCapacity(m_count);
+  m_boxes.SetCount(m_count);
+  for( int i=0; i<m_count; i++ )
+    m_boxes[i].Destroy();
+
+  ON_SimpleArray<CGeometryRef> refs(m_count);
+  for( int i=0; i<m_count; i++ )
+  {
+    if( 0 == m_geometry[i] )
+      continue;
+    CGeometryRef& ref = refs.AppendNew();
+    ref.m_geometry = m_geometry[i];
+    ref.m_index = i;
+  }
+  refs.QuickSort(CompareGeometryRef);
+  m_distinct.Reserve(refs.Count());
+  m_distinct.SetCount(0);
+  for( int i=0; i<refs.Count(); i++ )
+  {
+    if( 0 == i || refs[i].m_geometry != refs[i-1].m_geometry )
+      m_distinct.Append(refs[i].m_index);
+  }
+  RhCmnParallelFor(thread_count, m_distinct.Count(), GetBox, this);
+  int first = -1;
+  for( int i=0; i<refs.Count(); i++ )
+  {
+    if( 0 == i || refs[i].m_geometry != refs[i-1].m_geometry )
+      first = refs[i].m_index;
+    else
+      m_boxes[refs[i].m_index] = m_boxes[first];
+  }
+
+  ON_BoundingBox extents;
+  for( int i=0; i<m_count; i++ )
+  {
+    if( m_boxes[i].IsValid() )
+      extents.Union(m_boxes[i]);
+  }
+  if( !extents.IsValid() )
+    return true;
+
+  double scale[3];
+  for( int k=0; k<3; k++ )
+  {
+    const double d = extents.m_max[k] - extents.m_min[k];
+    scale[k] = d > 0.0 ? 2097151.0/d : 0.0;
+  }
+  ON_SimpleArray<CEntry> entries(m_count);
+  for( int i=0; i<m_count; i++ )
+  {
+    const ON_BoundingBox& bbox = m_boxes[i];
+    if( !bbox.IsValid() )
+      continue;
+    const ON_3dPoint center = bbox.Center();
+    CEntry& entry = entries.AppendNew();
+    entry.m_index = i;
+    entry.m_key = 0;
+    for( int k=0; k<3; k++ )
+      entry.m_key |= SpreadBits((ON__UINT64)((center[k] - extents.m_min[k])*scale[k])) << k;
+  }
+  entries.QuickSort(CompareEntry);
+
+  bool rc = true;
+  for( int i=0; i<entries.Count() && rc; i++ )
+  {
+    const ON_BoundingBox& bbox = m_boxes[entries[i].m_index];
+    rc = tree.Insert(&(bbox.m_min.x), &(bbox.m_max.x), entries[i].m_index);
+  }
+  return rc;
+}
+
+// Element ids are indices into the geometry array. Null entries and geometry
+// without a valid bounding box are skipped.
+RH_C_FUNCTION bool ON_RTree_CreateGeometryTree(ON_RTree* pTree, const ON_SimpleArray<const ON_Geometry*>* pConstGeometryArray, bool tight, int threadCount)
+{
+  bool rc = false;
+  if( pTree && pConstGeometryArray )
+  {
+    CRhCmnRTreeGeometryBuilder builder(pConstGeometryArray->Array(), pConstGeometryArray->Count(), tight);
+    rc = builder.Build(*pTree, threadCount);
+  }
+  return rc;
+}
+
+// Element ids are indices into the model's object table.
+RH_C_FUNCTION bool ON_RTree_CreateModelObjectTree(ON_RTree* pTree, const ONX_Model* pConstModel, bool tight, int threadCount)
+{
+  bool rc = false;
+  if( pTree && pConstModel )
+  {
+    const int count = pConstModel->m_object_table.Count();
+    ON_SimpleArray<const ON_Geometry*> geometry(count);
+    for( int i=0; i<count; i++ )
+      geometry.Append(ON_Geometry::Cast(pConstModel->m_object_table[i].m_object));
+    CRhCmnRTreeGeometryBuilder builder(geometry.Array(), count, tight);
+    rc = builder.Build(*pTree, threadCount);
+  }
+  return rc;
+}
+
 struct ON_RTreeSearchContext
 {
   int m_serial_number;
-  int m_mode; //0=none, 1=bbox, 2=sphere, 3=capsule
+  int m_mode; //0=none, 1=bbox, 2=sphere, 3=capsule, 4=ray
   ON_RTreeBBox m_bbox;
   ON_RTreeSphere m_sphere;
   // ON_RTreeCapsule m_capsule; // not using yet
+  double m_ray_t;     // ray parameter where the ray enters the element's box
+  double m_ray_limit; // ray parameter where the search stops
 };
 
 RH_C_FUNCTION bool ON_RTreeSearchContext_GetBoundingBox(const ON_RTreeSearchContext* pConstContext, ON_3dPoint* p0, ON_3dPoint* p1)
@@ -100,6 +295,29 @@ RH_C_FUNCTION bool ON_RTreeSearchContext_SetSphere(ON_RTreeSearchContext* pConte
   return rc;
 }
 
+RH_C_FUNCTION bool ON_RTreeSearchContext_GetRayParameters(const ON_RTreeSearchContext* pConstContext, double* t, double* limit)
+{
+  bool rc = false;
+  if( pConstContext && 4==pConstContext->m_mode && t && limit )
+  {
+    *t = pConstContext->m_ray_t;
+    *limit = pConstContext->m_ray_limit;
+    rc = true;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_RTreeSearchContext_SetRayLimit(ON_RTreeSearchContext* pContext, double limit)
+{
+  bool rc = false;
+  if( pContext && 4==pContext->m_mode && ON_IsValid(limit) )
+  {
+    pContext->m_ray_limit = limit;
+    rc = true;
+  }
+  return rc;
+}
+
 
 typedef int (CALLBACK* RTREESEARCHPROC)(int serial_number, void* idA, void* idB, ON_RTreeSearchContext* pSearchContext);
 static RTREESEARCHPROC g_theRTreeSearcher = NULL;
@@ -212,4 +430,1470 @@ RH_C_FUNCTION int ON_RTree_ElementCount(ON_RTree* pTree)
   if( pTree )
     rc = pTree->ElementCount();
   return rc;
-}
\ No newline at end of file
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Packed RTree
+//
+// A read-only copy of an ON_RTree stored in one contiguous block of memory.
+// Child pointers are replaced by node indices so the block does not depend
+// on where it lives. The block can be written to a 3dm chunk or a sidecar
+// file and searched in place (for example straight out of a memory mapped
+// file) without rebuilding the tree.
+//
+// Layout: CRhCmnPackedRTreeHeader followed by m_node_count nodes in breadth
+// first order. Node 0 is the root.
+
+#define RHCMN_PACKED_RTREE_SIGNATURE 0x50525452 // "RTRP"
+#define RHCMN_PACKED_RTREE_VERSION 1
+
+struct CRhCmnPackedRTreeBranch
+{
+  ON_RTreeBBox m_rect;
+  // node index when the owning node is internal, element id when it is a leaf
+  ON__INT64 m_child_or_id;
+};
+
+struct CRhCmnPackedRTreeNode
+{
+  int m_level; // 0 = leaf
+  int m_count;
+  CRhCmnPackedRTreeBranch m_branch[ON_RTree_MAX_NODE_COUNT];
+};
+
+struct CRhCmnPackedRTreeHeader
+{
+  unsigned int m_signature;
+  unsigned int m_version;
+  unsigned int m_sizeof_node;
+  unsigned int m_node_count;
+  unsigned int m_element_count;
+  unsigned int m_node_crc; // ON_CRC32 of the node array
+  unsigned int m_reserved[2];
+  ON_RTreeBBox m_bbox;
+};
+
+static int RhCmnRTreeNodeCount(const ON_RTreeNode* node)
+{
+  int count = 0;
+  if( node )
+  {
+    count = 1;
+    if( node->IsInternalNode() )
+    {
+      for( int i=0; i<node->m_count; i++ )
+        count += RhCmnRTreeNodeCount(node->m_branch[i].m_child);
+    }
+  }
+  return count;
+}
+
+static bool RhCmnRTreeBBoxOverlap(const ON_RTreeBBox* a, const ON_RTreeBBox* b)
+{
+  return ( a->m_min[0] <= b->m_max[0] && b->m_min[0] <= a->m_max[0] &&
+           a->m_min[1] <= b->m_max[1] && b->m_min[1] <= a->m_max[1] &&
+           a->m_min[2] <= b->m_max[2] && b->m_min[2] <= a->m_max[2] );
+}
+
+static bool RhCmnRTreeBBoxOverlapSphere(const ON_RTreeBBox* a_rect, const ON_RTreeSphere* a_sphere)
+{
+  double d2 = 0.0;
+  for( int i=0; i<3; i++ )
+  {
+    double t = a_sphere->m_point[i];
+    if( t < a_rect->m_min[i] )
+      t = a_rect->m_min[i] - t;
+    else if( t > a_rect->m_max[i] )
+      t = t - a_rect->m_max[i];
+    else
+      continue;
+    d2 += t*t;
+  }
+  return ( d2 <= a_sphere->m_radius*a_sphere->m_radius );
+}
+
+CRhCmnPackedRTree::CRhCmnPackedRTree()
+: m_header(0)
+, m_nodes(0)
+, m_buffer_size(0)
+, m_owned_buffer(0)
+{
+}
+
+CRhCmnPackedRTree::~CRhCmnPackedRTree()
+{
+  Destroy();
+}
+
+void CRhCmnPackedRTree::Destroy()
+{
+  if( m_owned_buffer )
+    onfree(m_owned_buffer);
+  m_owned_buffer = 0;
+  m_header = 0;
+  m_nodes = 0;
+  m_buffer_size = 0;
+}
+
+unsigned int CRhCmnPackedRTree::PackedSizeOf(const ON_RTree& tree)
+{
+  ON__UINT64 node_count = (ON__UINT64)RhCmnRTreeNodeCount(tree.Root());
+  ON__UINT64 sz = sizeof(CRhCmnPackedRTreeHeader) + node_count*sizeof(CRhCmnPackedRTreeNode);
+  if( sz > 0xFFFFFFFF )
+    return 0;
+  return (unsigned int)sz;
+}
+
+bool CRhCmnPackedRTree::Pack(const ON_RTree& tree, unsigned int buffer_size, void* buffer)
+{
+  const unsigned int sizeof_packed = PackedSizeOf(tree);
+  if( 0 == sizeof_packed || buffer_size < sizeof_packed || 0 == buffer )
+    return false;
+
+  memset(buffer, 0, sizeof_packed);
+  CRhCmnPackedRTreeHeader* header = (CRhCmnPackedRTreeHeader*)buffer;
+  CRhCmnPackedRTreeNode* nodes = (CRhCmnPackedRTreeNode*)(header+1);
+  header->m_signature = RHCMN_PACKED_RTREE_SIGNATURE;
+  header->m_version = RHCMN_PACKED_RTREE_VERSION;
+  header->m_sizeof_node = sizeof(CRhCmnPackedRTreeNode);
+  header->m_node_count = (sizeof_packed - sizeof(CRhCmnPackedRTreeHeader))/sizeof(CRhCmnPackedRTreeNode);
+  header->m_bbox.m_min[0] = header->m_bbox.m_min[1] = header->m_bbox.m_min[2] = 1.0;
+  header->m_bbox.m_max[0] = header->m_bbox.m_max[1] = header->m_bbox.m_max[2] = -1.0;
+
+  // breadth first walk - a child's index is its position in the queue
+  ON_SimpleArray<const ON_RTreeNode*> queue(header->m_node_count);
+  const ON_RTreeNode* root = tree.Root();
+  if( root )
+    queue.Append(root);
+  for( int i=0; i<queue.Count(); i++ )
+  {
+    const ON_RTreeNode* node = queue[i];
+    CRhCmnPackedRTreeNode& packed = nodes[i];
+    packed.m_level = node->m_level;
+    packed.m_count = node->m_count;
+    for( int j=0; j<node->m_count; j++ )
+    {
+      packed.m_branch[j].m_rect = node->m_branch[j].m_rect;
+      if( node->IsInternalNode() )
+      {
+        packed.m_branch[j].m_child_or_id = queue.Count();
+        queue.Append(node->m_branch[j].m_child);
+      }
+      else
+      {
+        packed.m_branch[j].m_child_or_id = (ON__INT64)node->m_branch[j].m_id;
+        header->m_element_count++;
+      }
+    }
+  }
+
+  if( header->m_node_count > 0 )
+  {
+    for( int j=0; j<nodes[0].m_count; j++ )
+    {
+      const ON_RTreeBBox& r = nodes[0].m_branch[j].m_rect;
+      for( int k=0; k<3; k++ )
+      {
+        if( 0 == j || r.m_min[k] < header->m_bbox.m_min[k] )
+          header->m_bbox.m_min[k] = r.m_min[k];
+        if( 0 == j || r.m_max[k] > header->m_bbox.m_max[k] )
+          header->m_bbox.m_max[k] = r.m_max[k];
+      }
+    }
+  }
+  header->m_node_crc = ON_CRC32(0, header->m_node_count*sizeof(CRhCmnPackedRTreeNode), nodes);
+  return true;
+}
+
+bool CRhCmnPackedRTree::WritePacked(const ON_RTree& tree, ON_BinaryArchive& archive)
+{
+  bool rc = false;
+  unsigned int sz = PackedSizeOf(tree);
+  void* buffer = sz > 0 ? onmalloc(sz) : 0;
+  if( buffer )
+  {
+    CRhCmnPackedRTree packed;
+    if( Pack(tree, sz, buffer) && packed.SetBuffer(buffer, sz, true, false) )
+      rc = packed.Write(archive);
+    else
+      onfree(buffer);
+  }
+  return rc;
+}
+
+bool CRhCmnPackedRTree::Attach(const void* buffer, unsigned int buffer_size, bool bCopy, bool bVerifyCrc)
+{
+  Destroy();
+  if( 0 == buffer || buffer_size < sizeof(CRhCmnPackedRTreeHeader) )
+    return false;
+
+  if( !bCopy && 0 == (((ON__UINT_PTR)buffer) % 8) )
+    return SetBuffer(buffer, buffer_size, false, bVerifyCrc);
+
+  void* copy = onmalloc(buffer_size);
+  if( 0 == copy )
+    return false;
+  memcpy(copy, buffer, buffer_size);
+  bool rc = SetBuffer(copy, buffer_size, true, bVerifyCrc);
+  if( !rc )
+    onfree(copy);
+  return rc;
+}
+
+bool CRhCmnPackedRTree::SetBuffer(const void* buffer, unsigned int buffer_size, bool bOwnsBuffer, bool bVerifyCrc)
+{
+  Destroy();
+  const CRhCmnPackedRTreeHeader* header = (const CRhCmnPackedRTreeHeader*)buffer;
+  if( 0 == header || buffer_size < sizeof(CRhCmnPackedRTreeHeader) )
+    return false;
+  if( RHCMN_PACKED_RTREE_SIGNATURE != header->m_signature ||
+      RHCMN_PACKED_RTREE_VERSION != header->m_version ||
+      sizeof(CRhCmnPackedRTreeNode) != header->m_sizeof_node )
+    return false;
+  ON__UINT64 sz = sizeof(CRhCmnPackedRTreeHeader) + ((ON__UINT64)header->m_node_count)*sizeof(CRhCmnPackedRTreeNode);
+  if( sz > buffer_size )
+    return false;
+  const CRhCmnPackedRTreeNode* nodes = (const CRhCmnPackedRTreeNode*)(header+1);
+  if( bVerifyCrc && header->m_node_crc != ON_CRC32(0, header->m_node_count*sizeof(CRhCmnPackedRTreeNode), nodes) )
+    return false;
+
+  m_header = header;
+  m_nodes = nodes;
+  m_buffer_size = (unsigned int)sz;
+  if( bOwnsBuffer )
+    m_owned_buffer = const_cast<void*>(buffer);
+  return true;
+}
+
+bool CRhCmnPackedRTree::Write(ON_BinaryArchive& archive) const
+{
+  if( !archive.BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK, 1, 0) )
+    return false;
+  bool rc = archive.WriteInt(m_buffer_size);
+  if( rc && m_buffer_size > 0 )
+    rc = archive.WriteByte(m_buffer_size, m_header);
+  if( !archive.EndWrite3dmChunk() )
+    rc = false;
+  return rc;
+}
+
+bool CRhCmnPackedRTree::Read(ON_BinaryArchive& archive)
+{
+  Destroy();
+  int major_version = 0;
+  int minor_version = 0;
+  if( !archive.BeginRead3dmChunk(TCODE_ANONYMOUS_CHUNK, &major_version, &minor_version) )
+    return false;
+
+  bool rc = false;
+  for(;;)
+  {
+    if( 1 != major_version )
+      break;
+    unsigned int sz = 0;
+    if( !archive.ReadInt(&sz) )
+      break;
+    if( 0 == sz )
+    {
+      rc = true;
+      break;
+    }
+    void* buffer = onmalloc(sz);
+    if( 0 == buffer )
+      break;
+    if( archive.ReadByte(sz, buffer) )
+      rc = SetBuffer(buffer, sz, true, true);
+    if( !rc )
+      onfree(buffer);
+    break;
+  }
+  if( !archive.EndRead3dmChunk() )
+    rc = false;
+  return rc;
+}
+
+bool CRhCmnPackedRTree::SearchHelper(int node_index, int level, const ON_RTreeBBox* a_rect, RHCMN_RTREE_RESULTPROC resultCallback, void* a_context) const
+{
+  // index and level are checked so a damaged block cannot send us
+  // out of bounds or around in circles
+  if( node_index < 0 || node_index >= (int)m_header->m_node_count )
+    return false;
+  const CRhCmnPackedRTreeNode& node = m_nodes[node_index];
+  if( node.m_level != level || node.m_count < 0 || node.m_count > ON_RTree_MAX_NODE_COUNT )
+    return false;
+
+  for( int i=0; i<node.m_count; i++ )
+  {
+    const CRhCmnPackedRTreeBranch& branch = node.m_branch[i];
+    if( !RhCmnRTreeBBoxOverlap(a_rect, &branch.m_rect) )
+      continue;
+    if( node.m_level > 0 )
+    {
+      if( !SearchHelper((int)branch.m_child_or_id, level-1, a_rect, resultCallback, a_context) )
+        return false;
+    }
+    else if( !resultCallback(a_context, (ON__INT_PTR)branch.m_child_or_id) )
+      return false;
+  }
+  return true;
+}
+
+bool CRhCmnPackedRTree::SearchHelper(int node_index, int level, const ON_RTreeSphere* a_sphere, RHCMN_RTREE_RESULTPROC resultCallback, void* a_context) const
+{
+  if( node_index < 0 || node_index >= (int)m_header->m_node_count )
+    return false;
+  const CRhCmnPackedRTreeNode& node = m_nodes[node_index];
+  if( node.m_level != level || node.m_count < 0 || node.m_count > ON_RTree_MAX_NODE_COUNT )
+    return false;
+
+  for( int i=0; i<node.m_count; i++ )
+  {
+    const CRhCmnPackedRTreeBranch& branch = node.m_branch[i];
+    if( !RhCmnRTreeBBoxOverlapSphere(&branch.m_rect, a_sphere) )
+      continue;
+    if( node.m_level > 0 )
+    {
+      if( !SearchHelper((int)branch.m_child_or_id, level-1, a_sphere, resultCallback, a_context) )
+        return false;
+    }
+    else if( !resultCallback(a_context, (ON__INT_PTR)branch.m_child_or_id) )
+      return false;
+  }
+  return true;
+}
+
+bool CRhCmnPackedRTree::Search(const ON_RTreeBBox* a_rect, RHCMN_RTREE_RESULTPROC resultCallback, void* a_context) const
+{
+  if( 0 == a_rect || 0 == resultCallback )
+    return false;
+  if( 0 == m_header || 0 == m_header->m_node_count )
+    return true;
+  return SearchHelper(0, m_nodes[0].m_level, a_rect, resultCallback, a_context);
+}
+
+bool CRhCmnPackedRTree::Search(const ON_RTreeSphere* a_sphere, RHCMN_RTREE_RESULTPROC resultCallback, void* a_context) const
+{
+  if( 0 == a_sphere || 0 == resultCallback )
+    return false;
+  if( 0 == m_header || 0 == m_header->m_node_count )
+    return true;
+  return SearchHelper(0, m_nodes[0].m_level, a_sphere, resultCallback, a_context);
+}
+
+int CRhCmnPackedRTree::ElementCount() const
+{
+  return m_header ? (int)m_header->m_element_count : 0;
+}
+
+ON_BoundingBox CRhCmnPackedRTree::BoundingBox() const
+{
+  ON_BoundingBox bbox;
+  if( m_header )
+  {
+    bbox.m_min = ON_3dPoint(m_header->m_bbox.m_min);
+    bbox.m_max = ON_3dPoint(m_header->m_bbox.m_max);
+  }
+  return bbox;
+}
+
+unsigned int CRhCmnPackedRTree::SizeOf() const
+{
+  return m_buffer_size;
+}
+
+RH_C_FUNCTION unsigned int ON_RTree_PackedSizeOf(const ON_RTree* pConstTree)
+{
+  unsigned int rc = 0;
+  if( pConstTree )
+    rc = CRhCmnPackedRTree::PackedSizeOf(*pConstTree);
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_RTree_Pack(const ON_RTree* pConstTree, unsigned int buffer_size, /*ARRAY*/unsigned char* buffer)
+{
+  bool rc = false;
+  if( pConstTree && buffer )
+    rc = CRhCmnPackedRTree::Pack(*pConstTree, buffer_size, buffer);
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_RTree_WritePacked(const ON_RTree* pConstTree, ON_BinaryArchive* pArchive)
+{
+  bool rc = false;
+  if( pConstTree && pArchive )
+    rc = CRhCmnPackedRTree::WritePacked(*pConstTree, *pArchive);
+  return rc;
+}
+
+RH_C_FUNCTION CRhCmnPackedRTree* ON_PackedRTree_New(const void* buffer, unsigned int buffer_size, bool copy, bool verifyCrc)
+{
+  CRhCmnPackedRTree* rc = new CRhCmnPackedRTree();
+  if( !rc->Attach(buffer, buffer_size, copy, verifyCrc) )
+  {
+    delete rc;
+    rc = 0;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION CRhCmnPackedRTree* ON_PackedRTree_Read(ON_BinaryArchive* pArchive)
+{
+  CRhCmnPackedRTree* rc = 0;
+  if( pArchive )
+  {
+    rc = new CRhCmnPackedRTree();
+    if( !rc->Read(*pArchive) )
+    {
+      delete rc;
+      rc = 0;
+    }
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_PackedRTree_Write(const CRhCmnPackedRTree* pConstPackedTree, ON_BinaryArchive* pArchive)
+{
+  bool rc = false;
+  if( pConstPackedTree && pArchive )
+    rc = pConstPackedTree->Write(*pArchive);
+  return rc;
+}
+
+RH_C_FUNCTION void ON_PackedRTree_Delete(CRhCmnPackedRTree* pPackedTree)
+{
+  if( pPackedTree )
+    delete pPackedTree;
+}
+
+RH_C_FUNCTION int ON_PackedRTree_ElementCount(const CRhCmnPackedRTree* pConstPackedTree)
+{
+  int rc = 0;
+  if( pConstPackedTree )
+    rc = pConstPackedTree->ElementCount();
+  return rc;
+}
+
+RH_C_FUNCTION unsigned int ON_PackedRTree_SizeOf(const CRhCmnPackedRTree* pConstPackedTree)
+{
+  unsigned int rc = 0;
+  if( pConstPackedTree )
+    rc = pConstPackedTree->SizeOf();
+  return rc;
+}
+
+RH_C_FUNCTION void ON_PackedRTree_BoundingBox(const CRhCmnPackedRTree* pConstPackedTree, ON_BoundingBox* bbox)
+{
+  if( pConstPackedTree && bbox )
+    *bbox = pConstPackedTree->BoundingBox();
+}
+
+RH_C_FUNCTION bool ON_PackedRTree_Search(const CRhCmnPackedRTree* pConstPackedTree, ON_3DPOINT_STRUCT pt0, ON_3DPOINT_STRUCT pt1, int serial_number, RTREESEARCHPROC searchCB)
+{
+  bool rc = false;
+  if( pConstPackedTree && searchCB )
+  {
+    ON_RTreeSearchContext context;
+    context.m_mode = 1;
+    context.m_serial_number = serial_number;
+    ON_BoundingBox bbox(ON_3dPoint(pt0.val), ON_3dPoint(pt1.val));
+    context.m_bbox.m_min[0] = bbox.m_min[0];
+    context.m_bbox.m_min[1] = bbox.m_min[1];
+    context.m_bbox.m_min[2] = bbox.m_min[2];
+    context.m_bbox.m_max[0] = bbox.m_max[0];
+    context.m_bbox.m_max[1] = bbox.m_max[1];
+    context.m_bbox.m_max[2] = bbox.m_max[2];
+    g_theRTreeSearcher = searchCB;
+    rc = pConstPackedTree->Search(&(context.m_bbox), RhCmnTreeSearch1, (void*)(&context));
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_PackedRTree_SearchSphere(const CRhCmnPackedRTree* pConstPackedTree, ON_3DPOINT_STRUCT center, double radius, int serial_number, RTREESEARCHPROC searchCB)
+{
+  bool rc = false;
+  if( pConstPackedTree && searchCB )
+  {
+    ON_RTreeSearchContext context;
+    context.m_mode = 2;
+    context.m_serial_number = serial_number;
+    context.m_sphere.m_point[0] = center.val[0];
+    context.m_sphere.m_point[1] = center.val[1];
+    context.m_sphere.m_point[2] = center.val[2];
+    context.m_sphere.m_radius = radius;
+    g_theRTreeSearcher = searchCB;
+    rc = pConstPackedTree->Search(&(context.m_sphere), RhCmnTreeSearch1, (void*)(&context));
+  }
+  return rc;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// RTree element id index
+//
+// Maps element ids to the leaf branch that holds them so elements can be
+// removed or moved without a search. Moving an element changes its leaf
+// rectangle in place and refits the ancestors bottom up; the tree structure
+// is not touched, so the index stays valid. Anything that changes the
+// structure (insert, remove, remove all) must call Invalidate() and the
+// index is rebuilt on the next lookup.
+//
+// ON_RTree splits nodes on insert and reinserts whole branches when a
+// remove leaves a node underfull, and neither reports which leaves moved,
+// so the index can not be patched after a structural change. A rebuild
+// walks every node and sorts every leaf, O(n log n) for n elements.
+// Remove() therefore takes many ids and looks them all up before the first
+// element goes, so a batch pays for one rebuild instead of one per element.
+//
+// Refitting never splits or rebalances nodes. Trees whose elements move far
+// from where they were inserted gradually answer queries more slowly and
+// should be rebuilt from time to time.
+
+class CRhCmnRTreeIdIndex
+{
+public:
+  CRhCmnRTreeIdIndex();
+
+  void Invalidate();
+
+  // Changes the boxes of the elements with the given ids and refits the
+  // tree. Returns the number of elements that were found and updated.
+  int Update(ON_RTree& tree, int count, const ON__INT64* ids, const ON_BoundingBox* boxes);
+
+  // Removes the elements with the given ids. Returns the number of elements
+  // that were removed.
+  int Remove(ON_RTree& tree, int count, const ON__INT64* ids);
+
+private:
+  struct CNodeRecord
+  {
+    ON_RTreeNode* m_node;
+    int m_parent;        // index of parent record, -1 for the root
+    int m_parent_branch; // index of this node in m_parent's branch list
+  };
+  struct CLeafEntry
+  {
+    ON__INT_PTR m_id;
+    int m_record;        // index of the leaf node record
+    int m_branch;        // index of the element in the leaf node's branch list
+  };
+
+  bool Build(ON_RTree& tree);
+  const CLeafEntry* Find(ON__INT_PTR id) const;
+  void AddNode(ON_RTreeNode* node, int parent, int parent_branch);
+
+  const ON_RTree* m_tree;
+  bool m_bValid;
+  ON_SimpleArray<CNodeRecord> m_records;
+  ON_SimpleArray<CLeafEntry> m_leaves; // sorted by id
+};
+
+CRhCmnRTreeIdIndex::CRhCmnRTreeIdIndex()
+: m_tree(0)
+, m_bValid(false)
+{
+}
+
+void CRhCmnRTreeIdIndex::Invalidate()
+{
+  m_bValid = false;
+}
+
+static int CompareRTreeLeafEntryId(const void* a, const void* b)
+{
+  ON__INT_PTR ida = *((const ON__INT_PTR*)a);
+  ON__INT_PTR idb = *((const ON__INT_PTR*)b);
+  if( ida < idb )
+    return -1;
+  if( ida > idb )
+    return 1;
+  return 0;
+}
+
+void CRhCmnRTreeIdIndex::AddNode(ON_RTreeNode* node, int parent, int parent_branch)
+{
+  const int record_index = m_records.Count();
+  CNodeRecord& record = m_records.AppendNew();
+  record.m_node = node;
+  record.m_parent = parent;
+  record.m_parent_branch = parent_branch;
+  for( int i=0; i<node->m_count; i++ )
+  {
+    if( node->IsInternalNode() )
+      AddNode(node->m_branch[i].m_child, record_index, i);
+    else
+    {
+      CLeafEntry& leaf = m_leaves.AppendNew();
+      leaf.m_id = node->m_branch[i].m_id;
+      leaf.m_record = record_index;
+      leaf.m_branch = i;
+    }
+  }
+}
+
+bool CRhCmnRTreeIdIndex::Build(ON_RTree& tree)
+{
+  if( m_bValid && m_tree == &tree )
+    return true;
+  m_records.SetCount(0);
+  m_leaves.SetCount(0);
+  m_tree = &tree;
+  // The index edits node rectangles in place. ON_RTree only hands out a
+  // const root, but its nodes live in the tree's own writable memory pool.
+  ON_RTreeNode* root = const_cast<ON_RTreeNode*>(tree.Root());
+  if( root )
+    AddNode(root, -1, -1);
+  // m_id is the first member of CLeafEntry
+  ON_qsort(m_leaves.Array(), m_leaves.Count(), sizeof(CLeafEntry), CompareRTreeLeafEntryId);
+  m_bValid = true;
+  return true;
+}
+
+const CRhCmnRTreeIdIndex::CLeafEntry* CRhCmnRTreeIdIndex::Find(ON__INT_PTR id) const
+{
+  int i0 = 0;
+  int i1 = m_leaves.Count();
+  while( i0 < i1 )
+  {
+    int i = (i0+i1)/2;
+    ON__INT_PTR leaf_id = m_leaves[i].m_id;
+    if( id < leaf_id )
+      i1 = i;
+    else if( id > leaf_id )
+      i0 = i+1;
+    else
+      return m_leaves.At(i);
+  }
+  return 0;
+}
+
+int CRhCmnRTreeIdIndex::Update(ON_RTree& tree, int count, const ON__INT64* ids, const ON_BoundingBox* boxes)
+{
+  if( count < 1 || 0 == ids || 0 == boxes || !Build(tree) )
+    return 0;
+
+  // Set the leaf rectangles and collect the nodes that need refitting,
+  // bucketed by level so every node is refit once, after its children.
+  int root_level = m_records.Count() > 0 ? m_records[0].m_node->m_level : 0;
+  ON_ClassArray< ON_SimpleArray<int> > dirty(root_level+1);
+  for( int level=0; level<=root_level; level++ )
+    dirty.AppendNew();
+  ON_SimpleArray<bool> is_dirty(m_records.Count());
+  is_dirty.SetCount(m_records.Count());
+  is_dirty.Zero();
+
+  int rc = 0;
+  for( int i=0; i<count; i++ )
+  {
+    const CLeafEntry* leaf = Find((ON__INT_PTR)ids[i]);
+    if( 0 == leaf )
+      continue;
+    ON_RTreeBBox& rect = m_records[leaf->m_record].m_node->m_branch[leaf->m_branch].m_rect;
+    const ON_BoundingBox& box = boxes[i];
+    for( int k=0; k<3; k++ )
+    {
+      rect.m_min[k] = box.m_min[k] < box.m_max[k] ? box.m_min[k] : box.m_max[k];
+      rect.m_max[k] = box.m_min[k] < box.m_max[k] ? box.m_max[k] : box.m_min[k];
+    }
+    if( !is_dirty[leaf->m_record] )
+    {
+      is_dirty[leaf->m_record] = true;
+      dirty[0].Append(leaf->m_record);
+    }
+    rc++;
+  }
+
+  for( int level=0; level<=root_level; level++ )
+  {
+    const ON_SimpleArray<int>& records = dirty[level];
+    for( int i=0; i<records.Count(); i++ )
+    {
+      const CNodeRecord& record = m_records[records[i]];
+      if( record.m_parent < 0 || record.m_node->m_count < 1 )
+        continue;
+      ON_RTreeBBox cover = record.m_node->m_branch[0].m_rect;
+      for( int j=1; j<record.m_node->m_count; j++ )
+      {
+        const ON_RTreeBBox& r = record.m_node->m_branch[j].m_rect;
+        for( int k=0; k<3; k++ )
+        {
+          if( r.m_min[k] < cover.m_min[k] )
+            cover.m_min[k] = r.m_min[k];
+          if( r.m_max[k] > cover.m_max[k] )
+            cover.m_max[k] = r.m_max[k];
+        }
+      }
+      ON_RTreeBBox& parent_rect = m_records[record.m_parent].m_node->m_branch[record.m_parent_branch].m_rect;
+      if( 0 == memcmp(&parent_rect, &cover, sizeof(cover)) )
+        continue;
+      parent_rect = cover;
+      if( !is_dirty[record.m_parent] && level < root_level )
+      {
+        is_dirty[record.m_parent] = true;
+        dirty[level+1].Append(record.m_parent);
+      }
+    }
+  }
+  return rc;
+}
+
+int CRhCmnRTreeIdIndex::Remove(ON_RTree& tree, int count, const ON__INT64* ids)
+{
+  if( count < 1 || 0 == ids || !Build(tree) )
+    return 0;
+
+  // Removing restructures the tree, so look up every rectangle before
+  // removing anything.
+  ON_SimpleArray<ON_RTreeLeaf> doomed(count);
+  for( int i=0; i<count; i++ )
+  {
+    const CLeafEntry* leaf = Find((ON__INT_PTR)ids[i]);
+    if( 0 == leaf )
+      continue;
+    ON_RTreeLeaf& d = doomed.AppendNew();
+    d.m_rect = m_records[leaf->m_record].m_node->m_branch[leaf->m_branch].m_rect;
+    d.m_id = leaf->m_id;
+  }
+  Invalidate();
+
+  int rc = 0;
+  for( int i=0; i<doomed.Count(); i++ )
+  {
+    if( tree.Remove(doomed[i].m_rect.m_min, doomed[i].m_rect.m_max, (void*)doomed[i].m_id) )
+      rc++;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION CRhCmnRTreeIdIndex* ON_RTreeIdIndex_New()
+{
+  return new CRhCmnRTreeIdIndex();
+}
+
+RH_C_FUNCTION void ON_RTreeIdIndex_Delete(CRhCmnRTreeIdIndex* pIndex)
+{
+  if( pIndex )
+    delete pIndex;
+}
+
+RH_C_FUNCTION void ON_RTreeIdIndex_Invalidate(CRhCmnRTreeIdIndex* pIndex)
+{
+  if( pIndex )
+    pIndex->Invalidate();
+}
+
+RH_C_FUNCTION int ON_RTree_UpdateById(ON_RTree* pTree, CRhCmnRTreeIdIndex* pIndex, int count, /*ARRAY*/const ON__INT64* ids, /*ARRAY*/const ON_BoundingBox* boxes)
+{
+  int rc = 0;
+  if( pTree && pIndex )
+    rc = pIndex->Update(*pTree, count, ids, boxes);
+  return rc;
+}
+
+RH_C_FUNCTION int ON_RTree_RemoveById(ON_RTree* pTree, CRhCmnRTreeIdIndex* pIndex, int count, /*ARRAY*/const ON__INT64* ids)
+{
+  int rc = 0;
+  if( pTree && pIndex )
+    rc = pIndex->Remove(*pTree, count, ids);
+  return rc;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Parallel tree/tree overlap search
+//
+// The top of the two trees is expanded breadth first into a list of node
+// pairs whose boxes overlap. The pairs are then searched on worker threads
+// and every thread collects its results in its own array. No callbacks are
+// made while the workers run.
+
+class CRhCmnRTreePairSearch
+{
+public:
+  CRhCmnRTreePairSearch(double tolerance, int max_pairs, int thread_count);
+
+  bool Search(const ON_RTree& treeA, const ON_RTree& treeB);
+  void GetResults(ON_SimpleArray<int>& pairs) const;
+  bool ReachedLimit() const { return 0 != m_full; }
+
+private:
+  struct CTask
+  {
+    const ON_RTreeNode* m_a;
+    const ON_RTreeNode* m_b;
+  };
+
+  bool Overlap(const ON_RTreeBBox& a, const ON_RTreeBBox& b) const;
+  bool AddPair(ON_SimpleArray<ON_2dex>& results, ON__INT_PTR a_id, ON__INT_PTR b_id);
+  bool SearchNodeNode(const ON_RTreeNode* a, const ON_RTreeNode* b, ON_SimpleArray<ON_2dex>& results);
+  bool SearchLeafNode(const ON_RTreeBranch& a, const ON_RTreeNode* b, ON_SimpleArray<ON_2dex>& results);
+  bool SearchNodeLeaf(const ON_RTreeNode* a, const ON_RTreeBranch& b, ON_SimpleArray<ON_2dex>& results);
+  static bool SearchTask(void* context, int index, int thread_index);
+
+  const double m_tolerance;
+  const int m_max_pairs; // < 1 means no limit
+  const int m_thread_count;
+  volatile int m_pair_count;
+  volatile int m_full;
+  ON_SimpleArray<CTask> m_tasks;
+  ON_ClassArray< ON_SimpleArray<ON_2dex> > m_results; // one array per thread
+};
+
+CRhCmnRTreePairSearch::CRhCmnRTreePairSearch(double tolerance, int max_pairs, int thread_count)
+: m_tolerance(ON_IsValid(tolerance) && tolerance > 0.0 ? tolerance : 0.0)
+, m_max_pairs(max_pairs)
+, m_thread_count(thread_count > 0 ? thread_count : RhCmnMaxThreadCount())
+, m_pair_count(0)
+, m_full(0)
+{
+}
+
+bool CRhCmnRTreePairSearch::Overlap(const ON_RTreeBBox& a, const ON_RTreeBBox& b) const
+{
+  return ( a.m_min[0] - m_tolerance <= b.m_max[0] && b.m_min[0] - m_tolerance <= a.m_max[0] &&
+           a.m_min[1] - m_tolerance <= b.m_max[1] && b.m_min[1] - m_tolerance <= a.m_max[1] &&
+           a.m_min[2] - m_tolerance <= b.m_max[2] && b.m_min[2] - m_tolerance <= a.m_max[2] );
+}
+
+bool CRhCmnRTreePairSearch::AddPair(ON_SimpleArray<ON_2dex>& results, ON__INT_PTR a_id, ON__INT_PTR b_id)
+{
+  if( m_max_pairs > 0 && RhCmnAtomicAdd(&m_pair_count, 1) > m_max_pairs )
+  {
+    m_full = 1;
+    return false;
+  }
+  ON_2dex& pair = results.AppendNew();
+  pair.i = (int)a_id;
+  pair.j = (int)b_id;
+  return true;
+}
+
+bool CRhCmnRTreePairSearch::SearchNodeNode(const ON_RTreeNode* a, const ON_RTreeNode* b, ON_SimpleArray<ON_2dex>& results)
+{
+  for( int i=0; i<a->m_count; i++ )
+  {
+    const ON_RTreeBranch& branch_a = a->m_branch[i];
+    for( int j=0; j<b->m_count; j++ )
+    {
+      const ON_RTreeBranch& branch_b = b->m_branch[j];
+      if( !Overlap(branch_a.m_rect, branch_b.m_rect) )
+        continue;
+      bool rc;
+      if( a->IsInternalNode() )
+      {
+        if( b->IsInternalNode() )
+          rc = SearchNodeNode(branch_a.m_child, branch_b.m_child, results);
+        else
+          rc = SearchNodeLeaf(branch_a.m_child, branch_b, results);
+      }
+      else
+      {
+        if( b->IsInternalNode() )
+          rc = SearchLeafNode(branch_a, branch_b.m_child, results);
+        else
+          rc = AddPair(results, branch_a.m_id, branch_b.m_id);
+      }
+      if( !rc )
+        return false;
+    }
+  }
+  return (0 == m_full);
+}
+
+bool CRhCmnRTreePairSearch::SearchLeafNode(const ON_RTreeBranch& a, const ON_RTreeNode* b, ON_SimpleArray<ON_2dex>& results)
+{
+  for( int j=0; j<b->m_count; j++ )
+  {
+    const ON_RTreeBranch& branch_b = b->m_branch[j];
+    if( !Overlap(a.m_rect, branch_b.m_rect) )
+      continue;
+    bool rc = b->IsInternalNode()
+            ? SearchLeafNode(a, branch_b.m_child, results)
+            : AddPair(results, a.m_id, branch_b.m_id);
+    if( !rc )
+      return false;
+  }
+  return true;
+}
+
+bool CRhCmnRTreePairSearch::SearchNodeLeaf(const ON_RTreeNode* a, const ON_RTreeBranch& b, ON_SimpleArray<ON_2dex>& results)
+{
+  for( int i=0; i<a->m_count; i++ )
+  {
+    const ON_RTreeBranch& branch_a = a->m_branch[i];
+    if( !Overlap(branch_a.m_rect, b.m_rect) )
+      continue;
+    bool rc = a->IsInternalNode()
+            ? SearchNodeLeaf(branch_a.m_child, b, results)
+            : AddPair(results, branch_a.m_id, b.m_id);
+    if( !rc )
+      return false;
+  }
+  return true;
+}
+
+bool CRhCmnRTreePairSearch::SearchTask(void* context, int index, int thread_index)
+{
+  CRhCmnRTreePairSearch* search = (CRhCmnRTreePairSearch*)context;
+  const CTask& task = search->m_tasks[index];
+  return search->SearchNodeNode(task.m_a, task.m_b, search->m_results[thread_index]);
+}
+
+bool CRhCmnRTreePairSearch::Search(const ON_RTree& treeA, const ON_RTree& treeB)
+{
+  m_tasks.SetCount(0);
+  m_results.SetCount(0);
+  const ON_RTreeNode* rootA = treeA.Root();
+  const ON_RTreeNode* rootB = treeB.Root();
+  if( 0 == rootA || 0 == rootB || rootA->m_count < 1 || rootB->m_count < 1 )
+    return true;
+
+  // Expand pairs of internal nodes until there is enough work to keep
+  // every thread busy or nothing is left to expand.
+  const int task_target = m_thread_count*16;
+  CTask& root_task = m_tasks.AppendNew();
+  root_task.m_a = rootA;
+  root_task.m_b = rootB;
+  ON_SimpleArray<CTask> next;
+  while( m_tasks.Count() < task_target )
+  {
+    bool bExpanded = false;
+    next.SetCount(0);
+    for( int t=0; t<m_tasks.Count(); t++ )
+    {
+      const CTask task = m_tasks[t];
+      if( task.m_a->IsLeaf() || task.m_b->IsLeaf() )
+      {
+        next.Append(task);
+        continue;
+      }
+      bExpanded = true;
+      for( int i=0; i<task.m_a->m_count; i++ )
+      {
+        for( int j=0; j<task.m_b->m_count; j++ )
+        {
+          if( !Overlap(task.m_a->m_branch[i].m_rect, task.m_b->m_branch[j].m_rect) )
+            continue;
+          CTask& child = next.AppendNew();
+          child.m_a = task.m_a->m_branch[i].m_child;
+          child.m_b = task.m_b->m_branch[j].m_child;
+        }
+      }
+    }
+    m_tasks = next;
+    if( !bExpanded )
+      break;
+  }
+
+  m_results.Reserve(m_thread_count);
+  for( int i=0; i<m_thread_count; i++ )
+    m_results.AppendNew();
+  RhCmnParallelFor(m_thread_count, m_tasks.Count(), SearchTask, this);
+  return (0 == m_full);
+}
+
+void CRhCmnRTreePairSearch::GetResults(ON_SimpleArray<int>& pairs) const
+{
+  int count = 0;
+  for( int i=0; i<m_results.Count(); i++ )
+    count += m_results[i].Count();
+  pairs.Reserve(pairs.Count() + 2*count);
+  for( int i=0; i<m_results.Count(); i++ )
+    pairs.Append(2*m_results[i].Count(), (const int*)m_results[i].Array());
+}
+
+RH_C_FUNCTION int ON_RTree_SearchOverlapsParallel(const ON_RTree* pConstTreeA, const ON_RTree* pConstTreeB, double tolerance, int maxPairs, int threadCount, ON_SimpleArray<int>* pairs, bool* reachedLimit)
+{
+  int rc = 0;
+  if( pConstTreeA && pConstTreeB && pairs )
+  {
+    CRhCmnRTreePairSearch search(tolerance, maxPairs, threadCount);
+    search.Search(*pConstTreeA, *pConstTreeB);
+    pairs->SetCount(0);
+    search.GetResults(*pairs);
+    rc = pairs->Count()/2;
+    if( reachedLimit )
+      *reachedLimit = search.ReachedLimit();
+  }
+  return rc;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Ray and segment search
+//
+// Points on the ray are from + t*dir for m_t0 <= t <= m_t1. Boxes are
+// clipped with the slab test and visited in order of the parameter where
+// the ray enters them, so the first element reported is the closest one.
+// The result callback may lower the limit, typically to the parameter of
+// an exact hit, and everything behind the limit is skipped.
+
+CRhCmnRTreeRaySearch::CRhCmnRTreeRaySearch()
+: m_t0(0.0)
+, m_t1(0.0)
+{
+  for( int i=0; i<3; i++ )
+    m_from[i] = m_dir[i] = m_inv[i] = 0.0;
+}
+
+void CRhCmnRTreeRaySearch::SetRay(const double from[3], const double dir[3], double t0, double t1)
+{
+  for( int i=0; i<3; i++ )
+  {
+    m_from[i] = from[i];
+    m_dir[i] = dir[i];
+    m_inv[i] = (0.0 != dir[i]) ? 1.0/dir[i] : 0.0;
+  }
+  m_t0 = t0;
+  m_t1 = t1;
+}
+
+bool CRhCmnRTreeRaySearch::Clip(const ON_RTreeBBox& box, double* t) const
+{
+  double tmin = m_t0;
+  double tmax = m_t1;
+  for( int i=0; i<3; i++ )
+  {
+    if( 0.0 == m_dir[i] )
+    {
+      if( m_from[i] < box.m_min[i] || m_from[i] > box.m_max[i] )
+        return false;
+      continue;
+    }
+    double a = (box.m_min[i] - m_from[i])*m_inv[i];
+    double b = (box.m_max[i] - m_from[i])*m_inv[i];
+    if( a > b )
+    {
+      double x = a; a = b; b = x;
+    }
+    if( a > tmin )
+      tmin = a;
+    if( b < tmax )
+      tmax = b;
+    if( tmin > tmax )
+      return false;
+  }
+  *t = tmin;
+  return true;
+}
+
+void CRhCmnRTreeRaySearch::Push(double t, const ON_RTreeNode* node, const ON_RTreeBranch* leaf)
+{
+  int i = m_heap.Count();
+  m_heap.AppendNew();
+  CHeapItem* heap = m_heap.Array();
+  while( i > 0 )
+  {
+    int parent = (i-1)/2;
+    if( heap[parent].m_t <= t )
+      break;
+    heap[i] = heap[parent];
+    i = parent;
+  }
+  heap[i].m_t = t;
+  heap[i].m_node = node;
+  heap[i].m_leaf = leaf;
+}
+
+CRhCmnRTreeRaySearch::CHeapItem CRhCmnRTreeRaySearch::Pop()
+{
+  CHeapItem* heap = m_heap.Array();
+  const CHeapItem top = heap[0];
+  const int count = m_heap.Count()-1;
+  const CHeapItem last = heap[count];
+  m_heap.SetCount(count);
+  int i = 0;
+  for(;;)
+  {
+    int child = 2*i+1;
+    if( child >= count )
+      break;
+    if( child+1 < count && heap[child+1].m_t < heap[child].m_t )
+      child++;
+    if( last.m_t <= heap[child].m_t )
+      break;
+    heap[i] = heap[child];
+    i = child;
+  }
+  if( count > 0 )
+    heap[i] = last;
+  return top;
+}
+
+bool CRhCmnRTreeRaySearch::Search(const ON_RTree& tree, RHCMN_RTREE_RAYRESULTPROC resultCallback, void* context)
+{
+  m_heap.SetCount(0);
+  const ON_RTreeNode* root = tree.Root();
+  if( 0 == root || root->m_count < 1 || 0 == resultCallback || !(m_t0 <= m_t1) )
+    return true;
+
+  Push(m_t0, root, 0);
+  while( m_heap.Count() > 0 )
+  {
+    const CHeapItem item = Pop();
+    if( item.m_t > m_t1 )
+      break; // everything left in the heap is behind the limit
+    if( item.m_node )
+    {
+      const ON_RTreeNode* node = item.m_node;
+      const bool bInternal = node->IsInternalNode();
+      for( int i=0; i<node->m_count; i++ )
+      {
+        double t;
+        if( Clip(node->m_branch[i].m_rect, &t) )
+        {
+          if( bInternal )
+            Push(t, node->m_branch[i].m_child, 0);
+          else
+            Push(t, 0, &node->m_branch[i]);
+        }
+      }
+    }
+    else
+    {
+      double limit = m_t1;
+      if( !resultCallback(context, item.m_leaf->m_id, item.m_t, &limit) )
+        return false;
+      if( limit < m_t1 )
+        m_t1 = limit;
+    }
+  }
+  return true;
+}
+
+bool CRhCmnPackedRTree::SearchRay(CRhCmnRTreeRaySearch& ray, RHCMN_RTREE_RAYRESULTPROC resultCallback, void* a_context) const
+{
+  if( 0 == m_header || 0 == resultCallback )
+    return false;
+  if( m_header->m_node_count < 1 || !(ray.m_t0 <= ray.m_t1) )
+    return true;
+  return SearchRayHelper(0, m_nodes[0].m_level, ray, resultCallback, a_context);
+}
+
+bool CRhCmnPackedRTree::SearchRayHelper(int node_index, int level, CRhCmnRTreeRaySearch& ray, RHCMN_RTREE_RAYRESULTPROC resultCallback, void* a_context) const
+{
+  if( node_index < 0 || node_index >= (int)m_header->m_node_count )
+    return false;
+  const CRhCmnPackedRTreeNode& node = m_nodes[node_index];
+  if( node.m_level != level || node.m_count < 0 || node.m_count > ON_RTree_MAX_NODE_COUNT )
+    return false;
+
+  for( int i=0; i<node.m_count; i++ )
+  {
+    const CRhCmnPackedRTreeBranch& branch = node.m_branch[i];
+    double t;
+    if( !ray.Clip(branch.m_rect, &t) )
+      continue;
+    if( node.m_level > 0 )
+    {
+      if( !SearchRayHelper((int)branch.m_child_or_id, level-1, ray, resultCallback, a_context) )
+        return false;
+    }
+    else
+    {
+      double limit = ray.m_t1;
+      if( !resultCallback(a_context, (ON__INT_PTR)branch.m_child_or_id, t, &limit) )
+        return false;
+      if( limit < ray.m_t1 )
+        ray.m_t1 = limit;
+    }
+  }
+  return true;
+}
+
+static bool RhCmnTreeSearchRay(void* context, ON__INT_PTR a_id, double t, double* limit)
+{
+  bool rc = false;
+  if( g_theRTreeSearcher )
+  {
+    ON_RTreeSearchContext* pContext = (ON_RTreeSearchContext*)(context);
+    pContext->m_ray_t = t;
+    pContext->m_ray_limit = *limit;
+    int cbrc = g_theRTreeSearcher(pContext->m_serial_number, (void*)a_id, 0, pContext);
+    *limit = pContext->m_ray_limit;
+    rc = cbrc?true:false;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_RTree_SearchRay(const ON_RTree* pConstTree, ON_3DPOINT_STRUCT from, ON_3DVECTOR_STRUCT direction, double t0, double t1, int serial_number, RTREESEARCHPROC searchCB)
+{
+  bool rc = false;
+  if( pConstTree && searchCB )
+  {
+    ON_RTreeSearchContext context;
+    context.m_mode = 4;
+    context.m_serial_number = serial_number;
+    context.m_ray_t = t0;
+    context.m_ray_limit = t1;
+    CRhCmnRTreeRaySearch search;
+    search.SetRay(from.val, direction.val, t0, ON_IsValid(t1) ? t1 : ON_DBL_MAX);
+    g_theRTreeSearcher = searchCB;
+    rc = search.Search(*pConstTree, RhCmnTreeSearchRay, (void*)(&context));
+  }
+  return rc;
+}
+
+struct CRhCmnRTreeRayHit
+{
+  int m_id;
+  double m_t;
+};
+
+class CRhCmnRTreeRayBatch
+{
+public:
+  const ON_RTree* m_tree;
+  const ON_Line* m_lines;
+  bool m_bInfinite;
+  int m_max_hits; // < 1 means all hits
+  ON_ClassArray<CRhCmnRTreeRaySearch> m_searches; // one per thread
+  ON_ClassArray< ON_SimpleArray<CRhCmnRTreeRayHit> > m_hits; // one per ray
+
+  static bool SearchRay(void* context, int index, int thread_index);
+  static bool AddHit(void* context, ON__INT_PTR id, double t, double* limit);
+};
+
+bool CRhCmnRTreeRayBatch::AddHit(void* context, ON__INT_PTR id, double t, double* limit)
+{
+  const CRhCmnRTreeRayBatch* batch = ((const CRhCmnRTreeRayBatch**)context)[0];
+  ON_SimpleArray<CRhCmnRTreeRayHit>* hits = ((ON_SimpleArray<CRhCmnRTreeRayHit>**)context)[1];
+  CRhCmnRTreeRayHit& hit = hits->AppendNew();
+  hit.m_id = (int)id;
+  hit.m_t = t;
+  return (batch->m_max_hits < 1 || hits->Count() < batch->m_max_hits);
+}
+
+bool CRhCmnRTreeRayBatch::SearchRay(void* context, int index, int thread_index)
+{
+  CRhCmnRTreeRayBatch* batch = (CRhCmnRTreeRayBatch*)context;
+  const ON_Line& line = batch->m_lines[index];
+  const ON_3dVector dir = line.to - line.from;
+  CRhCmnRTreeRaySearch& search = batch->m_searches[thread_index];
+  search.SetRay(&line.from.x, &dir.x, 0.0, batch->m_bInfinite ? ON_DBL_MAX : 1.0);
+  void* hit_context[2];
+  hit_context[0] = batch;
+  hit_context[1] = &batch->m_hits[index];
+  search.Search(*batch->m_tree, AddHit, hit_context);
+  return true;
+}
+
+// Searches many rays or segments at once. Ray i starts at lines[i].from and
+// passes through lines[i].to at parameter 1. The hits of ray i are
+// ids[offsets[i]] ... ids[offsets[i+1]-1], sorted front to back, and
+// parameters holds the ray parameter where each box is entered.
+RH_C_FUNCTION int ON_RTree_SearchRays(const ON_RTree* pConstTree, int count, /*ARRAY*/const ON_Line* lines, bool infinite, int maxHitsPerRay, int threadCount, ON_SimpleArray<int>* offsets, ON_SimpleArray<int>* ids, ON_SimpleArray<double>* parameters)
+{
+  int rc = 0;
+  if( pConstTree && count > 0 && lines && offsets && ids && parameters )
+  {
+    if( threadCount < 1 )
+      threadCount = RhCmnMaxThreadCount();
+    CRhCmnRTreeRayBatch batch;
+    batch.m_tree = pConstTree;
+    batch.m_lines = lines;
+    batch.m_bInfinite = infinite;
+    batch.m_max_hits = maxHitsPerRay;
+    batch.m_searches.Reserve(threadCount);
+    for( int i=0; i<threadCount; i++ )
+      batch.m_searches.AppendNew();
+    batch.m_hits.Reserve(count);
+    for( int i=0; i<count; i++ )
+      batch.m_hits.AppendNew();
+    RhCmnParallelFor(threadCount, count, CRhCmnRTreeRayBatch::SearchRay, &batch);
+
+    for( int i=0; i<count; i++ )
+      rc += batch.m_hits[i].Count();
+    offsets->SetCount(0);
+    offsets->Reserve(count+1);
+    ids->SetCount(0);
+    ids->Reserve(rc);
+    parameters->SetCount(0);
+    parameters->Reserve(rc);
+    for( int i=0; i<count; i++ )
+    {
+      offsets->Append(ids->Count());
+      const ON_SimpleArray<CRhCmnRTreeRayHit>& hits = batch.m_hits[i];
+      for( int j=0; j<hits.Count(); j++ )
+      {
+        ids->Append(hits[j].m_id);
+        parameters->Append(hits[j].m_t);
+      }
+    }
+    offsets->Append(ids->Count());
+  }
+  return rc;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+// Convex polytope search
+//
+// The polytope is the intersection of half-spaces a*x + b*y + c*z + d >= 0.
+// Every node keeps a bit mask of the planes its box still straddles. Once a
+// box is inside a plane its children are not tested against that plane and
+// once the mask is empty the whole subtree is reported as inside.
+
+class CRhCmnRTreePolytopeSearch
+{
+public:
+  CRhCmnRTreePolytopeSearch(int plane_count, const ON_PlaneEquation* planes, ON_SimpleArray<int>* inside, ON_SimpleArray<int>* intersecting);
+  void Search(const ON_RTreeNode* node, ON__UINT64 mask);
+
+private:
+  // Returns -1 when box is outside the polytope, otherwise clears the
+  // bits of the planes box is fully inside of.
+  int Classify(const ON_RTreeBBox& box, ON__UINT64& mask) const;
+  void AddAll(const ON_RTreeNode* node);
+
+  const int m_plane_count;
+  const ON_PlaneEquation* m_planes;
+  ON_SimpleArray<int>* m_inside;
+  ON_SimpleArray<int>* m_intersecting;
+};
+
+CRhCmnRTreePolytopeSearch::CRhCmnRTreePolytopeSearch(int plane_count, const ON_PlaneEquation* planes, ON_SimpleArray<int>* inside, ON_SimpleArray<int>* intersecting)
+: m_plane_count(plane_count)
+, m_planes(planes)
+, m_inside(inside)
+, m_intersecting(intersecting)
+{
+}
+
+int CRhCmnRTreePolytopeSearch::Classify(const ON_RTreeBBox& box, ON__UINT64& mask) const
+{
+  for( int i=0; i<m_plane_count; i++ )
+  {
+    const ON__UINT64 bit = ((ON__UINT64)1) << i;
+    if( 0 == (mask & bit) )
+      continue;
+    const ON_PlaneEquation& e = m_planes[i];
+    // corner of the box farthest along the plane normal and the one opposite
+    double far_value = e.d;
+    double near_value = e.d;
+    if( e.x > 0.0 ) { far_value += e.x*box.m_max[0]; near_value += e.x*box.m_min[0]; }
+    else            { far_value += e.x*box.m_min[0]; near_value += e.x*box.m_max[0]; }
+    if( e.y > 0.0 ) { far_value += e.y*box.m_max[1]; near_value += e.y*box.m_min[1]; }
+    else            { far_value += e.y*box.m_min[1]; near_value += e.y*box.m_max[1]; }
+    if( e.z > 0.0 ) { far_value += e.z*box.m_max[2]; near_value += e.z*box.m_min[2]; }
+    else            { far_value += e.z*box.m_min[2]; near_value += e.z*box.m_max[2]; }
+    if( far_value < 0.0 )
+      return -1;
+    if( near_value >= 0.0 )
+      mask &= ~bit;
+  }
+  return 0;
+}
+
+void CRhCmnRTreePolytopeSearch::AddAll(const ON_RTreeNode* node)
+{
+  if( node->IsInternalNode() )
+  {
+    for( int i=0; i<node->m_count; i++ )
+      AddAll(node->m_branch[i].m_child);
+  }
+  else
+  {
+    for( int i=0; i<node->m_count; i++ )
+      m_inside->Append((int)node->m_branch[i].m_id);
+  }
+}
+
+void CRhCmnRTreePolytopeSearch::Search(const ON_RTreeNode* node, ON__UINT64 mask)
+{
+  const bool bInternal = node->IsInternalNode();
+  for( int i=0; i<node->m_count; i++ )
+  {
+    const ON_RTreeBranch& branch = node->m_branch[i];
+    ON__UINT64 child_mask = mask;
+    if( Classify(branch.m_rect, child_mask) < 0 )
+      continue;
+    if( bInternal )
+    {
+      if( 0 == child_mask )
+        AddAll(branch.m_child);
+      else
+        Search(branch.m_child, child_mask);
+    }
+    else if( 0 == child_mask )
+      m_inside->Append((int)branch.m_id);
+    else
+      m_intersecting->Append((int)branch.m_id);
+  }
+}
+
+static bool RhCmnRTreeSearchPolytope(const ON_RTree& tree, int planeCount, const ON_PlaneEquation* planes, ON_SimpleArray<int>* inside, ON_SimpleArray<int>* intersecting)
+{
+  // the active planes are tracked in a 64 bit mask
+  if( planeCount < 1 || planeCount > 64 || 0 == planes || 0 == inside || 0 == intersecting )
+    return false;
+  inside->SetCount(0);
+  intersecting->SetCount(0);
+  const ON_RTreeNode* root = tree.Root();
+  if( root && root->m_count > 0 )
+  {
+    ON__UINT64 mask = (64 == planeCount) ? ~((ON__UINT64)0) : ((((ON__UINT64)1) << planeCount) - 1);
+    CRhCmnRTreePolytopeSearch search(planeCount, planes, inside, intersecting);
+    search.Search(root, mask);
+  }
+  return true;
+}
+
+// planeEquations holds planeCount a,b,c,d quadruples. Elements are found when
+// their boxes touch the region where every a*x + b*y + c*z + d >= 0.
+RH_C_FUNCTION bool ON_RTree_SearchPolytope(const ON_RTree* pConstTree, int planeCount, /*ARRAY*/const double* planeEquations, ON_SimpleArray<int>* inside, ON_SimpleArray<int>* intersecting)
+{
+  bool rc = false;
+  if( pConstTree && planeEquations && planeCount > 0 )
+  {
+    ON_SimpleArray<ON_PlaneEquation> planes(planeCount);
+    for( int i=0; i<planeCount; i++ )
+    {
+      const double* e = planeEquations + 4*i;
+      planes.Append(ON_PlaneEquation(e[0], e[1], e[2], e[3]));
+    }
+    rc = RhCmnRTreeSearchPolytope(*pConstTree, planeCount, planes.Array(), inside, intersecting);
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_RTree_SearchViewportFrustum(const ON_RTree* pConstTree, const ON_Viewport* pConstViewport, ON_SimpleArray<int>* inside, ON_SimpleArray<int>* intersecting)
+{
+  bool rc = false;
+  ON_3dPoint n[4], f[4]; // left bottom, right bottom, left top, right top
+  if( pConstTree && pConstViewport &&
+      pConstViewport->GetNearRect(n[0], n[1], n[2], n[3]) &&
+      pConstViewport->GetFarRect(f[0], f[1], f[2], f[3]) )
+  {
+    ON_3dPoint center(0,0,0);
+    for( int i=0; i<4; i++ )
+      center = center + 0.125*(n[i] + f[i]);
+
+    // three corners on each face of the frustum: near, far, left, right, bottom, top
+    const ON_3dPoint* faces[6][3] =
+    {
+      { &n[0], &n[1], &n[2] },
+      { &f[0], &f[1], &f[2] },
+      { &n[0], &f[0], &n[2] },
+      { &n[1], &f[1], &n[3] },
+      { &n[0], &f[0], &n[1] },
+      { &n[2], &f[2], &n[3] }
+    };
+    ON_PlaneEquation planes[6];
+    int plane_count = 0;
+    for( int i=0; i<6; i++ )
+    {
+      const ON_3dPoint& p = *faces[i][0];
+      ON_3dVector normal = ON_CrossProduct(*faces[i][1] - p, *faces[i][2] - p);
+      if( !normal.Unitize() )
+        continue;
+      ON_PlaneEquation& e = planes[plane_count];
+      if( !e.Create(p, normal) )
+        continue;
+      if( e.ValueAt(center) < 0.0 )
+        e = ON_PlaneEquation(-e.x, -e.y, -e.z, -e.d);
+      plane_count++;
+    }
+    rc = RhCmnRTreeSearchPolytope(*pConstTree, plane_count, planes, inside, intersecting);
+  }
+  return rc;
+}
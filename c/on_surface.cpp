@@ -253,6 +253,364 @@ RH_C_FUNCTION bool ON_Surface_GetNextDiscontinuity(const ON_Surface* pConstSurfa
   return rc;
 }
 
+RH_C_FUNCTION int ON_Surface_GetDiscontinuities(const ON_Surface* pConstSurface, int direction, int continuityType, double t0, double t1, ON_SimpleArray<double>* t)
+{
+  int rc = 0;
+  if( pConstSurface && t && ON_IsValid(t0) && ON_IsValid(t1) && t0 != t1 )
+  {
+    // same stepping as ON_Curve_GetDiscontinuities
+    const ON::continuity c = ON::Continuity(continuityType);
+    const bool bIncreasing = (t0 < t1);
+    double s = ON_UNSET_VALUE;
+    while( pConstSurface->GetNextDiscontinuity(direction, c, t0, t1, &s) )
+    {
+      if( bIncreasing ? !(s > t0) : !(s < t0) )
+        break;
+      t->Append(s);
+      rc++;
+      if( s == t1 )
+        break;
+      t0 = s;
+    }
+  }
+  return rc;
+}
+
+// Tessellates surfaces and untrimmed brep faces into adaptive (u,v) grids.
+// Each direction starts from the surface's spans and an interval is split
+// while the midpoint strays from the chord by more than chord_tolerance or
+// the normals at its ends differ by more than angle_tolerance, tested along
+// a few lines in the other direction. The grid is the tensor product of the
+// two parameter lists, so neighbouring cells share their edge samples and
+// there are no cracks. Refining runs per surface and evaluating per grid
+// row, both with RhCmnParallelFor.
+class CRhCmnSurfaceGrids
+{
+public:
+  CRhCmnSurfaceGrids(const ON_Geometry* const* geometry, int count, double chord_tolerance, double angle_tolerance, int max_count);
+
+  void Create(int thread_count);
+
+  int SurfaceCount() const { return m_grids.Count(); }
+  int VertexCount() const { return m_points.Count(); }
+  int QuadCount() const { return m_quads.Count()/4; }
+
+  // info gets 3 ints per input: u count, v count and first vertex. Vertex
+  // (i,j) of a grid is first + j*u_count + i. Inputs that are not surfaces
+  // get zero counts.
+  void Copy(int* info, ON_3dPoint* points, ON_3dVector* normals, ON_2dPoint* uv, int* quads) const;
+
+private:
+  struct CGrid
+  {
+    const ON_Surface* m_srf;
+    bool m_bRev; // reversed brep face
+    ON_SimpleArray<double> m_t[2];
+    int m_vertex_index;
+  };
+
+  static bool RefineGrid(void* context, int index, int thread_index);
+  static bool EvaluateRow(void* context, int index, int thread_index);
+  void InitialParameters(const ON_Surface& srf, int dir, ON_SimpleArray<double>& t) const;
+  void RefineDirection(const ON_Surface& srf, int dir, const ON_SimpleArray<double>& test, ON_SimpleArray<double>& t) const;
+  bool Split(const ON_Surface& srf, int dir, double a, double b, const ON_SimpleArray<double>& test) const;
+
+  const double m_chord_tolerance;
+  const double m_cos_angle;
+  const bool m_bAngle;
+  const int m_max_count;
+  ON_ClassArray<CGrid> m_grids;
+  ON_SimpleArray<int> m_row_grid; // grid of every row
+  ON_SimpleArray<int> m_row_v;    // v index of every row
+  ON_3dPointArray m_points;
+  ON_SimpleArray<ON_3dVector> m_normals;
+  ON_SimpleArray<ON_2dPoint> m_uv;
+  ON_SimpleArray<int> m_quads;
+
+  // no copies
+  CRhCmnSurfaceGrids(const CRhCmnSurfaceGrids&);
+  CRhCmnSurfaceGrids& operator=(const CRhCmnSurfaceGrids&);
+};
+
+CRhCmnSurfaceGrids::CRhCmnSurfaceGrids(const ON_Geometry* const* geometry, int count, double chord_tolerance, double angle_tolerance, int max_count)
+: m_chord_tolerance(chord_tolerance > 0.0 ? chord_tolerance : 0.0)
+, m_cos_angle(angle_tolerance > 0.0 ? cos(angle_tolerance) : 1.0)
+, m_bAngle(angle_tolerance > 0.0 && angle_tolerance < ON_PI)
+, m_max_count(max_count >= 2 ? max_count : 256)
+{
+  m_grids.Reserve(count);
+  for( int i=0; i<count; i++ )
+  {
+    CGrid& grid = m_grids.AppendNew();
+    grid.m_srf = ON_Surface::Cast(geometry ? geometry[i] : 0);
+    const ON_BrepFace* face = ON_BrepFace::Cast(grid.m_srf);
+    grid.m_bRev = (face && face->m_bRev);
+    grid.m_vertex_index = 0;
+  }
+}
+
+void CRhCmnSurfaceGrids::InitialParameters(const ON_Surface& srf, int dir, ON_SimpleArray<double>& t) const
+{
+  // every span is split into degree pieces so curved spans start with a
+  // few samples
+  const int span_count = srf.SpanCount(dir);
+  int pieces = srf.Degree(dir);
+  if( pieces < 1 )
+    pieces = 1;
+  else if( pieces > 4 )
+    pieces = 4;
+  ON_SimpleArray<double> spans(span_count+1);
+  if( span_count < 1 || !srf.GetSpanVector(dir, spans.Array()) )
+  {
+    const ON_Interval domain = srf.Domain(dir);
+    t.Append(domain[0]);
+    t.Append(domain[1]);
+    return;
+  }
+  spans.SetCount(span_count+1);
+  t.Reserve(span_count*pieces+1);
+  t.Append(spans[0]);
+  for( int i=0; i<span_count; i++ )
+  {
+    const ON_Interval span(spans[i], spans[i+1]);
+    for( int k=1; k<=pieces; k++ )
+      t.Append(k == pieces ? span[1] : span.ParameterAt((double)k/(double)pieces));
+  }
+}
+
+bool CRhCmnSurfaceGrids::Split(const ON_Surface& srf, int dir, double a, double b, const ON_SimpleArray<double>& test) const
+{
+  const double m = 0.5*(a+b);
+  for( int i=0; i<test.Count(); i++ )
+  {
+    const double s = test[i];
+    ON_3dPoint A, B;
+    ON_3dVector NA, NB;
+    const bool bA = (0 == dir) ? srf.EvNormal(a, s, A, NA) : srf.EvNormal(s, a, A, NA);
+    const bool bB = (0 == dir) ? srf.EvNormal(b, s, B, NB) : srf.EvNormal(s, b, B, NB);
+    const ON_3dPoint M = (0 == dir) ? srf.PointAt(m, s) : srf.PointAt(s, m);
+    if( m_chord_tolerance > 0.0 )
+    {
+      const ON_Line chord(A, B);
+      const double d = (A == B) ? M.DistanceTo(A) : chord.DistanceTo(M);
+      if( d > m_chord_tolerance )
+        return true;
+    }
+    if( m_bAngle && bA && bB && NA*NB < m_cos_angle )
+      return true;
+  }
+  return false;
+}
+
+void CRhCmnSurfaceGrids::RefineDirection(const ON_Surface& srf, int dir, const ON_SimpleArray<double>& test, ON_SimpleArray<double>& t) const
+{
+  ON_SimpleArray<double> initial;
+  InitialParameters(srf, dir, initial);
+  const ON_Interval domain = srf.Domain(dir);
+  const double min_length = 1.0e-8*domain.Length();
+
+  // depth first so the parameters come out sorted
+  ON_SimpleArray<ON_Interval> stack(32);
+  t.Append(initial[0]);
+  for( int i=0; i+1<initial.Count(); i++ )
+  {
+    stack.Append(ON_Interval(initial[i], initial[i+1]));
+    while( stack.Count() > 0 )
+    {
+      const ON_Interval piece = *stack.Last();
+      stack.SetCount(stack.Count()-1);
+      const bool bRoom = (t.Count() + stack.Count() + 1 < m_max_count);
+      if( bRoom && piece.Length() > min_length && Split(srf, dir, piece[0], piece[1], test) )
+      {
+        const double mid = piece.Mid();
+        stack.Append(ON_Interval(mid, piece[1]));
+        stack.Append(ON_Interval(piece[0], mid));
+      }
+      else
+        t.Append(piece[1]);
+    }
+  }
+}
+
+bool CRhCmnSurfaceGrids::RefineGrid(void* context, int index, int)
+{
+  CRhCmnSurfaceGrids* pThis = (CRhCmnSurfaceGrids*)context;
+  CGrid& grid = pThis->m_grids[index];
+  if( 0 == grid.m_srf )
+    return true;
+
+  // test along at most 9 of the other direction's starting lines
+  ON_SimpleArray<double> initial[2];
+  ON_SimpleArray<double> test[2];
+  int dir;
+  for( dir=0; dir<2; dir++ )
+    pThis->InitialParameters(*grid.m_srf, dir, initial[dir]);
+  for( dir=0; dir<2; dir++ )
+  {
+    const ON_SimpleArray<double>& other = initial[1-dir];
+    const int n = other.Count();
+    const int test_count = n < 9 ? n : 9;
+    for( int i=0; i<test_count; i++ )
+      test[dir].Append(other[(test_count > 1) ? (i*(n-1))/(test_count-1) : 0]);
+  }
+  for( dir=0; dir<2; dir++ )
+    pThis->RefineDirection(*grid.m_srf, dir, test[dir], grid.m_t[dir]);
+  return true;
+}
+
+bool CRhCmnSurfaceGrids::EvaluateRow(void* context, int index, int)
+{
+  CRhCmnSurfaceGrids* pThis = (CRhCmnSurfaceGrids*)context;
+  const CGrid& grid = pThis->m_grids[pThis->m_row_grid[index]];
+  const int j = pThis->m_row_v[index];
+  const int nu = grid.m_t[0].Count();
+  const double v = grid.m_t[1][j];
+  const int first = grid.m_vertex_index + j*nu;
+  int hint[2] = {0,0};
+  for( int i=0; i<nu; i++ )
+  {
+    const double u = grid.m_t[0][i];
+    ON_3dPoint P;
+    ON_3dVector N;
+    if( !grid.m_srf->EvNormal(u, v, P, N, 0, hint) )
+    {
+      P = grid.m_srf->PointAt(u, v);
+      N.Set(0.0, 0.0, 0.0);
+    }
+    else if( grid.m_bRev )
+      N.Reverse();
+    pThis->m_points[first+i] = P;
+    pThis->m_normals[first+i] = N;
+    pThis->m_uv[first+i].Set(u, v);
+  }
+  return true;
+}
+
+void CRhCmnSurfaceGrids::Create(int thread_count)
+{
+  const int grid_count = m_grids.Count();
+  RhCmnParallelFor(thread_count, grid_count, RefineGrid, this);
+
+  int vertex_count = 0, quad_count = 0, row_count = 0;
+  int g;
+  for( g=0; g<grid_count; g++ )
+  {
+    CGrid& grid = m_grids[g];
+    const int nu = grid.m_t[0].Count();
+    const int nv = grid.m_t[1].Count();
+    grid.m_vertex_index = vertex_count;
+    if( nu < 2 || nv < 2 )
+    {
+      grid.m_t[0].SetCount(0);
+      grid.m_t[1].SetCount(0);
+      continue;
+    }
+    vertex_count += nu*nv;
+    quad_count += (nu-1)*(nv-1);
+    row_count += nv;
+  }
+
+  m_points.SetCapacity(vertex_count);
+  m_points.SetCount(vertex_count);
+  m_normals.SetCapacity(vertex_count);
+  m_normals.SetCount(vertex_count);
+  m_uv.SetCapacity(vertex_count);
+  m_uv.SetCount(vertex_count);
+  m_row_grid.SetCapacity(row_count);
+  m_row_v.SetCapacity(row_count);
+  m_quads.SetCapacity(4*quad_count);
+  for( g=0; g<grid_count; g++ )
+  {
+    const CGrid& grid = m_grids[g];
+    const int nu = grid.m_t[0].Count();
+    const int nv = grid.m_t[1].Count();
+    for( int j=0; j<nv; j++ )
+    {
+      m_row_grid.Append(g);
+      m_row_v.Append(j);
+    }
+    // counterclockwise about the surface normal
+    for( int j=0; j+1<nv; j++ )
+    {
+      for( int i=0; i+1<nu; i++ )
+      {
+        const int vi = grid.m_vertex_index + j*nu + i;
+        m_quads.Append(vi);
+        if( grid.m_bRev )
+        {
+          m_quads.Append(vi+nu);
+          m_quads.Append(vi+nu+1);
+          m_quads.Append(vi+1);
+        }
+        else
+        {
+          m_quads.Append(vi+1);
+          m_quads.Append(vi+nu+1);
+          m_quads.Append(vi+nu);
+        }
+      }
+    }
+  }
+
+  RhCmnParallelFor(thread_count, row_count, EvaluateRow, this);
+}
+
+void CRhCmnSurfaceGrids::Copy(int* info, ON_3dPoint* points, ON_3dVector* normals, ON_2dPoint* uv, int* quads) const
+{
+  const int vertex_count = m_points.Count();
+  if( info )
+  {
+    for( int g=0; g<m_grids.Count(); g++ )
+    {
+      info[3*g] = m_grids[g].m_t[0].Count();
+      info[3*g+1] = m_grids[g].m_t[1].Count();
+      info[3*g+2] = m_grids[g].m_vertex_index;
+    }
+  }
+  if( points && vertex_count > 0 )
+    memcpy(points, m_points.Array(), vertex_count*sizeof(points[0]));
+  if( normals && vertex_count > 0 )
+    memcpy(normals, m_normals.Array(), vertex_count*sizeof(normals[0]));
+  if( uv && vertex_count > 0 )
+    memcpy(uv, m_uv.Array(), vertex_count*sizeof(uv[0]));
+  if( quads && m_quads.Count() > 0 )
+    memcpy(quads, m_quads.Array(), m_quads.Count()*sizeof(quads[0]));
+}
+
+RH_C_FUNCTION CRhCmnSurfaceGrids* ON_SurfaceGrids_New(const ON_SimpleArray<const ON_Geometry*>* pConstGeometry, double chordTolerance, double angleTolerance, int maxCount, int threadCount)
+{
+  CRhCmnSurfaceGrids* rc = NULL;
+  if( pConstGeometry )
+  {
+    rc = new CRhCmnSurfaceGrids(pConstGeometry->Array(), pConstGeometry->Count(), chordTolerance, angleTolerance, maxCount);
+    rc->Create(threadCount);
+  }
+  return rc;
+}
+
+RH_C_FUNCTION void ON_SurfaceGrids_Delete(CRhCmnSurfaceGrids* pGrids)
+{
+  if( pGrids )
+    delete pGrids;
+}
+
+// counts gets the number of inputs, vertices and quads
+RH_C_FUNCTION void ON_SurfaceGrids_GetCounts(const CRhCmnSurfaceGrids* pConstGrids, /*ARRAY*/int* counts)
+{
+  if( pConstGrids && counts )
+  {
+    counts[0] = pConstGrids->SurfaceCount();
+    counts[1] = pConstGrids->VertexCount();
+    counts[2] = pConstGrids->QuadCount();
+  }
+}
+
+RH_C_FUNCTION void ON_SurfaceGrids_Copy(const CRhCmnSurfaceGrids* pConstGrids, /*ARRAY*/int* info, /*ARRAY*/ON_3dPoint* points, /*ARRAY*/ON_3dVector* normals, /*ARRAY*/ON_2dPoint* uv, /*ARRAY*/int* quads)
+{
+  if( pConstGrids )
+    pConstGrids->Copy(info, points, normals, uv, quads);
+}
+
 RH_C_FUNCTION bool ON_Surface_IsContinuous(const ON_Surface* pConstSurface, int continuityType, double s, double t)
 {
   bool rc = false;
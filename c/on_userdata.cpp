@@ -45,6 +45,10 @@ private:
   ON_wString m_description;
 };
 
+// {5DFE66EC-3DBD-47F3-A5BB-AA7EC0EB4AFC}
+const ON_UUID RhCmnCacheApplicationId =
+{ 0x5dfe66ec, 0x3dbd, 0x47f3, { 0xa5, 0xbb, 0xaa, 0x7e, 0xc0, 0xeb, 0x4a, 0xfc } };
+
 USERDATATRANSFORMPROC CRhCmnUserData::m_transform = NULL;
 USERDATAARCHIVEPROC CRhCmnUserData::m_archive = NULL;
 USERDATAIOPROC CRhCmnUserData::m_readwrite = NULL;
@@ -231,6 +231,43 @@ RH_C_FUNCTION void ON_Matrix_SetValue(ON_Matrix* pMatrix, int row, int column, d
     (*pMatrix)[row][column] = val;
 }
 
+// values is a row major rowCount x columnCount block starting at [row][column]
+RH_C_FUNCTION bool ON_Matrix_GetBlock(const ON_Matrix* pConstMatrix, int row, int column, int rowCount, int columnCount, /*ARRAY*/double* values)
+{
+  bool rc = false;
+  if( pConstMatrix && values && row >= 0 && column >= 0 && rowCount >= 0 && columnCount >= 0 &&
+      row + rowCount <= pConstMatrix->RowCount() && column + columnCount <= pConstMatrix->ColCount() )
+  {
+    for( int i=0; i<rowCount; i++ )
+    {
+      const double* src = (*pConstMatrix)[row+i] + column;
+      double* dst = values + i*columnCount;
+      for( int j=0; j<columnCount; j++ )
+        dst[j] = src[j];
+    }
+    rc = true;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_Matrix_SetBlock(ON_Matrix* pMatrix, int row, int column, int rowCount, int columnCount, /*ARRAY*/const double* values)
+{
+  bool rc = false;
+  if( pMatrix && values && row >= 0 && column >= 0 && rowCount >= 0 && columnCount >= 0 &&
+      row + rowCount <= pMatrix->RowCount() && column + columnCount <= pMatrix->ColCount() )
+  {
+    for( int i=0; i<rowCount; i++ )
+    {
+      const double* src = values + i*columnCount;
+      double* dst = (*pMatrix)[row+i] + column;
+      for( int j=0; j<columnCount; j++ )
+        dst[j] = src[j];
+    }
+    rc = true;
+  }
+  return rc;
+}
+
 RH_C_FUNCTION void ON_Matrix_Zero(ON_Matrix* pMatrix)
 {
   if( pMatrix )
@@ -363,3 +400,1206 @@ RH_C_FUNCTION bool ON_Matrix_GetBool(const ON_Matrix* pConstMatrix, int which)
   }
   return rc;
 }
+
+////////////////////////////////////////////////////////////////////////////
+// Blocked dense kernels for large ON_Matrix systems.
+//
+// Every entry is computed with the same operations, in the same order, as in
+// the ON_Matrix member function the kernel stands in for. Only the loops are
+// rearranged: rows are visited in blocks that stay in cache, the inner loops
+// run over contiguous row memory the compiler can vectorize and independent
+// row blocks run with RhCmnParallelFor. The results do not depend on the
+// thread count.
+
+static const int RHCMN_MATRIX_BLOCK = 64;  // rows per task and columns per panel
+static const int RHCMN_MATRIX_TILE = 256;  // columns per cache tile
+
+static void RhCmnMatrixRows(ON_Matrix& M, ON_SimpleArray<double*>& rows)
+{
+  const int row_count = M.RowCount();
+  rows.SetCount(0);
+  rows.Reserve(row_count);
+  for( int i=0; i<row_count; i++ )
+    rows.Append(M[i]);
+}
+
+static void RhCmnMatrixRows(const ON_Matrix& M, ON_SimpleArray<const double*>& rows)
+{
+  const int row_count = M.RowCount();
+  rows.SetCount(0);
+  rows.Reserve(row_count);
+  for( int i=0; i<row_count; i++ )
+    rows.Append(M[i]);
+}
+
+static int RhCmnMatrixBlockCount(int count, int block_size)
+{
+  return count > 0 ? (count + block_size - 1)/block_size : 0;
+}
+
+// C = A*B. Tasks are blocks of rows of C and run i-k-j over column tiles,
+// so every C[i][j] is still 0.0 + A[i][0]*B[0][j] + A[i][1]*B[1][j] + ...
+// summed in increasing k like ON_Matrix::Multiply.
+class CRhCmnMatrixProduct
+{
+public:
+  // C must be A.RowCount() x B.ColCount() and distinct from A and B
+  CRhCmnMatrixProduct(const ON_Matrix& A, const ON_Matrix& B, ON_Matrix& C);
+  void Run(int thread_count);
+
+private:
+  static bool MultiplyRows(void* context, int index, int thread_index);
+
+  ON_SimpleArray<const double*> m_a;
+  ON_SimpleArray<const double*> m_b;
+  ON_SimpleArray<double*> m_c;
+  const int m_mult_count;
+  const int m_col_count;
+
+  // no copies
+  CRhCmnMatrixProduct(const CRhCmnMatrixProduct&);
+  CRhCmnMatrixProduct& operator=(const CRhCmnMatrixProduct&);
+};
+
+CRhCmnMatrixProduct::CRhCmnMatrixProduct(const ON_Matrix& A, const ON_Matrix& B, ON_Matrix& C)
+: m_mult_count(A.ColCount())
+, m_col_count(B.ColCount())
+{
+  RhCmnMatrixRows(A, m_a);
+  RhCmnMatrixRows(B, m_b);
+  RhCmnMatrixRows(C, m_c);
+}
+
+void CRhCmnMatrixProduct::Run(int thread_count)
+{
+  RhCmnParallelFor(thread_count, RhCmnMatrixBlockCount(m_c.Count(), RHCMN_MATRIX_BLOCK), MultiplyRows, this);
+}
+
+bool CRhCmnMatrixProduct::MultiplyRows(void* context, int index, int)
+{
+  const CRhCmnMatrixProduct* pThis = (const CRhCmnMatrixProduct*)context;
+  const int n = pThis->m_col_count;
+  const int p = pThis->m_mult_count;
+  const int i0 = index*RHCMN_MATRIX_BLOCK;
+  const int i1 = (i0 + RHCMN_MATRIX_BLOCK < pThis->m_c.Count()) ? i0 + RHCMN_MATRIX_BLOCK : pThis->m_c.Count();
+  int i, j, k;
+  for( i=i0; i<i1; i++ )
+  {
+    double* c = pThis->m_c[i];
+    for( j=0; j<n; j++ )
+      c[j] = 0.0;
+  }
+  for( int j0=0; j0<n; j0+=RHCMN_MATRIX_TILE )
+  {
+    const int j1 = (j0 + RHCMN_MATRIX_TILE < n) ? j0 + RHCMN_MATRIX_TILE : n;
+    for( int k0=0; k0<p; k0+=RHCMN_MATRIX_BLOCK )
+    {
+      const int k1 = (k0 + RHCMN_MATRIX_BLOCK < p) ? k0 + RHCMN_MATRIX_BLOCK : p;
+      for( i=i0; i<i1; i++ )
+      {
+        double* c = pThis->m_c[i];
+        const double* a = pThis->m_a[i];
+        for( k=k0; k<k1; k++ )
+        {
+          const double aik = a[k];
+          const double* b = pThis->m_b[k];
+          for( j=j0; j<j1; j++ )
+            c[j] += aik*b[j];
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// LU factorization with partial pivoting. The pivot choice, the scaling of
+// the pivot row, the "fabs(x) > zero_tolerance" update test and the
+// determinant, smallest pivot and rank are those of ON_Matrix::RowReduce and
+// every entry gets its updates in the same order, so the strictly upper part
+// matches what RowReduce leaves. The diagonal keeps the pivots and the
+// strictly lower part the multipliers (0.0 where RowReduce skipped the row)
+// so the factors can be used for any number of right hand sides.
+//
+// Columns are factored in panels of RHCMN_MATRIX_BLOCK. The panel's updates
+// to the columns on its right are delayed and then applied in parallel, by
+// column tiles for the panel's own rows and by row blocks below them.
+class CRhCmnMatrixLU
+{
+public:
+  CRhCmnMatrixLU(ON_Matrix& M, double zero_tolerance);
+
+  // pivots[] gets min(RowCount,ColCount) row indices; row k was swapped with
+  // row pivots[k] at step k. Returns the rank.
+  int Factor(int thread_count, int* pivots, double& determinant, double& pivot);
+
+private:
+  static bool UpdatePanelRows(void* context, int index, int thread_index);
+  static bool UpdateRowsBelow(void* context, int index, int thread_index);
+
+  ON_Matrix& m_M;
+  ON_SimpleArray<double*> m_a;
+  ON_SimpleArray<double> m_scale; // 1/pivot of every factored row
+  const double m_zero_tolerance;
+  const int m_row_count;
+  const int m_col_count;
+  int m_k0;   // first column of the current panel
+  int m_k1;   // end of the current panel
+  int m_kend; // end of the factored columns of the current panel
+
+  // no copies
+  CRhCmnMatrixLU(const CRhCmnMatrixLU&);
+  CRhCmnMatrixLU& operator=(const CRhCmnMatrixLU&);
+};
+
+CRhCmnMatrixLU::CRhCmnMatrixLU(ON_Matrix& M, double zero_tolerance)
+: m_M(M)
+, m_zero_tolerance(zero_tolerance)
+, m_row_count(M.RowCount())
+, m_col_count(M.ColCount())
+, m_k0(0)
+, m_k1(0)
+, m_kend(0)
+{
+  RhCmnMatrixRows(M, m_a);
+}
+
+int CRhCmnMatrixLU::Factor(int thread_count, int* pivots, double& determinant, double& pivot)
+{
+  const int n = m_row_count <= m_col_count ? m_row_count : m_col_count;
+  double x, piv = 1.0, det = 1.0;
+  int i, j, k, ix, rank = 0;
+
+  m_scale.Reserve(n);
+  m_scale.SetCount(n);
+  for( k=0; k<n; k++ )
+    pivots[k] = k;
+
+  for( m_k0=0; m_k0<n; m_k0=m_k1 )
+  {
+    m_k1 = (m_k0 + RHCMN_MATRIX_BLOCK < n) ? m_k0 + RHCMN_MATRIX_BLOCK : n;
+    for( k=m_k0; k<m_k1; k++ )
+    {
+      ix = k;
+      x = fabs(m_a[ix][k]);
+      for( i=k+1; i<m_row_count; i++ )
+      {
+        if( fabs(m_a[i][k]) > x )
+        {
+          ix = i;
+          x = fabs(m_a[ix][k]);
+        }
+      }
+      if( x < piv || k == 0 )
+        piv = x;
+      if( x <= m_zero_tolerance )
+      {
+        det = 0.0;
+        break;
+      }
+      rank++;
+      if( ix != k )
+      {
+        m_M.SwapRows(ix, k);
+        m_a[ix] = m_M[ix];
+        m_a[k] = m_M[k];
+        pivots[k] = ix;
+        det = -det;
+      }
+
+      // scale the panel part of row k, the rest is scaled in UpdatePanelRows
+      double* rk = m_a[k];
+      det *= rk[k];
+      x = 1.0/rk[k];
+      m_scale[k] = x;
+      for( j=k+1; j<m_k1; j++ )
+        rk[j] *= x;
+
+      // eliminate column k from the panel part of the rows below
+      for( i=k+1; i<m_row_count; i++ )
+      {
+        double* ri = m_a[i];
+        x = -ri[k];
+        if( fabs(x) > m_zero_tolerance )
+        {
+          for( j=k+1; j<m_k1; j++ )
+            ri[j] += x*rk[j];
+        }
+        else
+          ri[k] = 0.0;
+      }
+    }
+    m_kend = k;
+
+    if( m_kend > m_k0 && m_k1 < m_col_count )
+    {
+      RhCmnParallelFor(thread_count, RhCmnMatrixBlockCount(m_col_count - m_k1, RHCMN_MATRIX_TILE), UpdatePanelRows, this);
+      RhCmnParallelFor(thread_count, RhCmnMatrixBlockCount(m_row_count - m_kend, RHCMN_MATRIX_BLOCK), UpdateRowsBelow, this);
+    }
+    if( m_kend < m_k1 )
+      break;
+  }
+
+  pivot = piv;
+  determinant = det;
+  return rank;
+}
+
+bool CRhCmnMatrixLU::UpdatePanelRows(void* context, int index, int)
+{
+  const CRhCmnMatrixLU* pThis = (const CRhCmnMatrixLU*)context;
+  const int j0 = pThis->m_k1 + index*RHCMN_MATRIX_TILE;
+  const int j1 = (j0 + RHCMN_MATRIX_TILE < pThis->m_col_count) ? j0 + RHCMN_MATRIX_TILE : pThis->m_col_count;
+  int j, k, kk;
+  for( k=pThis->m_k0; k<pThis->m_kend; k++ )
+  {
+    double* rk = pThis->m_a[k];
+    for( kk=pThis->m_k0; kk<k; kk++ )
+    {
+      const double x = -rk[kk];
+      if( x != 0.0 )
+      {
+        const double* rkk = pThis->m_a[kk];
+        for( j=j0; j<j1; j++ )
+          rk[j] += x*rkk[j];
+      }
+    }
+    const double s = pThis->m_scale[k];
+    for( j=j0; j<j1; j++ )
+      rk[j] *= s;
+  }
+  return true;
+}
+
+bool CRhCmnMatrixLU::UpdateRowsBelow(void* context, int index, int)
+{
+  const CRhCmnMatrixLU* pThis = (const CRhCmnMatrixLU*)context;
+  const int i0 = pThis->m_kend + index*RHCMN_MATRIX_BLOCK;
+  const int i1 = (i0 + RHCMN_MATRIX_BLOCK < pThis->m_row_count) ? i0 + RHCMN_MATRIX_BLOCK : pThis->m_row_count;
+  int i, j, k;
+  for( int j0=pThis->m_k1; j0<pThis->m_col_count; j0+=RHCMN_MATRIX_TILE )
+  {
+    const int j1 = (j0 + RHCMN_MATRIX_TILE < pThis->m_col_count) ? j0 + RHCMN_MATRIX_TILE : pThis->m_col_count;
+    for( i=i0; i<i1; i++ )
+    {
+      double* ri = pThis->m_a[i];
+      for( k=pThis->m_k0; k<pThis->m_kend; k++ )
+      {
+        const double x = -ri[k];
+        if( x != 0.0 )
+        {
+          const double* rk = pThis->m_a[k];
+          for( j=j0; j<j1; j++ )
+            ri[j] += x*rk[j];
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Cholesky factorization M = L*transpose(L) of a symmetric positive definite
+// matrix. Only the lower triangle of M is read and L replaces it; the strictly
+// upper triangle is zeroed. Row by row,
+//   L[i][j] = (M[i][j] - ON_ArrayDotProduct(j, L[i], L[j]))/L[j][j]
+//   L[i][i] = sqrt(M[i][i] - ON_ArrayDotProduct(i, L[i], L[i]))
+// Columns are done in panels of RHCMN_MATRIX_BLOCK: the panel's diagonal
+// block is serial and the rows below it run in parallel row blocks.
+class CRhCmnMatrixCholesky
+{
+public:
+  CRhCmnMatrixCholesky(ON_Matrix& M, double zero_tolerance);
+
+  // false when a diagonal value is <= zero_tolerance. M is then partially
+  // overwritten.
+  bool Factor(int thread_count);
+
+private:
+  static bool FactorRows(void* context, int index, int thread_index);
+
+  ON_SimpleArray<double*> m_a;
+  const double m_zero_tolerance;
+  int m_j0; // first column of the current panel
+  int m_j1; // end of the current panel
+
+  // no copies
+  CRhCmnMatrixCholesky(const CRhCmnMatrixCholesky&);
+  CRhCmnMatrixCholesky& operator=(const CRhCmnMatrixCholesky&);
+};
+
+CRhCmnMatrixCholesky::CRhCmnMatrixCholesky(ON_Matrix& M, double zero_tolerance)
+: m_zero_tolerance(zero_tolerance)
+, m_j0(0)
+, m_j1(0)
+{
+  RhCmnMatrixRows(M, m_a);
+}
+
+bool CRhCmnMatrixCholesky::Factor(int thread_count)
+{
+  const int n = m_a.Count();
+  int i, j;
+  for( m_j0=0; m_j0<n; m_j0=m_j1 )
+  {
+    m_j1 = (m_j0 + RHCMN_MATRIX_BLOCK < n) ? m_j0 + RHCMN_MATRIX_BLOCK : n;
+    for( i=m_j0; i<m_j1; i++ )
+    {
+      double* ri = m_a[i];
+      for( j=m_j0; j<i; j++ )
+        ri[j] = (ri[j] - ON_ArrayDotProduct(j, ri, m_a[j]))/m_a[j][j];
+      const double d = ri[i] - ON_ArrayDotProduct(i, ri, ri);
+      if( !(d > m_zero_tolerance) )
+        return false;
+      ri[i] = sqrt(d);
+    }
+    if( m_j1 < n )
+      RhCmnParallelFor(thread_count, RhCmnMatrixBlockCount(n - m_j1, RHCMN_MATRIX_BLOCK), FactorRows, this);
+  }
+  for( i=0; i<n; i++ )
+  {
+    double* ri = m_a[i];
+    for( j=i+1; j<n; j++ )
+      ri[j] = 0.0;
+  }
+  return true;
+}
+
+bool CRhCmnMatrixCholesky::FactorRows(void* context, int index, int)
+{
+  const CRhCmnMatrixCholesky* pThis = (const CRhCmnMatrixCholesky*)context;
+  const int i0 = pThis->m_j1 + index*RHCMN_MATRIX_BLOCK;
+  const int i1 = (i0 + RHCMN_MATRIX_BLOCK < pThis->m_a.Count()) ? i0 + RHCMN_MATRIX_BLOCK : pThis->m_a.Count();
+  for( int i=i0; i<i1; i++ )
+  {
+    double* ri = pThis->m_a[i];
+    for( int j=pThis->m_j0; j<pThis->m_j1; j++ )
+    {
+      const double* rj = pThis->m_a[j];
+      ri[j] = (ri[j] - ON_ArrayDotProduct(j, ri, rj))/rj[j];
+    }
+  }
+  return true;
+}
+
+// Solves with the factors of a square matrix left by CRhCmnMatrixLU or
+// CRhCmnMatrixCholesky, one right hand side per task. b holds rhs_count
+// columns of RowCount() values one after the other and is overwritten with
+// the solutions.
+class CRhCmnMatrixSolve
+{
+public:
+  CRhCmnMatrixSolve(const ON_Matrix& M, const int* lu_pivots, double* b);
+  void Run(int thread_count, int rhs_count);
+
+private:
+  static bool SolveColumn(void* context, int index, int thread_index);
+  void SolveLU(double* b) const;
+  void SolveCholesky(double* b) const;
+
+  ON_SimpleArray<const double*> m_a;
+  const int* m_pivots; // NULL for Cholesky factors
+  double* m_b;
+
+  // no copies
+  CRhCmnMatrixSolve(const CRhCmnMatrixSolve&);
+  CRhCmnMatrixSolve& operator=(const CRhCmnMatrixSolve&);
+};
+
+CRhCmnMatrixSolve::CRhCmnMatrixSolve(const ON_Matrix& M, const int* lu_pivots, double* b)
+: m_pivots(lu_pivots)
+, m_b(b)
+{
+  RhCmnMatrixRows(M, m_a);
+}
+
+void CRhCmnMatrixSolve::Run(int thread_count, int rhs_count)
+{
+  RhCmnParallelFor(thread_count, rhs_count, SolveColumn, this);
+}
+
+bool CRhCmnMatrixSolve::SolveColumn(void* context, int index, int)
+{
+  const CRhCmnMatrixSolve* pThis = (const CRhCmnMatrixSolve*)context;
+  double* b = pThis->m_b + ((size_t)index)*pThis->m_a.Count();
+  if( pThis->m_pivots )
+    pThis->SolveLU(b);
+  else
+    pThis->SolveCholesky(b);
+  return true;
+}
+
+// Same operations as ON_Matrix::RowReduce(zero_tolerance, B, pivot) followed
+// by ON_Matrix::BackSolve.
+void CRhCmnMatrixSolve::SolveLU(double* b) const
+{
+  const int n = m_a.Count();
+  int i, k;
+  for( k=0; k<n; k++ )
+  {
+    const int ix = m_pivots[k];
+    if( ix != k )
+    {
+      const double t = b[k];
+      b[k] = b[ix];
+      b[ix] = t;
+    }
+  }
+  for( i=0; i<n; i++ )
+  {
+    const double* ri = m_a[i];
+    double bi = b[i];
+    for( k=0; k<i; k++ )
+    {
+      const double x = -ri[k];
+      if( x != 0.0 )
+        bi += x*b[k];
+    }
+    b[i] = bi*(1.0/ri[i]);
+  }
+  for( i=n-2; i>=0; i-- )
+    b[i] = b[i] - ON_ArrayDotProduct(n-1-i, &m_a[i][i+1], &b[i+1]);
+}
+
+void CRhCmnMatrixSolve::SolveCholesky(double* b) const
+{
+  const int n = m_a.Count();
+  int i, k;
+  for( i=0; i<n; i++ )
+    b[i] = (b[i] - ON_ArrayDotProduct(i, m_a[i], b))/m_a[i][i];
+  for( i=n-1; i>=0; i-- )
+  {
+    const double* ri = m_a[i];
+    const double x = b[i]/ri[i];
+    b[i] = x;
+    for( k=0; k<i; k++ )
+      b[k] -= ri[k]*x;
+  }
+}
+
+RH_C_FUNCTION bool ON_Matrix_MultiplyBlocked(ON_Matrix* pMatrixRC, const ON_Matrix* pConstMatrixA, const ON_Matrix* pConstMatrixB, int threadCount)
+{
+  bool rc = false;
+  if( pMatrixRC && pConstMatrixA && pConstMatrixB &&
+      pConstMatrixA->ColCount() == pConstMatrixB->RowCount() &&
+      pConstMatrixA->RowCount() > 0 && pConstMatrixA->ColCount() > 0 && pConstMatrixB->ColCount() > 0 )
+  {
+    // same aliasing rules as ON_Matrix::Multiply
+    if( pMatrixRC == pConstMatrixA )
+    {
+      ON_Matrix tmp(*pConstMatrixA);
+      return ON_Matrix_MultiplyBlocked(pMatrixRC, &tmp, pConstMatrixB, threadCount);
+    }
+    if( pMatrixRC == pConstMatrixB )
+    {
+      ON_Matrix tmp(*pConstMatrixB);
+      return ON_Matrix_MultiplyBlocked(pMatrixRC, pConstMatrixA, &tmp, threadCount);
+    }
+    if( pMatrixRC->RowCount() == pConstMatrixA->RowCount() && pMatrixRC->ColCount() == pConstMatrixB->ColCount() )
+      rc = true;
+    else
+      rc = pMatrixRC->Create(pConstMatrixA->RowCount(), pConstMatrixB->ColCount());
+    if( rc )
+    {
+      CRhCmnMatrixProduct product(*pConstMatrixA, *pConstMatrixB, *pMatrixRC);
+      product.Run(threadCount);
+    }
+  }
+  return rc;
+}
+
+// pivots must have room for min(RowCount,ColCount) values
+RH_C_FUNCTION int ON_Matrix_LUFactor(ON_Matrix* pMatrix, double zeroTolerance, int threadCount, /*ARRAY*/int* pivots, double* determinant, double* pivot)
+{
+  int rc = 0;
+  if( pMatrix && pivots && determinant && pivot )
+  {
+    CRhCmnMatrixLU lu(*pMatrix, zeroTolerance);
+    rc = lu.Factor(threadCount, pivots, *determinant, *pivot);
+  }
+  return rc;
+}
+
+// pConstMatrix is a square matrix factored by ON_Matrix_LUFactor with full rank
+RH_C_FUNCTION bool ON_Matrix_LUSolve(const ON_Matrix* pConstMatrix, /*ARRAY*/const int* pivots, int rhsCount, /*ARRAY*/double* b, int threadCount)
+{
+  bool rc = false;
+  if( pConstMatrix && pivots && b && rhsCount > 0 && pConstMatrix->RowCount() == pConstMatrix->ColCount() )
+  {
+    const int n = pConstMatrix->RowCount();
+    rc = true;
+    for( int k=0; k<n && rc; k++ )
+    {
+      if( pivots[k] < k || pivots[k] >= n || (*pConstMatrix)[k][k] == 0.0 )
+        rc = false;
+    }
+    if( rc )
+    {
+      CRhCmnMatrixSolve solve(*pConstMatrix, pivots, b);
+      solve.Run(threadCount, rhsCount);
+    }
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_Matrix_CholeskyFactor(ON_Matrix* pMatrix, double zeroTolerance, int threadCount)
+{
+  bool rc = false;
+  if( pMatrix && pMatrix->RowCount() > 0 && pMatrix->RowCount() == pMatrix->ColCount() )
+  {
+    CRhCmnMatrixCholesky cholesky(*pMatrix, zeroTolerance);
+    rc = cholesky.Factor(threadCount);
+  }
+  return rc;
+}
+
+// pConstMatrix holds the factor left by ON_Matrix_CholeskyFactor
+RH_C_FUNCTION bool ON_Matrix_CholeskySolve(const ON_Matrix* pConstMatrix, int rhsCount, /*ARRAY*/double* b, int threadCount)
+{
+  bool rc = false;
+  if( pConstMatrix && b && rhsCount > 0 && pConstMatrix->RowCount() == pConstMatrix->ColCount() )
+  {
+    CRhCmnMatrixSolve solve(*pConstMatrix, NULL, b);
+    solve.Run(threadCount, rhsCount);
+    rc = true;
+  }
+  return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Sparse matrices in compressed row (CSR) form and iterative solvers for
+// systems too large for ON_Matrix.
+
+static const int RHCMN_SPARSE_BLOCK = 4096; // rows or vector entries per task
+
+class CRhCmnSparseMatrix
+{
+public:
+  CRhCmnSparseMatrix();
+
+  // Builds the matrix from count (row, column, value) triplets. Triplets
+  // with the same row and column are summed in input order. Returns false
+  // when an index is out of range.
+  bool Create(int row_count, int col_count, int count, const int* rows, const int* cols, const double* values, int thread_count);
+
+  // this = transpose(A)
+  void CreateTranspose(const CRhCmnSparseMatrix& A);
+
+  int RowCount() const { return m_row_count; }
+  int ColCount() const { return m_col_count; }
+  int NonZeroCount() const { return m_col.Count(); }
+
+  ON_SimpleArray<int> m_row_start; // RowCount()+1 offsets into m_col and m_value
+  ON_SimpleArray<int> m_col;       // columns increase along every row
+  ON_SimpleArray<double> m_value;
+
+private:
+  struct CEntry
+  {
+    int m_col;
+    int m_index; // triplet index
+  };
+  static int CompareEntry(const void* a, const void* b);
+  static bool SortRows(void* context, int index, int thread_index);
+
+  int m_row_count;
+  int m_col_count;
+
+  // used by SortRows while creating
+  ON_SimpleArray<CEntry> m_entries;
+  ON_SimpleArray<int> m_row_length;
+  const double* m_triplet_values;
+
+  // no copies
+  CRhCmnSparseMatrix(const CRhCmnSparseMatrix&);
+  CRhCmnSparseMatrix& operator=(const CRhCmnSparseMatrix&);
+};
+
+CRhCmnSparseMatrix::CRhCmnSparseMatrix()
+: m_row_count(0)
+, m_col_count(0)
+, m_triplet_values(NULL)
+{
+}
+
+int CRhCmnSparseMatrix::CompareEntry(const void* a, const void* b)
+{
+  const CEntry* ea = (const CEntry*)a;
+  const CEntry* eb = (const CEntry*)b;
+  if( ea->m_col < eb->m_col )
+    return -1;
+  if( ea->m_col > eb->m_col )
+    return 1;
+  if( ea->m_index < eb->m_index )
+    return -1;
+  if( ea->m_index > eb->m_index )
+    return 1;
+  return 0;
+}
+
+bool CRhCmnSparseMatrix::SortRows(void* context, int index, int)
+{
+  CRhCmnSparseMatrix* pThis = (CRhCmnSparseMatrix*)context;
+  const int r0 = index*RHCMN_SPARSE_BLOCK;
+  const int r1 = (r0 + RHCMN_SPARSE_BLOCK < pThis->m_row_count) ? r0 + RHCMN_SPARSE_BLOCK : pThis->m_row_count;
+  for( int r=r0; r<r1; r++ )
+  {
+    const int s = pThis->m_row_start[r];
+    const int e = pThis->m_row_start[r+1];
+    CEntry* entry = pThis->m_entries.Array() + s;
+    const int n = e - s;
+    if( n > 16 )
+      ON_qsort(entry, n, sizeof(CEntry), CompareEntry);
+    else
+    {
+      // entries are already in triplet order, insertion sort on the column keeps it
+      for( int i=1; i<n; i++ )
+      {
+        const CEntry t = entry[i];
+        int j = i;
+        for( ; j>0 && entry[j-1].m_col > t.m_col; j-- )
+          entry[j] = entry[j-1];
+        entry[j] = t;
+      }
+    }
+
+    // sum duplicates in triplet order
+    int count = 0;
+    for( int i=0; i<n; i++ )
+    {
+      const double v = pThis->m_triplet_values[entry[i].m_index];
+      if( count > 0 && pThis->m_col[s+count-1] == entry[i].m_col )
+        pThis->m_value[s+count-1] += v;
+      else
+      {
+        pThis->m_col[s+count] = entry[i].m_col;
+        pThis->m_value[s+count] = v;
+        count++;
+      }
+    }
+    pThis->m_row_length[r] = count;
+  }
+  return true;
+}
+
+bool CRhCmnSparseMatrix::Create(int row_count, int col_count, int count, const int* rows, const int* cols, const double* values, int thread_count)
+{
+  m_row_count = 0;
+  m_col_count = 0;
+  m_row_start.SetCount(0);
+  m_col.SetCount(0);
+  m_value.SetCount(0);
+  if( row_count < 0 || col_count < 0 || count < 0 )
+    return false;
+  if( count > 0 && (0 == rows || 0 == cols || 0 == values) )
+    return false;
+  int i, r;
+  for( i=0; i<count; i++ )
+  {
+    if( rows[i] < 0 || rows[i] >= row_count || cols[i] < 0 || cols[i] >= col_count )
+      return false;
+  }
+
+  m_row_count = row_count;
+  m_col_count = col_count;
+
+  // counting sort by row, triplet order is kept inside every row
+  m_row_start.Reserve(row_count+1);
+  m_row_start.SetCount(row_count+1);
+  m_row_start.Zero();
+  for( i=0; i<count; i++ )
+    m_row_start[rows[i]+1]++;
+  for( r=0; r<row_count; r++ )
+    m_row_start[r+1] += m_row_start[r];
+
+  ON_SimpleArray<int> next(row_count);
+  next.Append(row_count, m_row_start.Array());
+  m_entries.Reserve(count);
+  m_entries.SetCount(count);
+  for( i=0; i<count; i++ )
+  {
+    CEntry& entry = m_entries[next[rows[i]]++];
+    entry.m_col = cols[i];
+    entry.m_index = i;
+  }
+
+  // sort the rows by column and sum duplicates in parallel
+  m_col.Reserve(count);
+  m_col.SetCount(count);
+  m_value.Reserve(count);
+  m_value.SetCount(count);
+  m_row_length.Reserve(row_count);
+  m_row_length.SetCount(row_count);
+  m_triplet_values = values;
+  RhCmnParallelFor(thread_count, (row_count + RHCMN_SPARSE_BLOCK - 1)/RHCMN_SPARSE_BLOCK, SortRows, this);
+  m_triplet_values = NULL;
+  m_entries.Destroy();
+
+  // squeeze out the room left by duplicates
+  int nonzero_count = 0;
+  for( r=0; r<row_count; r++ )
+  {
+    const int s = m_row_start[r];
+    const int n = m_row_length[r];
+    m_row_start[r] = nonzero_count;
+    if( s != nonzero_count )
+    {
+      for( i=0; i<n; i++ )
+      {
+        m_col[nonzero_count+i] = m_col[s+i];
+        m_value[nonzero_count+i] = m_value[s+i];
+      }
+    }
+    nonzero_count += n;
+  }
+  m_row_start[row_count] = nonzero_count;
+  m_col.SetCount(nonzero_count);
+  m_value.SetCount(nonzero_count);
+  m_row_length.Destroy();
+  return true;
+}
+
+void CRhCmnSparseMatrix::CreateTranspose(const CRhCmnSparseMatrix& A)
+{
+  const int nonzero_count = A.NonZeroCount();
+  int r, c, i;
+  m_row_count = A.m_col_count;
+  m_col_count = A.m_row_count;
+  m_row_start.Reserve(m_row_count+1);
+  m_row_start.SetCount(m_row_count+1);
+  m_row_start.Zero();
+  for( i=0; i<nonzero_count; i++ )
+    m_row_start[A.m_col[i]+1]++;
+  for( c=0; c<m_row_count; c++ )
+    m_row_start[c+1] += m_row_start[c];
+
+  ON_SimpleArray<int> next(m_row_count);
+  next.Append(m_row_count, m_row_start.Array());
+  m_col.Reserve(nonzero_count);
+  m_col.SetCount(nonzero_count);
+  m_value.Reserve(nonzero_count);
+  m_value.SetCount(nonzero_count);
+  // rows of A in increasing order keep the columns of the transpose sorted
+  for( r=0; r<A.m_row_count; r++ )
+  {
+    for( i=A.m_row_start[r]; i<A.m_row_start[r+1]; i++ )
+    {
+      const int j = next[A.m_col[i]]++;
+      m_col[j] = r;
+      m_value[j] = A.m_value[i];
+    }
+  }
+}
+
+// Sparse matrix times vector products and Krylov solvers. Vectors are
+// processed in fixed blocks of RHCMN_SPARSE_BLOCK entries with
+// RhCmnParallelFor and dot products are summed block by block in order, so
+// the results do not depend on the thread count.
+class CRhCmnSparseSolver
+{
+public:
+  CRhCmnSparseSolver(const CRhCmnSparseMatrix& A, int thread_count);
+
+  // y = A*x or y = transpose(A)*x
+  void Multiply(const double* x, double* y, bool bTranspose);
+
+  // Jacobi preconditioned conjugate gradient for symmetric positive
+  // definite A. x is the initial guess and gets the solution. Stops when
+  // |b - A*x| <= tolerance*|b|. residual gets |b - A*x|/|b|.
+  bool ConjugateGradient(const double* b, double* x, double tolerance, int max_iterations, bool bJacobi, int& iterations, double& residual);
+
+  // LSQR (Paige and Saunders) for min |A*dx - r|^2 + damping^2*|dx|^2
+  // where r = b - A*x, x is the initial guess and dx is added to it. Stops
+  // when the system is solved or the least squares optimality test passes,
+  // both relative to tolerance. residual gets the estimate of |b - A*x|/|b|.
+  bool LSQR(const double* b, double* x, double damping, double tolerance, int max_iterations, int& iterations, double& residual);
+
+private:
+  enum
+  {
+    op_multiply,    // v1 = s*M*v0 + t*v1 (v1 = s*M*v0 when t = 0), sums v1.v1 and v0.v1
+    op_dot,         // sums v0.v1
+    op_scale,       // v0 *= s
+    op_xpay,        // v1 = v0 + s*v1
+    op_cg_update,   // v0 += s*v1 and v2 -= s*v3 unless v0 is NULL, v4 = m_diagonal*v2, sums v2.v2 and v2.v4
+    op_lsqr_update  // v0 += s*v1, v1 = v2 + t*v1
+  };
+
+  void Run(int op, int count, const CRhCmnSparseMatrix* M, double s, double t, const double* v0, const double* v1, const double* v2 = 0, const double* v3 = 0, const double* v4 = 0);
+  static bool RunBlock(void* context, int index, int thread_index);
+  const CRhCmnSparseMatrix& Transpose();
+
+  const CRhCmnSparseMatrix& m_A;
+  CRhCmnSparseMatrix m_AT; // created when needed
+  bool m_bHaveTranspose;
+  const int m_thread_count;
+  const double* m_diagonal; // inverse diagonal for op_cg_update, NULL for none
+
+  // current operation
+  int m_op;
+  int m_count;
+  const CRhCmnSparseMatrix* m_M;
+  double m_s;
+  double m_t;
+  double* m_v[5];
+  ON_SimpleArray<double> m_partial; // two sums per block
+  double m_sum[2];
+
+  // no copies
+  CRhCmnSparseSolver(const CRhCmnSparseSolver&);
+  CRhCmnSparseSolver& operator=(const CRhCmnSparseSolver&);
+};
+
+CRhCmnSparseSolver::CRhCmnSparseSolver(const CRhCmnSparseMatrix& A, int thread_count)
+: m_A(A)
+, m_bHaveTranspose(false)
+, m_thread_count(thread_count)
+, m_diagonal(NULL)
+, m_op(op_dot)
+, m_count(0)
+, m_M(NULL)
+, m_s(0.0)
+, m_t(0.0)
+{
+  m_v[0] = m_v[1] = m_v[2] = m_v[3] = m_v[4] = NULL;
+  m_sum[0] = m_sum[1] = 0.0;
+}
+
+const CRhCmnSparseMatrix& CRhCmnSparseSolver::Transpose()
+{
+  if( !m_bHaveTranspose )
+  {
+    m_AT.CreateTranspose(m_A);
+    m_bHaveTranspose = true;
+  }
+  return m_AT;
+}
+
+void CRhCmnSparseSolver::Run(int op, int count, const CRhCmnSparseMatrix* M, double s, double t, const double* v0, const double* v1, const double* v2, const double* v3, const double* v4)
+{
+  m_op = op;
+  m_count = count;
+  m_M = M;
+  m_s = s;
+  m_t = t;
+  m_v[0] = const_cast<double*>(v0);
+  m_v[1] = const_cast<double*>(v1);
+  m_v[2] = const_cast<double*>(v2);
+  m_v[3] = const_cast<double*>(v3);
+  m_v[4] = const_cast<double*>(v4);
+  const int block_count = (count + RHCMN_SPARSE_BLOCK - 1)/RHCMN_SPARSE_BLOCK;
+  m_partial.Reserve(2*block_count);
+  m_partial.SetCount(2*block_count);
+  RhCmnParallelFor(m_thread_count, block_count, RunBlock, this);
+  m_sum[0] = m_sum[1] = 0.0;
+  for( int i=0; i<block_count; i++ )
+  {
+    m_sum[0] += m_partial[2*i];
+    m_sum[1] += m_partial[2*i+1];
+  }
+}
+
+bool CRhCmnSparseSolver::RunBlock(void* context, int index, int)
+{
+  CRhCmnSparseSolver* pThis = (CRhCmnSparseSolver*)context;
+  const int i0 = index*RHCMN_SPARSE_BLOCK;
+  const int i1 = (i0 + RHCMN_SPARSE_BLOCK < pThis->m_count) ? i0 + RHCMN_SPARSE_BLOCK : pThis->m_count;
+  const double s = pThis->m_s;
+  const double t = pThis->m_t;
+  double* v0 = pThis->m_v[0];
+  double* v1 = pThis->m_v[1];
+  double* v2 = pThis->m_v[2];
+  double* v3 = pThis->m_v[3];
+  double* v4 = pThis->m_v[4];
+  double sum0 = 0.0, sum1 = 0.0;
+  int i;
+  switch( pThis->m_op )
+  {
+  case op_multiply:
+    {
+      const CRhCmnSparseMatrix& M = *pThis->m_M;
+      const bool bSquare = M.RowCount() == M.ColCount();
+      const int* row_start = M.m_row_start.Array();
+      const int* col = M.m_col.Array();
+      const double* value = M.m_value.Array();
+      for( i=i0; i<i1; i++ )
+      {
+        double y = 0.0;
+        for( int k=row_start[i]; k<row_start[i+1]; k++ )
+          y += value[k]*v0[col[k]];
+        y = (0.0 == t) ? s*y : s*y + t*v1[i];
+        v1[i] = y;
+        sum0 += y*y;
+        if( bSquare )
+          sum1 += v0[i]*y;
+      }
+    }
+    break;
+
+  case op_dot:
+    for( i=i0; i<i1; i++ )
+      sum0 += v0[i]*v1[i];
+    break;
+
+  case op_scale:
+    for( i=i0; i<i1; i++ )
+      v0[i] *= s;
+    break;
+
+  case op_xpay:
+    for( i=i0; i<i1; i++ )
+      v1[i] = v0[i] + s*v1[i];
+    break;
+
+  case op_cg_update:
+    {
+      const double* d = pThis->m_diagonal;
+      for( i=i0; i<i1; i++ )
+      {
+        if( v0 )
+        {
+          v0[i] += s*v1[i];
+          v2[i] -= s*v3[i];
+        }
+        const double r = v2[i];
+        const double z = d ? d[i]*r : r;
+        v4[i] = z;
+        sum0 += r*r;
+        sum1 += r*z;
+      }
+    }
+    break;
+
+  case op_lsqr_update:
+    for( i=i0; i<i1; i++ )
+    {
+      v0[i] += s*v1[i];
+      v1[i] = v2[i] + t*v1[i];
+    }
+    break;
+  }
+  pThis->m_partial[2*index] = sum0;
+  pThis->m_partial[2*index+1] = sum1;
+  return true;
+}
+
+void CRhCmnSparseSolver::Multiply(const double* x, double* y, bool bTranspose)
+{
+  const CRhCmnSparseMatrix& M = bTranspose ? Transpose() : m_A;
+  Run(op_multiply, M.RowCount(), &M, 1.0, 0.0, x, y);
+}
+
+bool CRhCmnSparseSolver::ConjugateGradient(const double* b, double* x, double tolerance, int max_iterations, bool bJacobi, int& iterations, double& residual)
+{
+  const int n = m_A.RowCount();
+  iterations = 0;
+  residual = 0.0;
+  if( n != m_A.ColCount() )
+    return false;
+
+  Run(op_dot, n, NULL, 0.0, 0.0, b, b);
+  const double bnorm = sqrt(m_sum[0]);
+  if( !(bnorm > 0.0) )
+  {
+    for( int i=0; i<n; i++ )
+      x[i] = 0.0;
+    return true;
+  }
+
+  ON_SimpleArray<double> diagonal;
+  if( bJacobi )
+  {
+    diagonal.Reserve(n);
+    diagonal.SetCount(n);
+    for( int i=0; i<n; i++ )
+    {
+      double d = 0.0;
+      for( int k=m_A.m_row_start[i]; k<m_A.m_row_start[i+1]; k++ )
+      {
+        if( m_A.m_col[k] == i )
+          d += m_A.m_value[k];
+      }
+      diagonal[i] = (d > 0.0) ? 1.0/d : 1.0;
+    }
+    m_diagonal = diagonal.Array();
+  }
+
+  ON_SimpleArray<double> r(n), z(n), p(n), q(n);
+  r.Append(n, b);
+  z.SetCount(n);
+  q.SetCount(n);
+
+  // r = b - A*x, z = M^-1*r
+  Run(op_multiply, n, &m_A, -1.0, 1.0, x, r.Array());
+  Run(op_cg_update, n, NULL, 0.0, 0.0, NULL, NULL, r.Array(), NULL, z.Array());
+  residual = sqrt(m_sum[0])/bnorm;
+  double rz = m_sum[1];
+  p.Append(n, z.Array());
+
+  while( iterations < max_iterations && residual > tolerance )
+  {
+    Run(op_multiply, n, &m_A, 1.0, 0.0, p.Array(), q.Array());
+    const double pq = m_sum[1];
+    if( !(pq > 0.0) )
+      break; // A is not positive definite
+    const double alpha = rz/pq;
+    Run(op_cg_update, n, NULL, alpha, 0.0, x, p.Array(), r.Array(), q.Array(), z.Array());
+    iterations++;
+    residual = sqrt(m_sum[0])/bnorm;
+    const double beta = m_sum[1]/rz;
+    rz = m_sum[1];
+    Run(op_xpay, n, NULL, beta, 0.0, z.Array(), p.Array());
+  }
+  m_diagonal = NULL;
+  return residual <= tolerance;
+}
+
+bool CRhCmnSparseSolver::LSQR(const double* b, double* x, double damping, double tolerance, int max_iterations, int& iterations, double& residual)
+{
+  const int m = m_A.RowCount();
+  const int n = m_A.ColCount();
+  const CRhCmnSparseMatrix& AT = Transpose();
+  iterations = 0;
+  residual = 0.0;
+
+  Run(op_dot, m, NULL, 0.0, 0.0, b, b);
+  const double bnorm = sqrt(m_sum[0]);
+  if( !(bnorm > 0.0) )
+  {
+    for( int i=0; i<n; i++ )
+      x[i] = 0.0;
+    return true;
+  }
+
+  // u = b - A*x, beta*u = u, alpha*v = transpose(A)*u, w = v
+  ON_SimpleArray<double> u(m), v(n), w(n);
+  u.Append(m, b);
+  v.SetCount(n);
+  Run(op_multiply, m, &m_A, -1.0, 1.0, x, u.Array());
+  double beta = sqrt(m_sum[0]);
+  residual = beta/bnorm;
+  if( !(beta > 0.0) )
+    return true;
+  Run(op_scale, m, NULL, 1.0/beta, 0.0, u.Array(), NULL);
+  Run(op_multiply, n, &AT, 1.0, 0.0, u.Array(), v.Array());
+  double alpha = sqrt(m_sum[0]);
+  if( !(alpha > 0.0) )
+    return true; // x is already a least squares solution
+  Run(op_scale, n, NULL, 1.0/alpha, 0.0, v.Array(), NULL);
+  w.Append(n, v.Array());
+
+  const double damp2 = damping*damping;
+  double phibar = beta, rhobar = alpha;
+  double anorm2 = 0.0, res2 = 0.0;
+  bool rc = false;
+  while( iterations < max_iterations && !rc )
+  {
+    // next step of the bidiagonalization
+    Run(op_multiply, m, &m_A, 1.0, -alpha, v.Array(), u.Array());
+    beta = sqrt(m_sum[0]);
+    if( beta > 0.0 )
+      Run(op_scale, m, NULL, 1.0/beta, 0.0, u.Array(), NULL);
+    anorm2 += alpha*alpha + beta*beta + damp2;
+    Run(op_multiply, n, &AT, 1.0, -beta, u.Array(), v.Array());
+    alpha = sqrt(m_sum[0]);
+    if( alpha > 0.0 )
+      Run(op_scale, n, NULL, 1.0/alpha, 0.0, v.Array(), NULL);
+
+    // eliminate the damping parameter, then the subdiagonal
+    double rhobar1 = rhobar, psi = 0.0;
+    if( damping > 0.0 )
+    {
+      rhobar1 = sqrt(rhobar*rhobar + damp2);
+      psi = (damping/rhobar1)*phibar;
+      phibar = (rhobar/rhobar1)*phibar;
+    }
+    const double rho = sqrt(rhobar1*rhobar1 + beta*beta);
+    const double cs = rhobar1/rho;
+    const double sn = beta/rho;
+    const double theta = sn*alpha;
+    rhobar = -cs*alpha;
+    const double phi = cs*phibar;
+    phibar = sn*phibar;
+
+    // x += (phi/rho)*w, w = v - (theta/rho)*w
+    Run(op_lsqr_update, n, NULL, phi/rho, -theta/rho, x, w.Array(), v.Array());
+    iterations++;
+
+    res2 += psi*psi;
+    const double rnorm = sqrt(phibar*phibar + res2);
+    const double arnorm = alpha*fabs(sn*phi);
+    residual = rnorm/bnorm;
+    if( residual <= tolerance )
+      rc = true;
+    else if( rnorm > 0.0 && arnorm <= tolerance*sqrt(anorm2)*rnorm )
+      rc = true;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION CRhCmnSparseMatrix* ON_SparseMatrix_New(int rowCount, int columnCount, int count, /*ARRAY*/const int* rows, /*ARRAY*/const int* columns, /*ARRAY*/const double* values, int threadCount)
+{
+  CRhCmnSparseMatrix* rc = new CRhCmnSparseMatrix();
+  if( !rc->Create(rowCount, columnCount, count, rows, columns, values, threadCount) )
+  {
+    delete rc;
+    rc = NULL;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION void ON_SparseMatrix_Delete(CRhCmnSparseMatrix* pMatrix)
+{
+  if( pMatrix )
+    delete pMatrix;
+}
+
+RH_C_FUNCTION int ON_SparseMatrix_NonZeroCount(const CRhCmnSparseMatrix* pConstMatrix)
+{
+  if( pConstMatrix )
+    return pConstMatrix->NonZeroCount();
+  return 0;
+}
+
+// rowStart gets RowCount+1 values, columns and values NonZeroCount values
+RH_C_FUNCTION void ON_SparseMatrix_GetCompressedRows(const CRhCmnSparseMatrix* pConstMatrix, /*ARRAY*/int* rowStart, /*ARRAY*/int* columns, /*ARRAY*/double* values)
+{
+  if( pConstMatrix && rowStart && columns && values )
+  {
+    memcpy(rowStart, pConstMatrix->m_row_start.Array(), (pConstMatrix->RowCount()+1)*sizeof(rowStart[0]));
+    memcpy(columns, pConstMatrix->m_col.Array(), pConstMatrix->NonZeroCount()*sizeof(columns[0]));
+    memcpy(values, pConstMatrix->m_value.Array(), pConstMatrix->NonZeroCount()*sizeof(values[0]));
+  }
+}
+
+RH_C_FUNCTION bool ON_SparseMatrix_Multiply(const CRhCmnSparseMatrix* pConstMatrix, /*ARRAY*/const double* x, /*ARRAY*/double* y, bool transpose, int threadCount)
+{
+  bool rc = false;
+  if( pConstMatrix && x && y )
+  {
+    CRhCmnSparseSolver solver(*pConstMatrix, threadCount);
+    solver.Multiply(x, y, transpose);
+    rc = true;
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_SparseMatrix_SolveCG(const CRhCmnSparseMatrix* pConstMatrix, /*ARRAY*/const double* b, /*ARRAY*/double* x, double tolerance, int maxIterations, bool jacobi, int threadCount, int* iterations, double* residual)
+{
+  bool rc = false;
+  if( pConstMatrix && b && x && iterations && residual )
+  {
+    CRhCmnSparseSolver solver(*pConstMatrix, threadCount);
+    rc = solver.ConjugateGradient(b, x, tolerance, maxIterations, jacobi, *iterations, *residual);
+  }
+  return rc;
+}
+
+RH_C_FUNCTION bool ON_SparseMatrix_SolveLSQR(const CRhCmnSparseMatrix* pConstMatrix, /*ARRAY*/const double* b, /*ARRAY*/double* x, double damping, double tolerance, int maxIterations, int threadCount, int* iterations, double* residual)
+{
+  bool rc = false;
+  if( pConstMatrix && b && x && iterations && residual )
+  {
+    CRhCmnSparseSolver solver(*pConstMatrix, threadCount);
+    rc = solver.LSQR(b, x, damping, tolerance, maxIterations, *iterations, *residual);
+  }
+  return rc;
+}
@@ -0,0 +1,187 @@
+#include "StdAfx.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+int RhCmnAtomicAdd(volatile int* value, int amount)
+{
+#if defined(_WIN32)
+  return (int)InterlockedExchangeAdd((volatile LONG*)value, (LONG)amount) + amount;
+#else
+  return __sync_add_and_fetch(value, amount);
+#endif
+}
+
+#if defined(_WIN32)
+// critical sections have no static initializer
+class CRhCmnCriticalSection
+{
+public:
+  CRhCmnCriticalSection() { ::InitializeCriticalSection(&m_cs); }
+  ~CRhCmnCriticalSection() { ::DeleteCriticalSection(&m_cs); }
+  CRITICAL_SECTION m_cs;
+};
+static CRhCmnCriticalSection g_cache_lock;
+#else
+static pthread_mutex_t g_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+CRhCmnCacheLock::CRhCmnCacheLock()
+{
+#if defined(_WIN32)
+  ::EnterCriticalSection(&g_cache_lock.m_cs);
+#else
+  pthread_mutex_lock(&g_cache_lock);
+#endif
+}
+
+CRhCmnCacheLock::~CRhCmnCacheLock()
+{
+#if defined(_WIN32)
+  ::LeaveCriticalSection(&g_cache_lock.m_cs);
+#else
+  pthread_mutex_unlock(&g_cache_lock);
+#endif
+}
+
+int RhCmnMaxThreadCount()
+{
+  int rc = 1;
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  memset(&info, 0, sizeof(info));
+  ::GetSystemInfo(&info);
+  rc = (int)info.dwNumberOfProcessors;
+#else
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if( n > 0 && n < 1024 )
+    rc = (int)n;
+#endif
+  return rc < 1 ? 1 : rc;
+}
+
+struct CRhCmnParallelForData
+{
+  RHCMN_PARALLEL_PROC m_func;
+  void* m_context;
+  int m_count;
+  int m_block_size;
+  volatile int m_next;   // first index of the next block to hand out
+  volatile int m_cancel; // set when any call to m_func returns false
+};
+
+struct CRhCmnParallelForThread
+{
+  CRhCmnParallelForData* m_data;
+  int m_thread_index;
+};
+
+static void RhCmnParallelForRun(CRhCmnParallelForData* data, int thread_index)
+{
+  while( 0 == data->m_cancel )
+  {
+    int end = RhCmnAtomicAdd(&data->m_next, data->m_block_size);
+    int start = end - data->m_block_size;
+    if( start >= data->m_count )
+      break;
+    if( end > data->m_count )
+      end = data->m_count;
+    for( int i=start; i<end; i++ )
+    {
+      if( !data->m_func(data->m_context, i, thread_index) )
+      {
+        RhCmnAtomicAdd(&data->m_cancel, 1);
+        break;
+      }
+    }
+  }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI RhCmnParallelForThreadProc(LPVOID parameter)
+{
+  CRhCmnParallelForThread* t = (CRhCmnParallelForThread*)parameter;
+  RhCmnParallelForRun(t->m_data, t->m_thread_index);
+  return 0;
+}
+#else
+static void* RhCmnParallelForThreadProc(void* parameter)
+{
+  CRhCmnParallelForThread* t = (CRhCmnParallelForThread*)parameter;
+  RhCmnParallelForRun(t->m_data, t->m_thread_index);
+  return 0;
+}
+#endif
+
+bool RhCmnParallelFor(int thread_count, int count, RHCMN_PARALLEL_PROC func, void* context)
+{
+  if( 0 == func )
+    return false;
+  if( count < 1 )
+    return true;
+  if( thread_count < 1 )
+    thread_count = RhCmnMaxThreadCount();
+  if( thread_count > count )
+    thread_count = count;
+
+  CRhCmnParallelForData data;
+  data.m_func = func;
+  data.m_context = context;
+  data.m_count = count;
+  data.m_next = 0;
+  data.m_cancel = 0;
+  // several blocks per thread keeps the threads busy when iterations
+  // take different amounts of time
+  data.m_block_size = count / (thread_count*8);
+  if( data.m_block_size < 1 )
+    data.m_block_size = 1;
+
+  if( 1 == thread_count )
+  {
+    RhCmnParallelForRun(&data, 0);
+    return 0 == data.m_cancel;
+  }
+
+  // The calling thread is thread 0. If a worker thread cannot be started
+  // the remaining threads simply pick up its share of the work.
+  ON_SimpleArray<CRhCmnParallelForThread> threads(thread_count);
+  threads.SetCount(thread_count);
+  for( int i=0; i<thread_count; i++ )
+  {
+    threads[i].m_data = &data;
+    threads[i].m_thread_index = i;
+  }
+
+#if defined(_WIN32)
+  ON_SimpleArray<HANDLE> handles(thread_count);
+  for( int i=1; i<thread_count; i++ )
+  {
+    HANDLE h = ::CreateThread(NULL, 0, RhCmnParallelForThreadProc, threads.At(i), 0, NULL);
+    if( h )
+      handles.Append(h);
+  }
+  RhCmnParallelForRun(&data, 0);
+  for( int i=0; i<handles.Count(); i++ )
+  {
+    ::WaitForSingleObject(handles[i], INFINITE);
+    ::CloseHandle(handles[i]);
+  }
+#else
+  ON_SimpleArray<pthread_t> handles(thread_count);
+  for( int i=1; i<thread_count; i++ )
+  {
+    pthread_t h;
+    if( 0 == pthread_create(&h, NULL, RhCmnParallelForThreadProc, threads.At(i)) )
+      handles.Append(h);
+  }
+  RhCmnParallelForRun(&data, 0);
+  for( int i=0; i<handles.Count(); i++ )
+    pthread_join(handles[i], NULL);
+#endif
+
+  return 0 == data.m_cancel;
+}
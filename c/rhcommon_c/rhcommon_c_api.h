@@ -179,4 +179,141 @@ private:
 #if defined(ON_COMPILER_ANDROIDNDK)
   ON_SimpleArray<ON__UINT16> m_android;
 #endif
-};
\ No newline at end of file
+};
+
+// Minimal parallel loop used by the bulk functions in this library.
+// RhCmnParallelFor calls func(context, index, thread_index) once for every
+// index in [0,count) using up to thread_count threads, the calling thread
+// included. thread_index is always less than thread_count so it can be used
+// to address per thread result buffers. When func returns false no more
+// iterations are started and RhCmnParallelFor returns false.
+// A thread_count < 1 means RhCmnMaxThreadCount().
+typedef bool (*RHCMN_PARALLEL_PROC)(void* context, int index, int thread_index);
+int RhCmnMaxThreadCount();
+bool RhCmnParallelFor(int thread_count, int count, RHCMN_PARALLEL_PROC func, void* context);
+
+// Adds amount to *value as one atomic operation and returns the new value.
+int RhCmnAtomicAdd(volatile int* value, int amount);
+
+// Process wide lock for caches that are built lazily and kept with geometry
+// as user data (on_mesh.cpp, on_brep.cpp), so two threads that query the
+// same object for the first time do not both build and store a cache. Hold
+// it only while looking up or building a cache; it is not reentrant.
+class CRhCmnCacheLock
+{
+public:
+  CRhCmnCacheLock();
+  ~CRhCmnCacheLock();
+private:
+  // no copies
+  CRhCmnCacheLock(const CRhCmnCacheLock&);
+  CRhCmnCacheLock& operator=(const CRhCmnCacheLock&);
+};
+
+// m_application_uuid of the cache user data above
+extern const ON_UUID RhCmnCacheApplicationId;
+
+// RTree helpers shared between files (on_rtree.cpp)
+typedef bool (*RHCMN_RTREE_RESULTPROC)(void* context, ON__INT_PTR id);
+
+// Ray and segment search over an ON_RTree. Points on the ray are
+// from + t*dir for m_t0 <= t <= m_t1.
+typedef bool (*RHCMN_RTREE_RAYRESULTPROC)(void* context, ON__INT_PTR id, double t, double* limit);
+
+class CRhCmnRTreeRaySearch
+{
+public:
+  CRhCmnRTreeRaySearch();
+
+  void SetRay(const double from[3], const double dir[3], double t0, double t1);
+  bool Search(const ON_RTree& tree, RHCMN_RTREE_RAYRESULTPROC resultCallback, void* context);
+
+  // Returns false when the ray misses box between m_t0 and m_t1, otherwise
+  // *t is the parameter where the ray enters box.
+  bool Clip(const ON_RTreeBBox& box, double* t) const;
+
+  double m_t0;
+  double m_t1;
+
+private:
+  struct CHeapItem
+  {
+    double m_t;
+    const ON_RTreeNode* m_node;     // non-null for nodes
+    const ON_RTreeBranch* m_leaf;   // non-null for elements
+  };
+
+  void Push(double t, const ON_RTreeNode* node, const ON_RTreeBranch* leaf);
+  CHeapItem Pop();
+
+  double m_from[3];
+  double m_dir[3];
+  double m_inv[3];
+  ON_SimpleArray<CHeapItem> m_heap; // binary min heap on m_t
+};
+
+// Position independent, read only copy of an ON_RTree.
+struct CRhCmnPackedRTreeHeader;
+struct CRhCmnPackedRTreeNode;
+
+class CRhCmnPackedRTree
+{
+public:
+  CRhCmnPackedRTree();
+  ~CRhCmnPackedRTree();
+
+  // Number of bytes needed to pack tree. Returns 0 if the tree is
+  // too large to pack into a single block.
+  static unsigned int PackedSizeOf(const ON_RTree& tree);
+
+  // Packs tree into buffer. buffer_size must be at least PackedSizeOf(tree).
+  static bool Pack(const ON_RTree& tree, unsigned int buffer_size, void* buffer);
+
+  // Writes tree to archive in the same format as Write() so it can be read
+  // back with Read().
+  static bool WritePacked(const ON_RTree& tree, ON_BinaryArchive& archive);
+
+  // Searches the packed tree in buffer. When bCopy is false the caller must
+  // keep buffer valid and unchanged for the lifetime of this object. Buffers
+  // that are not 8 byte aligned are always copied.
+  bool Attach(const void* buffer, unsigned int buffer_size, bool bCopy, bool bVerifyCrc);
+  void Destroy();
+
+  bool Write(ON_BinaryArchive& archive) const;
+  bool Read(ON_BinaryArchive& archive);
+
+  bool Search(const ON_RTreeBBox* a_rect, RHCMN_RTREE_RESULTPROC resultCallback, void* a_context) const;
+  bool Search(const ON_RTreeSphere* a_sphere, RHCMN_RTREE_RESULTPROC resultCallback, void* a_context) const;
+  // Elements are reported in tree order, not front to back. Lowering the
+  // limit in the callback prunes everything behind it.
+  bool SearchRay(CRhCmnRTreeRaySearch& ray, RHCMN_RTREE_RAYRESULTPROC resultCallback, void* a_context) const;
+
+  int ElementCount() const;
+  ON_BoundingBox BoundingBox() const;
+  unsigned int SizeOf() const;
+
+private:
+  bool SetBuffer(const void* buffer, unsigned int buffer_size, bool bOwnsBuffer, bool bVerifyCrc);
+  bool SearchHelper(int node_index, int level, const ON_RTreeBBox* a_rect, RHCMN_RTREE_RESULTPROC resultCallback, void* a_context) const;
+  bool SearchHelper(int node_index, int level, const ON_RTreeSphere* a_sphere, RHCMN_RTREE_RESULTPROC resultCallback, void* a_context) const;
+  bool SearchRayHelper(int node_index, int level, CRhCmnRTreeRaySearch& ray, RHCMN_RTREE_RAYRESULTPROC resultCallback, void* a_context) const;
+
+  const CRhCmnPackedRTreeHeader* m_header;
+  const CRhCmnPackedRTreeNode* m_nodes;
+  unsigned int m_buffer_size;
+  void* m_owned_buffer;
+
+private:
+  // no copies
+  CRhCmnPackedRTree(const CRhCmnPackedRTree&);
+  CRhCmnPackedRTree& operator=(const CRhCmnPackedRTree&);
+};
+
+// Ray queries that use the mesh face tree cache (on_mesh.cpp). Points on the
+// ray are P + t*V for 0 <= t <= t1. Returns false when mesh has no tree
+// cache. With bFirstHit *t is the closest hit (-1 for none) and face_indices
+// gets the faces hit there, otherwise *crossings is the number of faces hit.
+bool RhCmnMeshCachedRayIntersect(const ON_Mesh& mesh, const ON_3dPoint& P, const ON_3dVector& V, double t1, bool bFirstHit, double* t, int* crossings, ON_SimpleArray<int>* face_indices);
+
+// Closest point Q to P on triangle ABC (on_mesh.cpp).
+void RhCmnClosestPointOnTriangle(const double P[3], const double A[3], const double B[3], const double C[3], double Q[3]);
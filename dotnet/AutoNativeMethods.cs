@@ -1567,6 +1567,18 @@ internal partial class UnsafeNativeMethods
   //const ON_Mesh* ON_Extrusion_GetMesh(const ON_Extrusion* pConstExtrusion, int meshtype)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern IntPtr ON_Extrusion_GetMesh(IntPtr pConstExtrusion, int meshtype);
+
+  //ON_Mesh* ON_Extrusion_CreateMesh(const ON_Extrusion* pConstExtrusion, double tolerance, double angleTolerance)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_Extrusion_CreateMesh(IntPtr pConstExtrusion, double tolerance, double angleTolerance);
+
+  //int ON_Extrusion_CreateMeshes(const ON_SimpleArray<const ON_Geometry*>* pConstGeometry, double tolerance, double angleTolerance, int threadCount, ON_SimpleArray<ON_Mesh*>* meshes)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Extrusion_CreateMeshes(IntPtr pConstGeometry, double tolerance, double angleTolerance, int threadCount, IntPtr meshes);
+
+  //int ON_Extrusion_GroupByProfile(const ON_SimpleArray<const ON_Geometry*>* pConstGeometry, int threadCount, /*ARRAY*/int* groups)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Extrusion_GroupByProfile(IntPtr pConstGeometry, int threadCount, [In,Out] int[] groups);
   #endregion
 
 
@@ -1759,10 +1771,18 @@ internal partial class UnsafeNativeMethods
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_Brep_IsValidTest(IntPtr pConstBrep, int which_test, IntPtr pStringHolder);
 
+  //int ON_Brep_ValidateBreps(const ON_SimpleArray<const ON_Brep*>* pConstBreps, int level, int threadCount, ON_SimpleArray<int>* errors)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Brep_ValidateBreps(IntPtr pConstBreps, int level, int threadCount, IntPtr errors);
+
   //ON_Brep* ONC_BrepFromMesh( const ON_Mesh* pConstMesh, bool bTrimmedTriangles)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern IntPtr ONC_BrepFromMesh(IntPtr pConstMesh, [MarshalAs(UnmanagedType.U1)]bool bTrimmedTriangles);
 
+  //ON_Brep* ONC_BrepFromMeshMergeCoplanar( const ON_Mesh* pConstMesh, double angleTolerance, double distanceTolerance, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ONC_BrepFromMeshMergeCoplanar(IntPtr pConstMesh, double angleTolerance, double distanceTolerance, int threadCount);
+
   //ON_Brep* ON_Brep_FromBox( ON_3DPOINT_STRUCT boxmin, ON_3DPOINT_STRUCT boxmax)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern IntPtr ON_Brep_FromBox(Point3d boxmin, Point3d boxmax);
@@ -1779,6 +1799,10 @@ internal partial class UnsafeNativeMethods
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern void ON_Brep_DuplicateEdgeCurves(IntPtr pConstBrep, IntPtr pOutCurves, [MarshalAs(UnmanagedType.U1)]bool nakedOnly, [MarshalAs(UnmanagedType.U1)]bool nakedOuter, [MarshalAs(UnmanagedType.U1)]bool nakedInner);
 
+  //int ON_Brep_GetWireframes(const ON_SimpleArray<const ON_Brep*>* pConstBreps, int edgeFilter, int isoCount, double tolerance, int threadCount, ON_SimpleArray<int>* info, ON_SimpleArray<ON_Curve*>* curves, ON_3dPointArray* points)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Brep_GetWireframes(IntPtr pConstBreps, int edgeFilter, int isoCount, double tolerance, int threadCount, IntPtr info, IntPtr curves, IntPtr points);
+
   //void ON_Brep_DuplicateVertices( const ON_Brep* pBrep, ON_3dPointArray* outPoints)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern void ON_Brep_DuplicateVertices(IntPtr pBrep, IntPtr outPoints);
@@ -1916,6 +1940,14 @@ internal partial class UnsafeNativeMethods
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern int ON_Brep_FaceFaceIndices(IntPtr pConstBrep, int face_index, IntPtr fi);
 
+  //const CRhCmnBrepTopology* ON_Brep_GetTopologyGraph(const ON_Brep* pConstBrep, /*ARRAY*/int* counts)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_Brep_GetTopologyGraph(IntPtr pConstBrep, [In,Out] int[] counts);
+
+  //void ON_BrepTopologyGraph_Copy(const ON_Brep* pConstBrep, const CRhCmnBrepTopology* pConstTopology, /*ARRAY*/int* data, /*ARRAY*/double* edgeAngles)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_BrepTopologyGraph_Copy(IntPtr pConstBrep, IntPtr pConstTopology, [In,Out] int[] data, [In,Out] double[] edgeAngles);
+
   //ON_Brep* ON_Brep_CopyTrims( const ON_BrepFace* pConstBrepFace, const ON_Surface* pConstSurface, double tolerance)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern IntPtr ON_Brep_CopyTrims(IntPtr pConstBrepFace, IntPtr pConstSurface, double tolerance);
@@ -2335,6 +2367,10 @@ internal partial class UnsafeNativeMethods
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_Curve_GetLength(IntPtr pCurve, ref double length, double fractional_tol, Interval sub_domain, [MarshalAs(UnmanagedType.U1)]bool ignoreSubDomain);
 
+  //double ON_Curve_GetLengthBatch(const ON_SimpleArray<const ON_Curve*>* pConstCurves, double fractional_tol, int threadCount, /*ARRAY*/double* lengths)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern double ON_Curve_GetLengthBatch(IntPtr pConstCurves, double fractional_tol, int threadCount, [In,Out] double[] lengths);
+
   //bool ON_Curve_IsShort( const ON_Curve* pCurve, double tolerance, ON_INTERVAL_STRUCT sub_domain, bool ignoreSubDomain)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   [return: MarshalAs(UnmanagedType.U1)]
@@ -2392,6 +2428,18 @@ internal partial class UnsafeNativeMethods
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_Curve_IsContinuous(IntPtr curvePtr, int continuityType, double t);
 
+  //int ON_Curve_GetDiscontinuities(const ON_Curve* curvePtr, int continuityType, double t0, double t1, ON_SimpleArray<double>* t)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Curve_GetDiscontinuities(IntPtr curvePtr, int continuityType, double t0, double t1, IntPtr t);
+
+  //int ON_Curve_GetDiscontinuitiesBatch(const ON_SimpleArray<const ON_Curve*>* pConstCurves, int continuityType, int threadCount, ON_SimpleArray<int>* counts, ON_SimpleArray<double>* t)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Curve_GetDiscontinuitiesBatch(IntPtr pConstCurves, int continuityType, int threadCount, IntPtr counts, IntPtr t);
+
+  //int ON_Curve_ContourPlanes(const ON_SimpleArray<const ON_Curve*>* pConstCurves, ON_3DPOINT_STRUCT basePoint, ON_3DVECTOR_STRUCT normal, int planeCount, /*ARRAY*/const double* offsets, double tolerance, int threadCount, ON_SimpleArray<int>* info, ON_SimpleArray<double>* parameters, ON_3dPointArray* points)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Curve_ContourPlanes(IntPtr pConstCurves, Point3d basePoint, Vector3d normal, int planeCount, double[] offsets, double tolerance, int threadCount, IntPtr info, IntPtr parameters, IntPtr points);
+
   //ON_SimpleArray<ON_X_EVENT>* ON_Curve_IntersectPlane(const ON_Curve* pConstCurve, ON_PLANE_STRUCT* plane, double tolerance)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern IntPtr ON_Curve_IntersectPlane(IntPtr pConstCurve, ref Plane plane, double tolerance);
@@ -2400,6 +2448,10 @@ internal partial class UnsafeNativeMethods
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern IntPtr ON_Curve_AreaMassProperties(IntPtr pCurve, double rel_tol, double abs_tol, double curve_planar_tol);
 
+  //double ON_Curve_GetAreaBatch(const ON_SimpleArray<const ON_Curve*>* pConstCurves, double rel_tol, double abs_tol, double curve_planar_tol, int threadCount, /*ARRAY*/double* areas)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern double ON_Curve_GetAreaBatch(IntPtr pConstCurves, double rel_tol, double abs_tol, double curve_planar_tol, int threadCount, [In,Out] double[] areas);
+
   //bool RHC_RhinoTweenCurves( const ON_Curve* pStartCurve, const ON_Curve* pEndCurve, int num_curves, ON_SimpleArray<ON_Curve*>* outputCurves )
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   [return: MarshalAs(UnmanagedType.U1)]
@@ -2414,6 +2466,10 @@ internal partial class UnsafeNativeMethods
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool RHC_RhinoTweenCurveWithSampling(IntPtr pStartCurve, IntPtr pEndCurve, int num_curves, int num_samples, IntPtr outputCurves);
+
+  //int RHC_RhinoTweenCurvesBatch( const ON_SimpleArray<const ON_Curve*>* pStartCurves, const ON_SimpleArray<const ON_Curve*>* pEndCurves, int method, int num_curves, int num_samples, ON_SimpleArray<int>* counts, ON_SimpleArray<ON_Curve*>* outputCurves )
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int RHC_RhinoTweenCurvesBatch(IntPtr pStartCurves, IntPtr pEndCurves, int method, int num_curves, int num_samples, IntPtr counts, IntPtr outputCurves);
   #endregion
 
 
@@ -3773,6 +3829,43 @@ internal partial class UnsafeNativeMethods
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_Mesh_GetMeshPart(IntPtr pConstMesh, int which, ref int vi0, ref int vi1, ref int fi0, ref int fi1, ref int vertex_count, ref int triangle_count);
+
+  //bool ON_Mesh_GetTreeCacheEnabled(const ON_Mesh* pConstMesh)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Mesh_GetTreeCacheEnabled(IntPtr pConstMesh);
+
+  //void ON_Mesh_SetTreeCacheEnabled(ON_Mesh* pMesh, bool enable)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_Mesh_SetTreeCacheEnabled(IntPtr pMesh, [MarshalAs(UnmanagedType.U1)]bool enable);
+
+  //CRhCmnMeshDistanceField* ON_MeshDistanceField_New(const ON_Mesh* pConstMesh, double voxelSize, double bandWidth, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_MeshDistanceField_New(IntPtr pConstMesh, double voxelSize, double bandWidth, int threadCount);
+
+  //void ON_MeshDistanceField_Delete(CRhCmnMeshDistanceField* pField)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_MeshDistanceField_Delete(IntPtr pField);
+
+  //void ON_MeshDistanceField_GetGrid(const CRhCmnMeshDistanceField* pConstField, ON_3dPoint* origin, double* voxelSize, double* bandWidth, int* countX, int* countY, int* countZ)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_MeshDistanceField_GetGrid(IntPtr pConstField, ref Point3d origin, ref double voxelSize, ref double bandWidth, ref int countX, ref int countY, ref int countZ);
+
+  //const void* ON_MeshDistanceField_Values(const CRhCmnMeshDistanceField* pConstField)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_MeshDistanceField_Values(IntPtr pConstField);
+
+  //double ON_MeshDistanceField_ValueAt(const CRhCmnMeshDistanceField* pConstField, ON_3DPOINT_STRUCT point)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern double ON_MeshDistanceField_ValueAt(IntPtr pConstField, Point3d point);
+
+  //void ON_MeshDistanceField_ValuesAt(const CRhCmnMeshDistanceField* pConstField, int count, /*ARRAY*/const ON_3dPoint* points, /*ARRAY*/double* values, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_MeshDistanceField_ValuesAt(IntPtr pConstField, int count, Point3d[] points, [In,Out] double[] values, int threadCount);
+
+  //unsigned int ON_MeshDistanceField_SizeOf(const CRhCmnMeshDistanceField* pConstField)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern uint ON_MeshDistanceField_SizeOf(IntPtr pConstField);
   #endregion
 
 
@@ -4168,6 +4261,28 @@ internal partial class UnsafeNativeMethods
   //int ONC_MeshClashSearch(const ON_SimpleArray<const ON_Mesh*>* pMeshesA, const ON_SimpleArray<const ON_Mesh*>* pMeshesB, double distance, int maxEvents, bool multithread, ON_SimpleArray<ON_ClashEvent>* pClashArray)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern int ONC_MeshClashSearch(IntPtr pMeshesA, IntPtr pMeshesB, double distance, int maxEvents, [MarshalAs(UnmanagedType.U1)]bool multithread, IntPtr pClashArray);
+
+  //CRhCmnClashSearch* ON_ClashSearch_New(const ON_SimpleArray<const ON_Geometry*>* pConstGeometryA, const ON_SimpleArray<const ON_Geometry*>* pConstGeometryB, double distance, int maxEventsPerPair, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_ClashSearch_New(IntPtr pConstGeometryA, IntPtr pConstGeometryB, double distance, int maxEventsPerPair, int threadCount);
+
+  //void ON_ClashSearch_Delete(CRhCmnClashSearch* pSearch)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_ClashSearch_Delete(IntPtr pSearch);
+
+  //int ON_ClashSearch_Next(CRhCmnClashSearch* pSearch, int maxCount, ON_SimpleArray<int>* pIndices, ON_SimpleArray<double>* pValues)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_ClashSearch_Next(IntPtr pSearch, int maxCount, IntPtr pIndices, IntPtr pValues);
+
+  //bool ON_ClashSearch_IsDone(const CRhCmnClashSearch* pConstSearch)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_ClashSearch_IsDone(IntPtr pConstSearch);
+
+  //bool ON_ClearanceSweep(const ON_SimpleArray<const ON_Geometry*>* pConstGeometryA, const ON_SimpleArray<const ON_Geometry*>* pConstGeometryB, int xformCount, /*ARRAY*/const double* xforms, double clearance, double maxDistance, int threadCount, /*ARRAY*/double* distances, /*ARRAY*/int* closestIndices, /*ARRAY*/ON_3dPoint* closestPoints, /*ARRAY*/double* firstContact, double* firstContactAll)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_ClearanceSweep(IntPtr pConstGeometryA, IntPtr pConstGeometryB, int xformCount, double[] xforms, double clearance, double maxDistance, int threadCount, [In,Out] double[] distances, [In,Out] int[] closestIndices, [In,Out] Point3d[] closestPoints, [In,Out] double[] firstContact, ref double firstContactAll);
   #endregion
 
 
@@ -4493,6 +4608,18 @@ internal partial class UnsafeNativeMethods
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern void ON_SimpleArray_PolylineCurve_Delete(IntPtr pPolylineCurves, [MarshalAs(UnmanagedType.U1)]bool delete_individual_curves);
 
+  //int ON_Polyline_Simplify(int point_count, /*ARRAY*/const ON_3dPoint* points, int method, double tolerance, ON_SimpleArray<int>* kept)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Polyline_Simplify(int point_count, Point3d[] points, int method, double tolerance, IntPtr kept);
+
+  //int ON_PolylineCurve_Simplify(ON_PolylineCurve* pCurve, int method, double tolerance)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_PolylineCurve_Simplify(IntPtr pCurve, int method, double tolerance);
+
+  //int ON_PolylineCurve_SimplifyBatch(ON_SimpleArray<ON_Curve*>* pCurves, int method, double tolerance, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_PolylineCurve_SimplifyBatch(IntPtr pCurves, int method, double tolerance, int threadCount);
+
   //void ON_PolylineCurve_Draw(const ON_PolylineCurve* pCrv, CRhinoDisplayPipeline* pDisplayPipeline, int argb, int thickness)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern void ON_PolylineCurve_Draw(IntPtr pCrv, IntPtr pDisplayPipeline, int argb, int thickness);
@@ -4521,6 +4648,30 @@ internal partial class UnsafeNativeMethods
   //void ON_Quaternion_Rotate( const ON_Quaternion* q, ON_3DVECTOR_STRUCT vin, ON_3dVector* vout)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern void ON_Quaternion_Rotate(ref Quaternion q, Vector3d vin, ref Vector3d vout);
+
+  //bool ON_Quaternion_InterpolateBatch(int count, /*ARRAY*/const ON_Quaternion* q0, /*ARRAY*/const ON_Quaternion* q1, int tCount, /*ARRAY*/const double* t, bool nlerp, /*ARRAY*/ON_Quaternion* result, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Quaternion_InterpolateBatch(int count, Quaternion[] q0, Quaternion[] q1, int tCount, double[] t, [MarshalAs(UnmanagedType.U1)]bool nlerp, [In,Out] Quaternion[] result, int threadCount);
+
+  //bool ON_Quaternion_RotateVectors(int quaternionCount, /*ARRAY*/const ON_Quaternion* q, int count, /*ARRAY*/const ON_3dVector* vectors, /*ARRAY*/ON_3dVector* result, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Quaternion_RotateVectors(int quaternionCount, Quaternion[] q, int count, Vector3d[] vectors, [In,Out] Vector3d[] result, int threadCount);
+
+  //bool ON_Quaternion_ToXformBatch(int count, /*ARRAY*/const ON_Quaternion* q, /*ARRAY*/const ON_3dVector* translations, /*ARRAY*/ON_Xform* xforms, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Quaternion_ToXformBatch(int count, Quaternion[] q, Vector3d[] translations, [In,Out] Transform[] xforms, int threadCount);
+
+  //int ON_Xform_ToQuaternionBatch(int count, /*ARRAY*/const ON_Xform* xforms, double tolerance, /*ARRAY*/ON_Quaternion* q, /*ARRAY*/ON_3dVector* translations, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Xform_ToQuaternionBatch(int count, Transform[] xforms, double tolerance, [In,Out] Quaternion[] q, [In,Out] Vector3d[] translations, int threadCount);
+
+  //bool ON_Xform_ComposeHierarchy(int count, /*ARRAY*/const ON_Xform* local, /*ARRAY*/const int* parents, /*ARRAY*/ON_Xform* world, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Xform_ComposeHierarchy(int count, Transform[] local, int[] parents, [In,Out] Transform[] world, int threadCount);
   #endregion
 
 
@@ -4543,6 +4694,16 @@ internal partial class UnsafeNativeMethods
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_RTree_CreatePointCloudTree(IntPtr pTree, IntPtr pConstCloud);
 
+  //bool ON_RTree_CreateGeometryTree(ON_RTree* pTree, const ON_SimpleArray<const ON_Geometry*>* pConstGeometryArray, bool tight, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTree_CreateGeometryTree(IntPtr pTree, IntPtr pConstGeometryArray, [MarshalAs(UnmanagedType.U1)]bool tight, int threadCount);
+
+  //bool ON_RTree_CreateModelObjectTree(ON_RTree* pTree, const ONX_Model* pConstModel, bool tight, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTree_CreateModelObjectTree(IntPtr pTree, IntPtr pConstModel, [MarshalAs(UnmanagedType.U1)]bool tight, int threadCount);
+
   //bool ON_RTreeSearchContext_GetBoundingBox(const ON_RTreeSearchContext* pConstContext, ON_3dPoint* p0, ON_3dPoint* p1)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   [return: MarshalAs(UnmanagedType.U1)]
@@ -4563,6 +4724,16 @@ internal partial class UnsafeNativeMethods
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_RTreeSearchContext_SetSphere(IntPtr pContext, Point3d center, double radius);
 
+  //bool ON_RTreeSearchContext_GetRayParameters(const ON_RTreeSearchContext* pConstContext, double* t, double* limit)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTreeSearchContext_GetRayParameters(IntPtr pConstContext, ref double t, ref double limit);
+
+  //bool ON_RTreeSearchContext_SetRayLimit(ON_RTreeSearchContext* pContext, double limit)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTreeSearchContext_SetRayLimit(IntPtr pContext, double limit);
+
   //bool ON_RTree_Search(const ON_RTree* pConstTree, ON_3DPOINT_STRUCT pt0, ON_3DPOINT_STRUCT pt1, int serial_number, RTREESEARCHPROC searchCB)
   // SKIPPING - Contains a function pointer which needs to be written by hand
 
@@ -4588,6 +4759,96 @@ internal partial class UnsafeNativeMethods
   //int ON_RTree_ElementCount(ON_RTree* pTree)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern int ON_RTree_ElementCount(IntPtr pTree);
+
+  //unsigned int ON_RTree_PackedSizeOf(const ON_RTree* pConstTree)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern uint ON_RTree_PackedSizeOf(IntPtr pConstTree);
+
+  //bool ON_RTree_Pack(const ON_RTree* pConstTree, unsigned int buffer_size, /*ARRAY*/unsigned char* buffer)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTree_Pack(IntPtr pConstTree, uint buffer_size, [In,Out] byte[] buffer);
+
+  //bool ON_RTree_WritePacked(const ON_RTree* pConstTree, ON_BinaryArchive* pArchive)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTree_WritePacked(IntPtr pConstTree, IntPtr pArchive);
+
+  //CRhCmnPackedRTree* ON_PackedRTree_New(const void* buffer, unsigned int buffer_size, bool copy, bool verifyCrc)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_PackedRTree_New(IntPtr buffer, uint buffer_size, [MarshalAs(UnmanagedType.U1)]bool copy, [MarshalAs(UnmanagedType.U1)]bool verifyCrc);
+
+  //CRhCmnPackedRTree* ON_PackedRTree_Read(ON_BinaryArchive* pArchive)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_PackedRTree_Read(IntPtr pArchive);
+
+  //bool ON_PackedRTree_Write(const CRhCmnPackedRTree* pConstPackedTree, ON_BinaryArchive* pArchive)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_PackedRTree_Write(IntPtr pConstPackedTree, IntPtr pArchive);
+
+  //void ON_PackedRTree_Delete(CRhCmnPackedRTree* pPackedTree)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_PackedRTree_Delete(IntPtr pPackedTree);
+
+  //int ON_PackedRTree_ElementCount(const CRhCmnPackedRTree* pConstPackedTree)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_PackedRTree_ElementCount(IntPtr pConstPackedTree);
+
+  //unsigned int ON_PackedRTree_SizeOf(const CRhCmnPackedRTree* pConstPackedTree)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern uint ON_PackedRTree_SizeOf(IntPtr pConstPackedTree);
+
+  //void ON_PackedRTree_BoundingBox(const CRhCmnPackedRTree* pConstPackedTree, ON_BoundingBox* bbox)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_PackedRTree_BoundingBox(IntPtr pConstPackedTree, ref BoundingBox bbox);
+
+  //bool ON_PackedRTree_Search(const CRhCmnPackedRTree* pConstPackedTree, ON_3DPOINT_STRUCT pt0, ON_3DPOINT_STRUCT pt1, int serial_number, RTREESEARCHPROC searchCB)
+  // SKIPPING - Contains a function pointer which needs to be written by hand
+
+  //bool ON_PackedRTree_SearchSphere(const CRhCmnPackedRTree* pConstPackedTree, ON_3DPOINT_STRUCT center, double radius, int serial_number, RTREESEARCHPROC searchCB)
+  // SKIPPING - Contains a function pointer which needs to be written by hand
+
+  //CRhCmnRTreeIdIndex* ON_RTreeIdIndex_New()
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_RTreeIdIndex_New();
+
+  //void ON_RTreeIdIndex_Delete(CRhCmnRTreeIdIndex* pIndex)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_RTreeIdIndex_Delete(IntPtr pIndex);
+
+  //void ON_RTreeIdIndex_Invalidate(CRhCmnRTreeIdIndex* pIndex)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_RTreeIdIndex_Invalidate(IntPtr pIndex);
+
+  //int ON_RTree_UpdateById(ON_RTree* pTree, CRhCmnRTreeIdIndex* pIndex, int count, /*ARRAY*/const ON__INT64* ids, /*ARRAY*/const ON_BoundingBox* boxes)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_RTree_UpdateById(IntPtr pTree, IntPtr pIndex, int count, Int64[] ids, BoundingBox[] boxes);
+
+  //int ON_RTree_RemoveById(ON_RTree* pTree, CRhCmnRTreeIdIndex* pIndex, int count, /*ARRAY*/const ON__INT64* ids)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_RTree_RemoveById(IntPtr pTree, IntPtr pIndex, int count, Int64[] ids);
+
+  //int ON_RTree_SearchOverlapsParallel(const ON_RTree* pConstTreeA, const ON_RTree* pConstTreeB, double tolerance, int maxPairs, int threadCount, ON_SimpleArray<int>* pairs, bool* reachedLimit)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_RTree_SearchOverlapsParallel(IntPtr pConstTreeA, IntPtr pConstTreeB, double tolerance, int maxPairs, int threadCount, IntPtr pairs, [MarshalAs(UnmanagedType.U1)]ref bool reachedLimit);
+
+  //bool ON_RTree_SearchRay(const ON_RTree* pConstTree, ON_3DPOINT_STRUCT from, ON_3DVECTOR_STRUCT direction, double t0, double t1, int serial_number, RTREESEARCHPROC searchCB)
+  // SKIPPING - Contains a function pointer which needs to be written by hand
+
+  //int ON_RTree_SearchRays(const ON_RTree* pConstTree, int count, /*ARRAY*/const ON_Line* lines, bool infinite, int maxHitsPerRay, int threadCount, ON_SimpleArray<int>* offsets, ON_SimpleArray<int>* ids, ON_SimpleArray<double>* parameters)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_RTree_SearchRays(IntPtr pConstTree, int count, Line[] lines, [MarshalAs(UnmanagedType.U1)]bool infinite, int maxHitsPerRay, int threadCount, IntPtr offsets, IntPtr ids, IntPtr parameters);
+
+  //bool ON_RTree_SearchPolytope(const ON_RTree* pConstTree, int planeCount, /*ARRAY*/const double* planeEquations, ON_SimpleArray<int>* inside, ON_SimpleArray<int>* intersecting)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTree_SearchPolytope(IntPtr pConstTree, int planeCount, double[] planeEquations, IntPtr inside, IntPtr intersecting);
+
+  //bool ON_RTree_SearchViewportFrustum(const ON_RTree* pConstTree, const ON_Viewport* pConstViewport, ON_SimpleArray<int>* inside, ON_SimpleArray<int>* intersecting)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTree_SearchViewportFrustum(IntPtr pConstTree, IntPtr pConstViewport, IntPtr inside, IntPtr intersecting);
   #endregion
 
 
@@ -4714,6 +4975,26 @@ internal partial class UnsafeNativeMethods
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_Surface_GetNextDiscontinuity(IntPtr pConstSurface, int direction, int continuityType, double t0, double t1, ref double t);
 
+  //int ON_Surface_GetDiscontinuities(const ON_Surface* pConstSurface, int direction, int continuityType, double t0, double t1, ON_SimpleArray<double>* t)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Surface_GetDiscontinuities(IntPtr pConstSurface, int direction, int continuityType, double t0, double t1, IntPtr t);
+
+  //CRhCmnSurfaceGrids* ON_SurfaceGrids_New(const ON_SimpleArray<const ON_Geometry*>* pConstGeometry, double chordTolerance, double angleTolerance, int maxCount, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_SurfaceGrids_New(IntPtr pConstGeometry, double chordTolerance, double angleTolerance, int maxCount, int threadCount);
+
+  //void ON_SurfaceGrids_Delete(CRhCmnSurfaceGrids* pGrids)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_SurfaceGrids_Delete(IntPtr pGrids);
+
+  //void ON_SurfaceGrids_GetCounts(const CRhCmnSurfaceGrids* pConstGrids, /*ARRAY*/int* counts)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_SurfaceGrids_GetCounts(IntPtr pConstGrids, [In,Out] int[] counts);
+
+  //void ON_SurfaceGrids_Copy(const CRhCmnSurfaceGrids* pConstGrids, /*ARRAY*/int* info, /*ARRAY*/ON_3dPoint* points, /*ARRAY*/ON_3dVector* normals, /*ARRAY*/ON_2dPoint* uv, /*ARRAY*/int* quads)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_SurfaceGrids_Copy(IntPtr pConstGrids, [In,Out] int[] info, [In,Out] Point3d[] points, [In,Out] Vector3d[] normals, [In,Out] Point2d[] uv, [In,Out] int[] quads);
+
   //bool ON_Surface_IsContinuous(const ON_Surface* pConstSurface, int continuityType, double s, double t)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   [return: MarshalAs(UnmanagedType.U1)]
@@ -5355,6 +5636,16 @@ internal partial class UnsafeNativeMethods
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern void ON_Matrix_SetValue(IntPtr pMatrix, int row, int column, double val);
 
+  //bool ON_Matrix_GetBlock(const ON_Matrix* pConstMatrix, int row, int column, int rowCount, int columnCount, /*ARRAY*/double* values)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Matrix_GetBlock(IntPtr pConstMatrix, int row, int column, int rowCount, int columnCount, [In,Out] double[] values);
+
+  //bool ON_Matrix_SetBlock(ON_Matrix* pMatrix, int row, int column, int rowCount, int columnCount, /*ARRAY*/const double* values)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Matrix_SetBlock(IntPtr pMatrix, int row, int column, int rowCount, int columnCount, double[] values);
+
   //void ON_Matrix_Zero(ON_Matrix* pMatrix)
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   internal static extern void ON_Matrix_Zero(IntPtr pMatrix);
@@ -5416,6 +5707,61 @@ internal partial class UnsafeNativeMethods
   [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_Matrix_GetBool(IntPtr pConstMatrix, int which);
+
+  //bool ON_Matrix_MultiplyBlocked(ON_Matrix* pMatrixRC, const ON_Matrix* pConstMatrixA, const ON_Matrix* pConstMatrixB, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Matrix_MultiplyBlocked(IntPtr pMatrixRC, IntPtr pConstMatrixA, IntPtr pConstMatrixB, int threadCount);
+
+  //int ON_Matrix_LUFactor(ON_Matrix* pMatrix, double zeroTolerance, int threadCount, /*ARRAY*/int* pivots, double* determinant, double* pivot)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_Matrix_LUFactor(IntPtr pMatrix, double zeroTolerance, int threadCount, [In,Out] int[] pivots, ref double determinant, ref double pivot);
+
+  //bool ON_Matrix_LUSolve(const ON_Matrix* pConstMatrix, /*ARRAY*/const int* pivots, int rhsCount, /*ARRAY*/double* b, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Matrix_LUSolve(IntPtr pConstMatrix, int[] pivots, int rhsCount, [In,Out] double[] b, int threadCount);
+
+  //bool ON_Matrix_CholeskyFactor(ON_Matrix* pMatrix, double zeroTolerance, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Matrix_CholeskyFactor(IntPtr pMatrix, double zeroTolerance, int threadCount);
+
+  //bool ON_Matrix_CholeskySolve(const ON_Matrix* pConstMatrix, int rhsCount, /*ARRAY*/double* b, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_Matrix_CholeskySolve(IntPtr pConstMatrix, int rhsCount, [In,Out] double[] b, int threadCount);
+
+  //CRhCmnSparseMatrix* ON_SparseMatrix_New(int rowCount, int columnCount, int count, /*ARRAY*/const int* rows, /*ARRAY*/const int* columns, /*ARRAY*/const double* values, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern IntPtr ON_SparseMatrix_New(int rowCount, int columnCount, int count, int[] rows, int[] columns, double[] values, int threadCount);
+
+  //void ON_SparseMatrix_Delete(CRhCmnSparseMatrix* pMatrix)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_SparseMatrix_Delete(IntPtr pMatrix);
+
+  //int ON_SparseMatrix_NonZeroCount(const CRhCmnSparseMatrix* pConstMatrix)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern int ON_SparseMatrix_NonZeroCount(IntPtr pConstMatrix);
+
+  //void ON_SparseMatrix_GetCompressedRows(const CRhCmnSparseMatrix* pConstMatrix, /*ARRAY*/int* rowStart, /*ARRAY*/int* columns, /*ARRAY*/double* values)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  internal static extern void ON_SparseMatrix_GetCompressedRows(IntPtr pConstMatrix, [In,Out] int[] rowStart, [In,Out] int[] columns, [In,Out] double[] values);
+
+  //bool ON_SparseMatrix_Multiply(const CRhCmnSparseMatrix* pConstMatrix, /*ARRAY*/const double* x, /*ARRAY*/double* y, bool transpose, int threadCount)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_SparseMatrix_Multiply(IntPtr pConstMatrix, double[] x, [In,Out] double[] y, [MarshalAs(UnmanagedType.U1)]bool transpose, int threadCount);
+
+  //bool ON_SparseMatrix_SolveCG(const CRhCmnSparseMatrix* pConstMatrix, /*ARRAY*/const double* b, /*ARRAY*/double* x, double tolerance, int maxIterations, bool jacobi, int threadCount, int* iterations, double* residual)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_SparseMatrix_SolveCG(IntPtr pConstMatrix, double[] b, [In,Out] double[] x, double tolerance, int maxIterations, [MarshalAs(UnmanagedType.U1)]bool jacobi, int threadCount, ref int iterations, ref double residual);
+
+  //bool ON_SparseMatrix_SolveLSQR(const CRhCmnSparseMatrix* pConstMatrix, /*ARRAY*/const double* b, /*ARRAY*/double* x, double damping, double tolerance, int maxIterations, int threadCount, int* iterations, double* residual)
+  [DllImport(Import.lib, CallingConvention=CallingConvention.Cdecl )]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_SparseMatrix_SolveLSQR(IntPtr pConstMatrix, double[] b, [In,Out] double[] x, double damping, double tolerance, int maxIterations, int threadCount, ref int iterations, ref double residual);
   #endregion
 
 
@@ -544,6 +544,18 @@ Rhino.Render.UI.UserInterfaceSection.SerialNumberBoolCallback onExpandCallback
   [return: MarshalAs(UnmanagedType.U1)]
   internal static extern bool ON_RTree_Search2(IntPtr pConstRtreeA, IntPtr pConstRtreeB, double tolerance, int serial_number, RTree.SearchCallback searchCB);
 
+  [DllImport(Import.lib, CallingConvention = CallingConvention.Cdecl)]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_PackedRTree_Search(IntPtr pConstPackedTree, Point3d pt0, Point3d pt1, int serial_number, RTree.SearchCallback searchCB);
+
+  [DllImport(Import.lib, CallingConvention = CallingConvention.Cdecl)]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_PackedRTree_SearchSphere(IntPtr pConstPackedTree, Point3d center, double radius, int serial_number, RTree.SearchCallback searchCB);
+
+  [DllImport(Import.lib, CallingConvention = CallingConvention.Cdecl)]
+  [return: MarshalAs(UnmanagedType.U1)]
+  internal static extern bool ON_RTree_SearchRay(IntPtr pConstRtree, Point3d from, Vector3d direction, double t0, double t1, int serial_number, RTree.SearchCallback searchCB);
+
   //bool ON_Arc_Copy(ON_Arc* pRdnArc, ON_Arc* pRhCmnArc, bool rdn_to_rhc)
   [DllImport(Import.lib, CallingConvention = CallingConvention.Cdecl)]
   [return: MarshalAs(UnmanagedType.U1)]
@@ -1944,6 +1944,11 @@ internal void ClearPointer()
       m_ptr = IntPtr.Zero;
     }
 
+    internal IntPtr NonConstPointer()
+    {
+      return m_ptr;
+    }
+
     bool m_write_error_occured;
 
     /// <summary>
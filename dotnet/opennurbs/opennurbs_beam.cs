@@ -490,6 +490,114 @@ public Mesh GetMesh(MeshType meshType)
       return CreateGeometryHelper(ptr_const_mesh, new MeshHolder(this, meshType)) as Mesh;
     }
 
+    /// <summary>
+    /// Meshes this extrusion straight from its profiles, without going through a brep.
+    /// Walls are split at profile kinks and caps are triangulated from the profiles.
+    /// Curved profile spans get at least 4 segments, and closed curved profiles at least 8,
+    /// whatever the tolerances.
+    /// </summary>
+    /// <param name="tolerance">
+    /// Largest distance between a profile segment and the profile curve. 0 turns the test off.
+    /// </param>
+    /// <param name="angleToleranceRadians">
+    /// Largest angle between the profile tangents at the ends of a segment. 0 turns the test off.
+    /// </param>
+    /// <returns>A new mesh, or null on failure.</returns>
+    public Mesh CreateMesh(double tolerance, double angleToleranceRadians)
+    {
+      IntPtr ptr_const_this = ConstPointer();
+      IntPtr ptr_mesh = UnsafeNativeMethods.ON_Extrusion_CreateMesh(ptr_const_this, tolerance, angleToleranceRadians);
+      if (IntPtr.Zero == ptr_mesh)
+        return null;
+      return new Mesh(ptr_mesh, null);
+    }
+
+    /// <summary>
+    /// Meshes many extrusions in parallel, each one the same way as <see cref="CreateMesh(double, double)"/>.
+    /// </summary>
+    /// <param name="extrusions">The extrusions.</param>
+    /// <param name="tolerance">
+    /// Largest distance between a profile segment and the profile curve. 0 turns the test off.
+    /// </param>
+    /// <param name="angleToleranceRadians">
+    /// Largest angle between the profile tangents at the ends of a segment. 0 turns the test off.
+    /// </param>
+    /// <returns>One mesh per input extrusion. Null inputs and failures give null entries.</returns>
+    /// <exception cref="ArgumentNullException">If extrusions is null.</exception>
+    public static Mesh[] CreateMeshes(System.Collections.Generic.IEnumerable<Extrusion> extrusions, double tolerance, double angleToleranceRadians)
+    {
+      if (extrusions == null)
+        throw new ArgumentNullException("extrusions");
+      System.Collections.Generic.List<int> indices;
+      int count;
+      var input = NonNullExtrusions(extrusions, out indices, out count);
+
+      Mesh[] rc = new Mesh[count];
+      using (var geometry = new Runtime.InteropWrappers.SimpleArrayGeometryPointer(input))
+      using (var meshes = new Runtime.InteropWrappers.SimpleArrayMeshPointer())
+      {
+        IntPtr ptr_mesh_array = meshes.NonConstPointer();
+        UnsafeNativeMethods.ON_Extrusion_CreateMeshes(geometry.ConstPointer(), tolerance, angleToleranceRadians, 0, ptr_mesh_array);
+        Mesh[] output = meshes.ToNonConstArray();
+        for (int i = 0; i < output.Length && i < indices.Count; i++)
+          rc[indices[i]] = output[i];
+      }
+      return rc;
+    }
+
+    /// <summary>
+    /// Sorts extrusions into groups that have identical profiles, such as members cut from
+    /// the same section. Profiles only match when they are the same curves; extrusions with
+    /// equal profiles can still differ in path, length and miters. The extrusions are not
+    /// changed and every one keeps its own copy of its profiles.
+    /// </summary>
+    /// <param name="extrusions">The extrusions.</param>
+    /// <param name="groupCount">The number of groups.</param>
+    /// <returns>
+    /// The group index of every input extrusion, in the order the groups were first met.
+    /// Null inputs get -1.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">If extrusions is null.</exception>
+    public static int[] GroupByProfile(System.Collections.Generic.IEnumerable<Extrusion> extrusions, out int groupCount)
+    {
+      if (extrusions == null)
+        throw new ArgumentNullException("extrusions");
+      System.Collections.Generic.List<int> indices;
+      int count;
+      var input = NonNullExtrusions(extrusions, out indices, out count);
+
+      int[] rc = new int[count];
+      for (int i = 0; i < rc.Length; i++)
+        rc[i] = -1;
+      int[] groups = new int[input.Count];
+      using (var geometry = new Runtime.InteropWrappers.SimpleArrayGeometryPointer(input))
+      {
+        groupCount = UnsafeNativeMethods.ON_Extrusion_GroupByProfile(geometry.ConstPointer(), 0, groups);
+      }
+      for (int i = 0; i < groups.Length; i++)
+        rc[indices[i]] = groups[i];
+      return rc;
+    }
+
+    // input gets the non null extrusions, indices their positions in extrusions
+    // and count the number of extrusions including null ones
+    private static System.Collections.Generic.List<Extrusion> NonNullExtrusions(System.Collections.Generic.IEnumerable<Extrusion> extrusions, out System.Collections.Generic.List<int> indices, out int count)
+    {
+      var input = new System.Collections.Generic.List<Extrusion>();
+      indices = new System.Collections.Generic.List<int>();
+      count = 0;
+      foreach (Extrusion extrusion in extrusions)
+      {
+        if (extrusion != null)
+        {
+          input.Add(extrusion);
+          indices.Add(count);
+        }
+        count++;
+      }
+      return input;
+    }
+
     //skipping
     //  const ON_PolyCurve* PolyProfile() const;
     //  int GetProfileCurves( ON_SimpleArray<const ON_Curve*>& profile_curves ) const;
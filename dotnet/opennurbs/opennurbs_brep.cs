@@ -131,6 +131,28 @@ public static Brep CreateFromMesh(Mesh mesh, bool trimmedTriangles)
       return CreateGeometryHelper(ptr_newbrep, null) as Brep;
     }
 
+    /// <summary>
+    /// Create a brep representation of a mesh where edge connected mesh faces
+    /// that lie in the same plane are merged into a single planar face bounded
+    /// by polygon loops. Quads are treated as two triangles, so non-planar quads
+    /// become two faces.
+    /// </summary>
+    /// <param name="mesh">The mesh to convert.</param>
+    /// <param name="angleToleranceRadians">
+    /// Largest angle between the normal of a mesh face and the normal of the
+    /// face that started its planar region.
+    /// </param>
+    /// <param name="distanceTolerance">
+    /// Largest distance from a mesh vertex to the plane of its region.
+    /// </param>
+    /// <returns>A new brep with one face per planar region or null on failure.</returns>
+    public static Brep CreateFromMesh(Mesh mesh, double angleToleranceRadians, double distanceTolerance)
+    {
+      IntPtr ptr_const_mesh = mesh.ConstPointer();
+      IntPtr ptr_newbrep = UnsafeNativeMethods.ONC_BrepFromMeshMergeCoplanar(ptr_const_mesh, angleToleranceRadians, distanceTolerance, 0);
+      return CreateGeometryHelper(ptr_newbrep, null) as Brep;
+    }
+
     /// <summary>
     /// Constructs new brep that matches a bounding box.
     /// </summary>
@@ -1422,6 +1444,30 @@ public Point3d[] DuplicateVertices()
       return outputPoints.ToArray();
     }
 
+    /// <summary>
+    /// Gets the face, edge and vertex adjacency of this brep in one call. The graph is
+    /// cached on the brep, so calling this again on an unchanged brep is cheap.
+    /// <para>The cached graph is reused while the numbers of vertices, edges, trims, loops
+    /// and faces stay the same. The edge angles are evaluated on every call, so they
+    /// always match the current geometry.</para>
+    /// </summary>
+    /// <returns>The topology graph, or null on error.</returns>
+    public BrepTopologyGraph GetTopologyGraph()
+    {
+      IntPtr pConstThis = ConstPointer();
+      int[] counts = new int[3 + BrepTopologyGraph.SectionCount];
+      IntPtr pConstGraph = UnsafeNativeMethods.ON_Brep_GetTopologyGraph(pConstThis, counts);
+      if (IntPtr.Zero == pConstGraph)
+        return null;
+      int length = 0;
+      for (int i = 3; i < counts.Length; i++)
+        length += counts[i];
+      int[] data = new int[length];
+      double[] angles = new double[counts[1]];
+      UnsafeNativeMethods.ON_BrepTopologyGraph_Copy(pConstThis, pConstGraph, data, angles);
+      return new BrepTopologyGraph(counts, data, angles);
+    }
+
 
 
     /// <summary>
@@ -1518,6 +1564,64 @@ public bool IsValidTolerancesAndFlags(out string log)
       }
     }
 
+    /// <summary>
+    /// Checks the vertices, edges, trims, loops and faces of this brep using several
+    /// threads and reports every component that fails instead of a text log.
+    /// Geometry is only checked when the topology is valid, and tolerances and flags
+    /// only when the geometry is valid.
+    /// </summary>
+    /// <param name="level">How far the checks go.</param>
+    /// <returns>The problems found; an empty array when the brep is valid.</returns>
+    public BrepValidationIssue[] Validate(BrepValidationLevel level)
+    {
+      return Validate(new Brep[] { this }, level);
+    }
+
+    /// <summary>
+    /// Checks many breps at once. The components of all breps are spread over several
+    /// threads, which is much faster than validating the breps one by one.
+    /// </summary>
+    /// <param name="breps">The breps to check. Null entries are reported as invalid.</param>
+    /// <param name="level">How far the checks go.</param>
+    /// <returns>The problems found, sorted by brep index; an empty array when all breps are valid.</returns>
+    public static BrepValidationIssue[] Validate(IEnumerable<Brep> breps, BrepValidationLevel level)
+    {
+      List<int> brep_indices = new List<int>();
+      List<int> null_indices = new List<int>();
+      List<BrepValidationIssue> rc = new List<BrepValidationIssue>();
+      using (var input = new Runtime.InteropWrappers.SimpleArrayBrepPointer())
+      using (var errors = new Runtime.InteropWrappers.SimpleArrayInt())
+      {
+        int index = 0;
+        foreach (Brep brep in breps)
+        {
+          if (brep != null)
+          {
+            input.Add(brep, true);
+            brep_indices.Add(index);
+          }
+          else
+            null_indices.Add(index);
+          index++;
+        }
+        UnsafeNativeMethods.ON_Brep_ValidateBreps(input.ConstPointer(), (int)level, 0, errors.NonConstPointer());
+
+        // the native results are sorted by brep, merge the null breps in
+        int[] e = errors.ToArray();
+        int n = 0;
+        for (int i = 0; i + 3 < e.Length; i += 4)
+        {
+          int brep_index = brep_indices[e[i]];
+          for (; n < null_indices.Count && null_indices[n] < brep_index; n++)
+            rc.Add(new BrepValidationIssue(null_indices[n], Rhino.Geometry.ComponentIndex.Unset, BrepValidationError.InvalidTopology));
+          rc.Add(new BrepValidationIssue(brep_index, new ComponentIndex((ComponentIndexType)e[i + 1], e[i + 2]), (BrepValidationError)e[i + 3]));
+        }
+        for (; n < null_indices.Count; n++)
+          rc.Add(new BrepValidationIssue(null_indices[n], Rhino.Geometry.ComponentIndex.Unset, BrepValidationError.InvalidTopology));
+      }
+      return rc.ToArray();
+    }
+
 #if RHINO_SDK
     /// <summary>
     /// Finds a point on the brep that is closest to testPoint.
@@ -1994,6 +2098,366 @@ internal override GeometryBase DuplicateShallowHelper()
     #endregion
   }
 
+  /// <summary>
+  /// Face, edge and vertex adjacency of a brep in compressed sparse row (CSR) form.
+  /// The neighbors of element i are Indices[Offsets[i]] through Indices[Offsets[i+1]-1].
+  /// Use <see cref="Brep.GetTopologyGraph"/> to get one.
+  /// </summary>
+  public sealed class BrepTopologyGraph
+  {
+    internal const int SectionCount = 10;
+
+    readonly int m_face_count;
+    readonly int m_edge_count;
+    readonly int m_vertex_count;
+    readonly int[][] m_sections;
+    readonly double[] m_edge_angles;
+
+    internal BrepTopologyGraph(int[] counts, int[] data, double[] edgeAngles)
+    {
+      m_face_count = counts[0];
+      m_edge_count = counts[1];
+      m_vertex_count = counts[2];
+      m_sections = new int[SectionCount][];
+      int start = 0;
+      for (int i = 0; i < SectionCount; i++)
+      {
+        m_sections[i] = new int[counts[3 + i]];
+        Array.Copy(data, start, m_sections[i], 0, m_sections[i].Length);
+        start += m_sections[i].Length;
+      }
+      m_edge_angles = edgeAngles;
+    }
+
+    /// <summary>Gets the number of faces in the brep.</summary>
+    public int FaceCount { get { return m_face_count; } }
+
+    /// <summary>Gets the number of edges in the brep.</summary>
+    public int EdgeCount { get { return m_edge_count; } }
+
+    /// <summary>Gets the number of vertices in the brep.</summary>
+    public int VertexCount { get { return m_vertex_count; } }
+
+    /// <summary>Gets FaceCount+1 offsets into <see cref="FaceFaceIndices"/>.</summary>
+    public int[] FaceFaceOffsets { get { return m_sections[0]; } }
+
+    /// <summary>Gets the faces that share an edge with each face, not including the face itself.</summary>
+    public int[] FaceFaceIndices { get { return m_sections[1]; } }
+
+    /// <summary>Gets FaceCount+1 offsets into <see cref="FaceEdgeIndices"/>.</summary>
+    public int[] FaceEdgeOffsets { get { return m_sections[2]; } }
+
+    /// <summary>Gets the edges used by the loops of each face. Every edge is listed once per face.</summary>
+    public int[] FaceEdgeIndices { get { return m_sections[3]; } }
+
+    /// <summary>Gets EdgeCount+1 offsets into <see cref="EdgeFaceIndices"/>.</summary>
+    public int[] EdgeFaceOffsets { get { return m_sections[4]; } }
+
+    /// <summary>
+    /// Gets the face of every trim of each edge, in the same order as BrepEdge.TrimIndices().
+    /// A seam edge lists its face twice.
+    /// </summary>
+    public int[] EdgeFaceIndices { get { return m_sections[5]; } }
+
+    /// <summary>Gets the start and end vertex of each edge, two values per edge.</summary>
+    public int[] EdgeVertexIndices { get { return m_sections[6]; } }
+
+    /// <summary>Gets VertexCount+1 offsets into <see cref="VertexEdgeIndices"/>.</summary>
+    public int[] VertexEdgeOffsets { get { return m_sections[7]; } }
+
+    /// <summary>Gets the edges that start or end at each vertex.</summary>
+    public int[] VertexEdgeIndices { get { return m_sections[8]; } }
+
+    /// <summary>
+    /// Gets the angle between the outward face normals at the middle of each edge. The
+    /// angle is positive at convex edges and negative at concave edges. Edges that do
+    /// not have exactly two trims get RhinoMath.UnsetValue.
+    /// </summary>
+    public double[] EdgeAngles { get { return m_edge_angles; } }
+
+    /// <summary>
+    /// Gets the adjacency of an edge.
+    /// </summary>
+    /// <param name="edgeIndex">Index of an edge.</param>
+    /// <returns>The adjacency.</returns>
+    public EdgeAdjacency GetEdgeAdjacency(int edgeIndex)
+    {
+      return (EdgeAdjacency)m_sections[9][edgeIndex];
+    }
+
+    /// <summary>
+    /// Returns true if an edge has one trim.
+    /// </summary>
+    /// <param name="edgeIndex">Index of an edge.</param>
+    /// <returns>true for naked edges.</returns>
+    public bool IsNaked(int edgeIndex)
+    {
+      return 1 == m_sections[9][edgeIndex];
+    }
+
+    /// <summary>
+    /// Returns true if an edge has two trims and the faces meet at a convex angle
+    /// larger than angleToleranceRadians.
+    /// </summary>
+    /// <param name="edgeIndex">Index of an edge.</param>
+    /// <param name="angleToleranceRadians">Smaller angles count as smooth.</param>
+    /// <returns>true for convex edges.</returns>
+    public bool IsConvex(int edgeIndex, double angleToleranceRadians)
+    {
+      double angle = m_edge_angles[edgeIndex];
+      return angle != RhinoMath.UnsetValue && angle > angleToleranceRadians;
+    }
+
+    /// <summary>
+    /// Returns true if an edge has two trims and the faces meet at a concave angle
+    /// larger than angleToleranceRadians.
+    /// </summary>
+    /// <param name="edgeIndex">Index of an edge.</param>
+    /// <param name="angleToleranceRadians">Smaller angles count as smooth.</param>
+    /// <returns>true for concave edges.</returns>
+    public bool IsConcave(int edgeIndex, double angleToleranceRadians)
+    {
+      double angle = m_edge_angles[edgeIndex];
+      return angle != RhinoMath.UnsetValue && angle < -angleToleranceRadians;
+    }
+
+    /// <summary>Gets the faces that share an edge with a face.</summary>
+    /// <param name="faceIndex">Index of a face.</param>
+    /// <returns>The adjacent face indices.</returns>
+    public int[] AdjacentFaces(int faceIndex)
+    {
+      return Slice(m_sections[0], m_sections[1], faceIndex);
+    }
+
+    /// <summary>Gets the edges of a face.</summary>
+    /// <param name="faceIndex">Index of a face.</param>
+    /// <returns>The edge indices.</returns>
+    public int[] FaceEdges(int faceIndex)
+    {
+      return Slice(m_sections[2], m_sections[3], faceIndex);
+    }
+
+    /// <summary>Gets the faces that use an edge.</summary>
+    /// <param name="edgeIndex">Index of an edge.</param>
+    /// <returns>The face indices.</returns>
+    public int[] EdgeFaces(int edgeIndex)
+    {
+      return Slice(m_sections[4], m_sections[5], edgeIndex);
+    }
+
+    /// <summary>Gets the edges that meet at a vertex.</summary>
+    /// <param name="vertexIndex">Index of a vertex.</param>
+    /// <returns>The edge indices.</returns>
+    public int[] VertexEdges(int vertexIndex)
+    {
+      return Slice(m_sections[7], m_sections[8], vertexIndex);
+    }
+
+    static int[] Slice(int[] offsets, int[] indices, int index)
+    {
+      int start = offsets[index];
+      int[] rc = new int[offsets[index + 1] - start];
+      Array.Copy(indices, start, rc, 0, rc.Length);
+      return rc;
+    }
+  }
+
+  /// <summary>
+  /// Selects how far <see cref="Brep.Validate(BrepValidationLevel)"/> checks a brep.
+  /// </summary>
+  public enum BrepValidationLevel : int
+  {
+    /// <summary>Only the topology is checked. This is the fastest level.</summary>
+    Topology = 0,
+    /// <summary>Topology and geometry are checked.</summary>
+    Geometry = 1,
+    /// <summary>Topology, geometry, tolerances and flags are checked, like <see cref="CommonObject.IsValid"/>.</summary>
+    Full = 2
+  }
+
+  /// <summary>
+  /// Identifies which check failed for a brep component.
+  /// </summary>
+  public enum BrepValidationError : int
+  {
+    /// <summary>The component's topology is not valid.</summary>
+    InvalidTopology = 1,
+    /// <summary>The component's geometry is not valid.</summary>
+    InvalidGeometry = 2,
+    /// <summary>The component's tolerances or flags are not valid.</summary>
+    InvalidTolerancesAndFlags = 3
+  }
+
+  /// <summary>
+  /// A problem found by <see cref="Brep.Validate(BrepValidationLevel)"/>.
+  /// </summary>
+  public struct BrepValidationIssue
+  {
+    readonly int m_brep_index;
+    readonly ComponentIndex m_component;
+    readonly BrepValidationError m_error;
+
+    internal BrepValidationIssue(int brepIndex, ComponentIndex component, BrepValidationError error)
+    {
+      m_brep_index = brepIndex;
+      m_component = component;
+      m_error = error;
+    }
+
+    /// <summary>Gets the index of the brep in the list that was validated.</summary>
+    public int BrepIndex { get { return m_brep_index; } }
+
+    /// <summary>
+    /// Gets the failing vertex, edge, trim, loop or face. Problems with the brep as a
+    /// whole, like a null or empty brep, use <see cref="ComponentIndexType.InvalidType"/>.
+    /// </summary>
+    public ComponentIndex Component { get { return m_component; } }
+
+    /// <summary>Gets which check failed.</summary>
+    public BrepValidationError Error { get { return m_error; } }
+  }
+
+  /// <summary>
+  /// Selects which edges <see cref="BrepWireframe"/> extracts.
+  /// </summary>
+  public enum BrepEdgeFilter : int
+  {
+    /// <summary>All edges that are used by at least one face.</summary>
+    All = 0,
+    /// <summary>Edges used by a single face.</summary>
+    Naked = 1,
+    /// <summary>Edges used by two or more faces.</summary>
+    Interior = 2
+  }
+
+  /// <summary>
+  /// Identifies the kind of a curve in a <see cref="BrepWireframe"/>.
+  /// </summary>
+  public enum BrepWireframeCurveKind : int
+  {
+    /// <summary>A brep edge.</summary>
+    Edge = 0,
+    /// <summary>An isocurve that runs in the u direction of a face, at a constant v.</summary>
+    IsoCurveU = 1,
+    /// <summary>An isocurve that runs in the v direction of a face, at a constant u.</summary>
+    IsoCurveV = 2
+  }
+
+  /// <summary>
+  /// Edges and trimmed isocurves of one or more breps, computed using several threads.
+  /// Results are either curves or polylines. Polyline points are stored in one flat array.
+  /// </summary>
+  public sealed class BrepWireframe
+  {
+    int[] m_info; // 4 ints per curve: brep, kind, component, point count
+    int[] m_offsets;
+    Curve[] m_curves;
+    Point3d[] m_points;
+
+    private BrepWireframe() { }
+
+    /// <summary>
+    /// Extracts the wireframe of a list of breps.
+    /// </summary>
+    /// <param name="breps">The breps.</param>
+    /// <param name="edgeFilter">Which edges to extract.</param>
+    /// <param name="isoCurveCount">
+    /// Number of isocurves in each direction on every face. They are placed evenly over the
+    /// face's surface domain and trimmed to the face's loops. Use 0 for edges only.
+    /// </param>
+    /// <param name="polylineTolerance">
+    /// When larger than 0, every curve is returned as a polyline that is within this distance
+    /// of the curve. Otherwise curves are returned.
+    /// </param>
+    /// <returns>The wireframe.</returns>
+    public static BrepWireframe Create(IEnumerable<Brep> breps, BrepEdgeFilter edgeFilter, int isoCurveCount, double polylineTolerance)
+    {
+      List<int> brep_indices = new List<int>();
+      using (var input = new Runtime.InteropWrappers.SimpleArrayBrepPointer())
+      using (var info = new Runtime.InteropWrappers.SimpleArrayInt())
+      using (var curves = new Runtime.InteropWrappers.SimpleArrayCurvePointer())
+      using (var points = new Runtime.InteropWrappers.SimpleArrayPoint3d())
+      {
+        int index = 0;
+        foreach (Brep brep in breps)
+        {
+          if (brep != null)
+          {
+            input.Add(brep, true);
+            brep_indices.Add(index);
+          }
+          index++;
+        }
+        bool polylines = polylineTolerance > 0.0;
+        UnsafeNativeMethods.ON_Brep_GetWireframes(input.ConstPointer(), (int)edgeFilter, isoCurveCount, polylineTolerance, 0,
+          info.NonConstPointer(), polylines ? IntPtr.Zero : curves.NonConstPointer(), polylines ? points.NonConstPointer() : IntPtr.Zero);
+
+        BrepWireframe rc = new BrepWireframe();
+        rc.m_info = info.ToArray();
+        int count = rc.m_info.Length / 4;
+        for (int i = 0; i < count; i++)
+          rc.m_info[4 * i] = brep_indices[rc.m_info[4 * i]];
+        if (polylines)
+        {
+          rc.m_points = points.ToArray();
+          rc.m_offsets = new int[count + 1];
+          for (int i = 0; i < count; i++)
+            rc.m_offsets[i + 1] = rc.m_offsets[i] + rc.m_info[4 * i + 3];
+        }
+        else
+          rc.m_curves = curves.ToNonConstArray();
+        return rc;
+      }
+    }
+
+    /// <summary>Gets the number of curves or polylines.</summary>
+    public int Count { get { return m_info.Length / 4; } }
+
+    /// <summary>Gets true when the wireframe holds polylines instead of curves.</summary>
+    public bool IsPolyline { get { return m_points != null; } }
+
+    /// <summary>Gets the index of the brep, in the input list, that a curve comes from.</summary>
+    /// <param name="index">Index of the curve.</param>
+    /// <returns>The brep index.</returns>
+    public int BrepIndex(int index) { return m_info[4 * index]; }
+
+    /// <summary>Gets the kind of a curve.</summary>
+    /// <param name="index">Index of the curve.</param>
+    /// <returns>The kind.</returns>
+    public BrepWireframeCurveKind Kind(int index) { return (BrepWireframeCurveKind)m_info[4 * index + 1]; }
+
+    /// <summary>Gets the edge index of an edge, or the face index of an isocurve.</summary>
+    /// <param name="index">Index of the curve.</param>
+    /// <returns>The component index.</returns>
+    public int ComponentIndex(int index) { return m_info[4 * index + 2]; }
+
+    /// <summary>Gets the curves, or null when the wireframe holds polylines.</summary>
+    public Curve[] Curves { get { return m_curves; } }
+
+    /// <summary>Gets the points of all polylines, or null when the wireframe holds curves.</summary>
+    public Point3d[] Points { get { return m_points; } }
+
+    /// <summary>
+    /// Gets Count+1 offsets into <see cref="Points"/>. Polyline i runs from
+    /// Points[PointOffsets[i]] to Points[PointOffsets[i+1]-1].
+    /// </summary>
+    public int[] PointOffsets { get { return m_offsets; } }
+
+    /// <summary>Gets a copy of one polyline.</summary>
+    /// <param name="index">Index of the polyline.</param>
+    /// <returns>The polyline, or null when the wireframe holds curves.</returns>
+    public Polyline GetPolyline(int index)
+    {
+      if (m_points == null)
+        return null;
+      int start = m_offsets[index];
+      Polyline rc = new Polyline(m_offsets[index + 1] - start);
+      for (int i = start; i < m_offsets[index + 1]; i++)
+        rc.Add(m_points[i]);
+      return rc;
+    }
+  }
+
   /// <summary>
   /// Enumerates the possible point/BrepFace spatial relationships.
   /// </summary>
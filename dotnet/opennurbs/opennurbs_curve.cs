@@ -263,6 +263,29 @@ public enum CurveEnd : int
     Both = 3,
   }
 
+#if RHINO_SDK
+  /// <summary>
+  /// Defines enumerated values for the ways tween curves are made compatible.
+  /// </summary>
+  public enum CurveTweenMethod : int
+  {
+    /// <summary>
+    /// Matches control points, like <see cref="Curve.CreateTweenCurves(Curve, Curve, int)"/>.
+    /// </summary>
+    ControlPoints = 0,
+
+    /// <summary>
+    /// Refits the curves to the same structure, like <see cref="Curve.CreateTweenCurvesWithMatching"/>.
+    /// </summary>
+    Matching = 1,
+
+    /// <summary>
+    /// Interpolates through sample points, like <see cref="Curve.CreateTweenCurvesWithSampling"/>.
+    /// </summary>
+    Sampling = 2,
+  }
+#endif
+
   /// <summary>
   /// Defines enumerated values for the options that defines a curve evaluation side when evaluating kinks.
   /// </summary>
@@ -589,6 +612,65 @@ public static Curve[] CreateTweenCurvesWithSampling(Curve curve0, Curve curve1,
       return rc ? output.ToNonConstArray() : new Curve[0];
     }
 
+    /// <summary>
+    /// Creates tween curves for many pairs of curves in one call. The pairs are processed
+    /// one after the other on the calling thread, each with the same algorithm as the single pair functions.
+    /// </summary>
+    /// <param name="startCurves">The first, or starting, curve of every pair.</param>
+    /// <param name="endCurves">The second, or ending, curve of every pair. Must have as many curves as startCurves.</param>
+    /// <param name="method">How the curves of each pair are made compatible.</param>
+    /// <param name="numCurves">Number of tween curves to create for every pair.</param>
+    /// <param name="numSamples">Number of sample points along input curves. Only used by <see cref="CurveTweenMethod.Sampling"/>.</param>
+    /// <returns>
+    /// One array of tween curves per pair. Pairs that fail or contain a null curve get an empty array.
+    /// </returns>
+    public static Curve[][] CreateTweenCurves(IList<Curve> startCurves, IList<Curve> endCurves, CurveTweenMethod method, int numCurves, int numSamples)
+    {
+      if (startCurves == null)
+        throw new ArgumentNullException("startCurves");
+      if (endCurves == null)
+        throw new ArgumentNullException("endCurves");
+      if (startCurves.Count != endCurves.Count)
+        throw new ArgumentException("startCurves and endCurves must have the same number of curves");
+
+      // only complete pairs go to the native code
+      List<int> pair_indices = new List<int>();
+      List<Curve> starts = new List<Curve>();
+      List<Curve> ends = new List<Curve>();
+      for (int i = 0; i < startCurves.Count; i++)
+      {
+        if (startCurves[i] != null && endCurves[i] != null)
+        {
+          pair_indices.Add(i);
+          starts.Add(startCurves[i]);
+          ends.Add(endCurves[i]);
+        }
+      }
+
+      Curve[][] rc = new Curve[startCurves.Count][];
+      for (int i = 0; i < rc.Length; i++)
+        rc[i] = new Curve[0];
+      using (var start_array = new SimpleArrayCurvePointer(starts))
+      using (var end_array = new SimpleArrayCurvePointer(ends))
+      using (var counts = new SimpleArrayInt())
+      using (var output = new SimpleArrayCurvePointer())
+      {
+        UnsafeNativeMethods.RHC_RhinoTweenCurvesBatch(start_array.ConstPointer(), end_array.ConstPointer(), (int)method, numCurves, numSamples,
+          counts.NonConstPointer(), output.NonConstPointer());
+        int[] count = counts.ToArray();
+        Curve[] all = output.ToNonConstArray();
+        int start = 0;
+        for (int i = 0; i < count.Length; i++)
+        {
+          Curve[] curves = new Curve[count[i]];
+          Array.Copy(all, start, curves, 0, count[i]);
+          rc[pair_indices[i]] = curves;
+          start += count[i];
+        }
+      }
+      return rc;
+    }
+
     /// <summary>
     /// Joins a collection of curve segments together.
     /// </summary>
@@ -2360,6 +2442,62 @@ public bool GetNextDiscontinuity(Continuity continuityType, double t0, double t1
       IntPtr ptr = ConstPointer();
       return UnsafeNativeMethods.ON_Curve_GetNextDiscontinuity(ptr, (int)continuityType, t0, t1, ref t);
     }
+
+    /// <summary>
+    /// Finds all derivative, tangent, or curvature discontinuities in one call.
+    /// This gives the same parameters as calling GetNextDiscontinuity() repeatedly.
+    /// </summary>
+    /// <param name="continuityType">Type of continuity to search for.</param>
+    /// <param name="t0">Search begins at t0. A discontinuity at t0 is ignored.</param>
+    /// <param name="t1">
+    /// (t0 != t1) Search ends at t1. A discontinuity at t1 is ignored unless continuityType
+    /// is a locus discontinuity type and t1 is at the start or end of the curve.
+    /// </param>
+    /// <returns>The discontinuity parameters, ordered from t0 to t1. The array is empty when none are found.</returns>
+    public double[] GetDiscontinuities(Continuity continuityType, double t0, double t1)
+    {
+      IntPtr ptr = ConstPointer();
+      using (var t = new Runtime.InteropWrappers.SimpleArrayDouble())
+      {
+        UnsafeNativeMethods.ON_Curve_GetDiscontinuities(ptr, (int)continuityType, t0, t1, t.NonConstPointer());
+        return t.ToArray();
+      }
+    }
+
+    /// <summary>
+    /// Finds all discontinuities of many curves over their whole domains, using several threads.
+    /// </summary>
+    /// <param name="curves">The curves to search.</param>
+    /// <param name="continuityType">Type of continuity to search for.</param>
+    /// <returns>
+    /// One array of discontinuity parameters per input curve, in the same order.
+    /// Null curves get an empty array.
+    /// </returns>
+    public static double[][] GetDiscontinuities(IEnumerable<Curve> curves, Continuity continuityType)
+    {
+      List<Curve> input = new List<Curve>(curves);
+      double[][] rc = new double[input.Count][];
+      using (var curve_array = new Runtime.InteropWrappers.SimpleArrayCurvePointer(input))
+      using (var counts = new Runtime.InteropWrappers.SimpleArrayInt())
+      using (var t = new Runtime.InteropWrappers.SimpleArrayDouble())
+      {
+        UnsafeNativeMethods.ON_Curve_GetDiscontinuitiesBatch(curve_array.ConstPointer(), (int)continuityType, 0, counts.NonConstPointer(), t.NonConstPointer());
+        int[] count = counts.ToArray();
+        double[] all = t.ToArray();
+        int k = 0; // the native array has no entries for null curves
+        int start = 0;
+        for (int i = 0; i < input.Count; i++)
+        {
+          int n = 0;
+          if (input[i] != null)
+            n = count[k++];
+          rc[i] = new double[n];
+          Array.Copy(all, start, rc[i], 0, n);
+          start += n;
+        }
+      }
+      return rc;
+    }
     #endregion
 
     #region size related methods
@@ -2418,6 +2556,38 @@ public double GetLength(double fractionalTolerance, Interval subdomain)
       return UnsafeNativeMethods.ON_Curve_GetLength(ptr, ref length, fractionalTolerance, subdomain, false) ? length : 0;
     }
 
+    /// <summary>
+    /// Gets the lengths of many curves, using several threads.
+    /// </summary>
+    /// <param name="curves">The curves to measure.</param>
+    /// <param name="fractionalTolerance">
+    /// Desired fractional precision, as in <see cref="GetLength(double)"/>. 1.0e-8 is the OpenNURBS default.
+    /// </param>
+    /// <param name="totalLength">The sum of all lengths.</param>
+    /// <returns>
+    /// One length per input curve, in the same order. Null curves and curves whose length
+    /// cannot be computed get zero, like <see cref="GetLength(double)"/>.
+    /// </returns>
+    public static double[] GetLengths(IEnumerable<Curve> curves, double fractionalTolerance, out double totalLength)
+    {
+      List<Curve> input = new List<Curve>(curves);
+      List<Curve> valid = input.FindAll(c => c != null);
+      double[] lengths = new double[valid.Count];
+      using (var curve_array = new SimpleArrayCurvePointer(valid))
+      {
+        totalLength = UnsafeNativeMethods.ON_Curve_GetLengthBatch(curve_array.ConstPointer(), fractionalTolerance, 0, lengths);
+      }
+      if (valid.Count == input.Count)
+        return lengths;
+      double[] rc = new double[input.Count];
+      for (int i = 0, k = 0; i < input.Count; i++)
+      {
+        if (input[i] != null)
+          rc[i] = lengths[k++];
+      }
+      return rc;
+    }
+
     /// <summary>Used to quickly find short curves.</summary>
     /// <param name="tolerance">Length threshold value for "shortness".</param>
     /// <returns>true if the length of the curve is &lt;= tolerance.</returns>
@@ -3872,6 +4042,137 @@ public Curve OffsetNormalToSurface(Surface surface, double height)
 #endif
     #endregion methods
   }
+
+  /// <summary>
+  /// Intersections of many curves with a family of parallel planes, computed using several
+  /// threads. Curve spans are only tested against planes that can cross them, which makes
+  /// this much faster than intersecting every curve with every plane.
+  /// </summary>
+  public sealed class CurveContours
+  {
+    int[] m_plane_offsets; // points of plane i are m_plane_offsets[i] .. m_plane_offsets[i+1]-1
+    int[] m_curve_indices;
+    double[] m_parameters;
+    Point3d[] m_points;
+
+    private CurveContours() { }
+
+    /// <summary>
+    /// Intersects curves with evenly spaced planes, like <see cref="Curve.DivideAsContour"/>.
+    /// The planes are perpendicular to the line from contourStart to contourEnd and placed
+    /// every interval from contourStart up to contourEnd.
+    /// </summary>
+    /// <param name="curves">The curves to contour.</param>
+    /// <param name="contourStart">A point where the first plane starts.</param>
+    /// <param name="contourEnd">A point where the last plane can end.</param>
+    /// <param name="interval">The distance between planes.</param>
+    /// <param name="tolerance">The distance from a plane that counts as on the plane.</param>
+    /// <returns>The contour points or null on failure.</returns>
+    public static CurveContours Create(IEnumerable<Curve> curves, Point3d contourStart, Point3d contourEnd, double interval, double tolerance)
+    {
+      Vector3d normal = contourEnd - contourStart;
+      double length = normal.Length;
+      if (!(interval > 0.0) || !normal.Unitize())
+        return null;
+      int count = (int)Math.Floor(length / interval + RhinoMath.SqrtEpsilon) + 1;
+      double[] offsets = new double[count];
+      for (int i = 0; i < count; i++)
+        offsets[i] = i * interval;
+      return Create(curves, contourStart, normal, offsets, tolerance);
+    }
+
+    /// <summary>
+    /// Intersects curves with parallel planes.
+    /// </summary>
+    /// <param name="curves">The curves to contour.</param>
+    /// <param name="basePoint">A point on the plane with offset zero.</param>
+    /// <param name="normal">The normal shared by all planes.</param>
+    /// <param name="offsets">
+    /// Plane i passes through basePoint + offsets[i]*normal, with the normal unitized.
+    /// The offsets do not need to be sorted.
+    /// </param>
+    /// <param name="tolerance">The distance from a plane that counts as on the plane.</param>
+    /// <returns>The contour points or null on failure.</returns>
+    public static CurveContours Create(IEnumerable<Curve> curves, Point3d basePoint, Vector3d normal, double[] offsets, double tolerance)
+    {
+      if (offsets == null || offsets.Length < 1 || !normal.Unitize())
+        return null;
+      List<int> curve_indices = new List<int>();
+      List<Curve> valid = new List<Curve>();
+      int index = 0;
+      foreach (Curve curve in curves)
+      {
+        if (curve != null)
+        {
+          valid.Add(curve);
+          curve_indices.Add(index);
+        }
+        index++;
+      }
+
+      using (var curve_array = new SimpleArrayCurvePointer(valid))
+      using (var info = new SimpleArrayInt())
+      using (var parameters = new SimpleArrayDouble())
+      using (var points = new SimpleArrayPoint3d())
+      {
+        UnsafeNativeMethods.ON_Curve_ContourPlanes(curve_array.ConstPointer(), basePoint, normal, offsets.Length, offsets, tolerance, 0,
+          info.NonConstPointer(), parameters.NonConstPointer(), points.NonConstPointer());
+        int[] pairs = info.ToArray();
+        int count = pairs.Length / 2;
+        CurveContours rc = new CurveContours();
+        rc.m_plane_offsets = new int[offsets.Length + 1];
+        rc.m_curve_indices = new int[count];
+        for (int i = 0; i < count; i++)
+        {
+          rc.m_plane_offsets[pairs[2 * i] + 1]++;
+          rc.m_curve_indices[i] = curve_indices[pairs[2 * i + 1]];
+        }
+        for (int i = 0; i < offsets.Length; i++)
+          rc.m_plane_offsets[i + 1] += rc.m_plane_offsets[i];
+        rc.m_parameters = parameters.ToArray();
+        rc.m_points = points.ToArray();
+        return rc;
+      }
+    }
+
+    /// <summary>Gets the number of planes.</summary>
+    public int PlaneCount { get { return m_plane_offsets.Length - 1; } }
+
+    /// <summary>Gets the total number of intersection points.</summary>
+    public int PointCount { get { return m_points.Length; } }
+
+    /// <summary>Gets the intersection points on one plane, ordered by curve and curve parameter.</summary>
+    /// <param name="planeIndex">Index of the plane in the offsets used to create the contours.</param>
+    /// <returns>The points.</returns>
+    public Point3d[] GetPoints(int planeIndex)
+    {
+      return Slice(m_points, planeIndex);
+    }
+
+    /// <summary>Gets the index of the curve of every point on one plane.</summary>
+    /// <param name="planeIndex">Index of the plane in the offsets used to create the contours.</param>
+    /// <returns>Indices into the curves used to create the contours.</returns>
+    public int[] GetCurveIndices(int planeIndex)
+    {
+      return Slice(m_curve_indices, planeIndex);
+    }
+
+    /// <summary>Gets the curve parameter of every point on one plane.</summary>
+    /// <param name="planeIndex">Index of the plane in the offsets used to create the contours.</param>
+    /// <returns>The curve parameters.</returns>
+    public double[] GetParameters(int planeIndex)
+    {
+      return Slice(m_parameters, planeIndex);
+    }
+
+    T[] Slice<T>(T[] values, int planeIndex)
+    {
+      int start = m_plane_offsets[planeIndex];
+      T[] rc = new T[m_plane_offsets[planeIndex + 1] - start];
+      Array.Copy(values, start, rc, 0, rc.Length);
+      return rc;
+    }
+  }
 }
 
 
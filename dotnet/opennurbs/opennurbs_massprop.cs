@@ -96,6 +96,36 @@ public static AreaMassProperties Compute(Curve closedPlanarCurve, double planarT
       return rc == IntPtr.Zero ? null : new AreaMassProperties(rc, false);
     }
 
+    /// <summary>
+    /// Computes the areas of many closed planar curves, using several threads. Only the area
+    /// is integrated, with the same tolerances as <see cref="Compute(Curve, double)"/>.
+    /// </summary>
+    /// <param name="closedPlanarCurves">Curves to measure.</param>
+    /// <param name="planarTolerance">absolute tolerance used to insure the closed curves are planar</param>
+    /// <param name="totalArea">The sum of all areas that could be computed.</param>
+    /// <returns>
+    /// One area per input curve, in the same order. Null curves, curves that are not closed
+    /// and planar and curves that fail get <see cref="RhinoMath.UnsetValue"/>.
+    /// </returns>
+    public static double[] ComputeAreas(IEnumerable<Curve> closedPlanarCurves, double planarTolerance, out double totalArea)
+    {
+      const double relativeTolerance = 1.0e-6;
+      const double absoluteTolerance = 1.0e-6;
+      List<Curve> input = new List<Curve>(closedPlanarCurves);
+      List<Curve> valid = input.FindAll(c => c != null);
+      double[] areas = new double[valid.Count];
+      using (var curve_array = new Runtime.InteropWrappers.SimpleArrayCurvePointer(valid))
+      {
+        totalArea = UnsafeNativeMethods.ON_Curve_GetAreaBatch(curve_array.ConstPointer(), relativeTolerance, absoluteTolerance, planarTolerance, 0, areas);
+      }
+      if (valid.Count == input.Count)
+        return areas;
+      double[] rc = new double[input.Count];
+      for (int i = 0, k = 0; i < input.Count; i++)
+        rc[i] = input[i] != null ? areas[k++] : RhinoMath.UnsetValue;
+      return rc;
+    }
+
     /// <summary>
     /// Computes an AreaMassProperties for a hatch.
     /// </summary>
@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 
 namespace Rhino.Geometry
 {
@@ -51,15 +52,18 @@ public Matrix Duplicate()
       int rc = RowCount;
       int cc = ColumnCount;
       Matrix dup = new Matrix(rc, cc);
-
-      for (int r = 0; r < rc; r++)
+      double[] values = new double[rc * cc];
+      bool copied = UnsafeNativeMethods.ON_Matrix_GetBlock(m_ptr, 0, 0, rc, cc, values) &&
+                    UnsafeNativeMethods.ON_Matrix_SetBlock(dup.m_ptr, 0, 0, rc, cc, values);
+      if (!copied)
       {
-        for (int c = 0; c < cc; c++)
+        // fall back to copying one value at a time
+        for (int i = 0; i < rc; i++)
         {
-          dup[r, c] = this[r, c];
+          for (int j = 0; j < cc; j++)
+            dup[i, j] = this[i, j];
         }
       }
-
       return dup;
     }
 
@@ -127,6 +131,82 @@ protected virtual void Dispose(bool disposing)
       }
     }
 
+    /// <summary>
+    /// Gets a rectangular block of values with one native call.
+    /// </summary>
+    /// <param name="row">Index of the first row of the block.</param>
+    /// <param name="column">Index of the first column of the block.</param>
+    /// <param name="rowCount">Number of rows in the block.</param>
+    /// <param name="columnCount">Number of columns in the block.</param>
+    /// <returns>The rowCount*columnCount values of the block, row after row.</returns>
+    /// <exception cref="ArgumentOutOfRangeException">If the block is not inside the matrix.</exception>
+    public double[] GetBlock(int row, int column, int rowCount, int columnCount)
+    {
+      CheckBlock(row, column, rowCount, columnCount);
+      double[] values = new double[rowCount * columnCount];
+      UnsafeNativeMethods.ON_Matrix_GetBlock(m_ptr, row, column, rowCount, columnCount, values);
+      return values;
+    }
+
+    /// <summary>
+    /// Sets a rectangular block of values with one native call.
+    /// </summary>
+    /// <param name="row">Index of the first row of the block.</param>
+    /// <param name="column">Index of the first column of the block.</param>
+    /// <param name="rowCount">Number of rows in the block.</param>
+    /// <param name="columnCount">Number of columns in the block.</param>
+    /// <param name="values">rowCount*columnCount values, row after row.</param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// If the block is not inside the matrix or values has the wrong length.
+    /// </exception>
+    public void SetBlock(int row, int column, int rowCount, int columnCount, double[] values)
+    {
+      CheckBlock(row, column, rowCount, columnCount);
+      if (values == null || values.Length != rowCount * columnCount)
+        throw new ArgumentOutOfRangeException("values", "values.Length != rowCount*columnCount");
+      UnsafeNativeMethods.ON_Matrix_SetBlock(m_ptr, row, column, rowCount, columnCount, values);
+    }
+
+    /// <summary>Gets all values of a row.</summary>
+    /// <param name="row">Index of row to access.</param>
+    /// <returns>ColumnCount values.</returns>
+    public double[] GetRow(int row)
+    {
+      return GetBlock(row, 0, 1, m_columns);
+    }
+
+    /// <summary>Sets all values of a row.</summary>
+    /// <param name="row">Index of row to access.</param>
+    /// <param name="values">ColumnCount values.</param>
+    public void SetRow(int row, double[] values)
+    {
+      SetBlock(row, 0, 1, m_columns, values);
+    }
+
+    /// <summary>Gets all values of a column.</summary>
+    /// <param name="column">Index of column to access.</param>
+    /// <returns>RowCount values.</returns>
+    public double[] GetColumn(int column)
+    {
+      return GetBlock(0, column, m_rows, 1);
+    }
+
+    /// <summary>Sets all values of a column.</summary>
+    /// <param name="column">Index of column to access.</param>
+    /// <param name="values">RowCount values.</param>
+    public void SetColumn(int column, double[] values)
+    {
+      SetBlock(0, column, m_rows, 1, values);
+    }
+
+    void CheckBlock(int row, int column, int rowCount, int columnCount)
+    {
+      if (row < 0 || rowCount < 0 || row + rowCount > m_rows)
+        throw new ArgumentOutOfRangeException("row", "rows out of range");
+      if (column < 0 || columnCount < 0 || column + columnCount > m_columns)
+        throw new ArgumentOutOfRangeException("column", "columns out of range");
+    }
+
     /// <summary>
     /// Gets a value indicating whether this matrix is valid.
     /// </summary>
@@ -246,7 +326,8 @@ public bool Invert(double zeroTolerance)
         throw new ArgumentException("either a of b are Invalid");
 
       Matrix rc = new Matrix(a.RowCount, b.ColumnCount);
-      UnsafeNativeMethods.ON_Matrix_Multiply(rc.m_ptr, a.m_ptr, b.m_ptr);
+      // blocked and multithreaded, same sums in the same order as ON_Matrix::Multiply
+      UnsafeNativeMethods.ON_Matrix_MultiplyBlocked(rc.m_ptr, a.m_ptr, b.m_ptr, 0);
       return rc;
     }
 
@@ -385,6 +466,85 @@ public Point3d[] BackSolvePoints(double zeroTolerance, Point3d[] b)
       return null;
     }
 
+    /// <summary>
+    /// Computes an LU factorization with partial pivoting, in place, using several threads.
+    /// <para>Pivots, row scaling and zero tests are those of
+    /// <see cref="RowReduce(double, out double, out double)"/> and the part above the diagonal
+    /// ends up with exactly the same values. The diagonal keeps the pivots and the part
+    /// below it the multipliers, so <see cref="LUSolve"/> can reuse the factorization.</para>
+    /// </summary>
+    /// <param name="zeroTolerance">
+    /// (&gt;=0.0) zero tolerance for pivot test. If the absolute value of a pivot
+    /// is &lt;= zeroTolerance, then the pivot is assumed to be zero.
+    /// </param>
+    /// <param name="pivots">The row swapped with row k at step k, for every step.</param>
+    /// <param name="determinant">value of determinant is returned here.</param>
+    /// <param name="pivot">value of the smallest pivot is returned here.</param>
+    /// <returns>Rank of the matrix.</returns>
+    public int LUFactor(double zeroTolerance, out int[] pivots, out double determinant, out double pivot)
+    {
+      determinant = 0;
+      pivot = 0;
+      pivots = new int[Math.Min(m_rows, m_columns)];
+      return UnsafeNativeMethods.ON_Matrix_LUFactor(m_ptr, zeroTolerance, 0, pivots, ref determinant, ref pivot);
+    }
+
+    /// <summary>
+    /// Solves M*X=B with a square matrix factored by <see cref="LUFactor"/> to full rank.
+    /// Gives the same values as <see cref="RowReduce(double, double[], out double)"/>
+    /// followed by <see cref="BackSolve"/>.
+    /// </summary>
+    /// <param name="pivots">The pivots returned by <see cref="LUFactor"/>.</param>
+    /// <param name="b">
+    /// One or more right hand sides of RowCount values each, one after the other.
+    /// They are solved in parallel.
+    /// </param>
+    /// <returns>The solutions in the same layout as b, or null on error.</returns>
+    public double[] LUSolve(int[] pivots, double[] b)
+    {
+      if (!IsSquare || pivots == null || pivots.Length != m_rows || b == null || b.Length == 0 || b.Length % m_rows != 0)
+        return null;
+      double[] x = (double[])b.Clone();
+      if (UnsafeNativeMethods.ON_Matrix_LUSolve(m_ptr, pivots, b.Length / m_rows, x, 0))
+        return x;
+      return null;
+    }
+
+    /// <summary>
+    /// Replaces a symmetric positive definite matrix by the lower triangular L
+    /// with M = L*transpose(L), using several threads. Only the lower triangle is read.
+    /// </summary>
+    /// <param name="zeroTolerance">
+    /// (&gt;=0.0) the factorization fails when a diagonal value is &lt;= zeroTolerance.
+    /// </param>
+    /// <returns>
+    /// true if operation succeeded; otherwise false and the matrix is partially overwritten.
+    /// </returns>
+    public bool CholeskyFactor(double zeroTolerance)
+    {
+      if (!IsSquare)
+        return false;
+      return UnsafeNativeMethods.ON_Matrix_CholeskyFactor(m_ptr, zeroTolerance, 0);
+    }
+
+    /// <summary>
+    /// Solves M*X=B with a matrix factored by <see cref="CholeskyFactor"/>.
+    /// </summary>
+    /// <param name="b">
+    /// One or more right hand sides of RowCount values each, one after the other.
+    /// They are solved in parallel.
+    /// </param>
+    /// <returns>The solutions in the same layout as b, or null on error.</returns>
+    public double[] CholeskySolve(double[] b)
+    {
+      if (!IsSquare || b == null || b.Length == 0 || b.Length % m_rows != 0)
+        return null;
+      double[] x = (double[])b.Clone();
+      if (UnsafeNativeMethods.ON_Matrix_CholeskySolve(m_ptr, b.Length / m_rows, x, 0))
+        return x;
+      return null;
+    }
+
     const int idxIsRowOrthogonal = 0;
     const int idxIsRowOrthoNormal = 1;
     const int idxIsColumnOrthogonal = 2;
@@ -448,4 +608,209 @@ public override int GetHashCode()
       return hash;
     }
   }
-}
\ No newline at end of file
+
+  /// <summary>
+  /// Represents a sparse matrix of <see cref="double">double</see>-precision floating point
+  /// numbers, stored by compressed rows. Use it for large systems, like the ones from least
+  /// squares fitting or mesh Laplacians, that would not fit in a <see cref="Matrix"/>.
+  /// <para>Products and solvers use several threads. Their results do not depend on the
+  /// number of threads.</para>
+  /// </summary>
+  public class SparseMatrix : IDisposable
+  {
+    IntPtr m_ptr; //CRhCmnSparseMatrix*
+    readonly int m_rows;
+    readonly int m_columns;
+
+    /// <summary>
+    /// Initializes a new sparse matrix from (row, column, value) triplets.
+    /// Values of triplets with the same row and column are added together.
+    /// </summary>
+    /// <param name="rowCount">A positive integer, or 0, for the number of rows.</param>
+    /// <param name="columnCount">A positive integer, or 0, for the number of columns.</param>
+    /// <param name="rowIndices">Row index of every triplet.</param>
+    /// <param name="columnIndices">Column index of every triplet.</param>
+    /// <param name="values">Value of every triplet.</param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    /// If rowCount or columnCount is negative, or an index is out of range.
+    /// </exception>
+    /// <exception cref="ArgumentException">If the three lists do not have the same length.</exception>
+    public SparseMatrix(int rowCount, int columnCount, IList<int> rowIndices, IList<int> columnIndices, IList<double> values)
+    {
+      if (rowCount < 0)
+        throw new ArgumentOutOfRangeException("rowCount", "must be >= 0");
+      if (columnCount < 0)
+        throw new ArgumentOutOfRangeException("columnCount", "must be >= 0");
+      if (rowIndices == null || columnIndices == null || values == null)
+        throw new ArgumentNullException(rowIndices == null ? "rowIndices" : (columnIndices == null ? "columnIndices" : "values"));
+      if (rowIndices.Count != values.Count || columnIndices.Count != values.Count)
+        throw new ArgumentException("rowIndices, columnIndices and values must have the same length");
+
+      int[] rows = new int[values.Count];
+      int[] columns = new int[values.Count];
+      double[] vals = new double[values.Count];
+      rowIndices.CopyTo(rows, 0);
+      columnIndices.CopyTo(columns, 0);
+      values.CopyTo(vals, 0);
+      m_ptr = UnsafeNativeMethods.ON_SparseMatrix_New(rowCount, columnCount, vals.Length, rows, columns, vals, 0);
+      if (m_ptr == IntPtr.Zero)
+        throw new ArgumentOutOfRangeException("rowIndices", "row or column index out of range");
+      m_rows = rowCount;
+      m_columns = columnCount;
+    }
+
+    #region IDisposable implementation
+    /// <summary>
+    /// Passively reclaims unmanaged resources when the class user did not explicitly call Dispose().
+    /// </summary>
+    ~SparseMatrix()
+    {
+      Dispose(false);
+    }
+
+    /// <summary>
+    /// Actively reclaims unmanaged resources that this instance uses.
+    /// </summary>
+    public void Dispose()
+    {
+      Dispose(true);
+      GC.SuppressFinalize(this);
+    }
+
+    /// <summary>
+    /// For derived class implementers.
+    /// <para>This method is called with argument true when class user calls Dispose(), while with argument false when
+    /// the Garbage Collector invokes the finalizer, or Finalize() method.</para>
+    /// <para>You must reclaim all used unmanaged resources in both cases, and can use this chance to call Dispose on disposable fields if the argument is true.</para>
+    /// <para>Also, you must call the base virtual method within your overriding method.</para>
+    /// </summary>
+    /// <param name="disposing">true if the call comes from the Dispose() method; false if it comes from the Garbage Collector finalizer.</param>
+    protected virtual void Dispose(bool disposing)
+    {
+      if (m_ptr != IntPtr.Zero)
+      {
+        UnsafeNativeMethods.ON_SparseMatrix_Delete(m_ptr);
+      }
+      m_ptr = IntPtr.Zero;
+    }
+    #endregion
+
+    /// <summary>
+    /// Gets the amount of rows.
+    /// </summary>
+    public int RowCount { get { return m_rows; } }
+
+    /// <summary>
+    /// Gets the amount of columns.
+    /// </summary>
+    public int ColumnCount { get { return m_columns; } }
+
+    /// <summary>
+    /// Gets the amount of stored values, after duplicate triplets were added together.
+    /// </summary>
+    public int NonZeroCount
+    {
+      get { return UnsafeNativeMethods.ON_SparseMatrix_NonZeroCount(m_ptr); }
+    }
+
+    /// <summary>
+    /// Gets the compressed row storage of this matrix.
+    /// </summary>
+    /// <param name="rowStart">
+    /// RowCount+1 offsets. The values of row i are at [rowStart[i], rowStart[i+1]).
+    /// </param>
+    /// <param name="columnIndices">Column of every value, increasing along every row.</param>
+    /// <param name="values">The values.</param>
+    public void GetCompressedRows(out int[] rowStart, out int[] columnIndices, out double[] values)
+    {
+      int count = NonZeroCount;
+      rowStart = new int[m_rows + 1];
+      columnIndices = new int[count];
+      values = new double[count];
+      UnsafeNativeMethods.ON_SparseMatrix_GetCompressedRows(m_ptr, rowStart, columnIndices, values);
+    }
+
+    /// <summary>
+    /// Multiplies this matrix by a vector.
+    /// </summary>
+    /// <param name="x">ColumnCount values.</param>
+    /// <returns>The RowCount values of this*x.</returns>
+    /// <exception cref="ArgumentException">When x.Length != ColumnCount.</exception>
+    public double[] Multiply(double[] x)
+    {
+      if (x == null || x.Length != m_columns)
+        throw new ArgumentException("x.Length != ColumnCount");
+      double[] y = new double[m_rows];
+      UnsafeNativeMethods.ON_SparseMatrix_Multiply(m_ptr, x, y, false, 0);
+      return y;
+    }
+
+    /// <summary>
+    /// Multiplies the transpose of this matrix by a vector.
+    /// </summary>
+    /// <param name="x">RowCount values.</param>
+    /// <returns>The ColumnCount values of transpose(this)*x.</returns>
+    /// <exception cref="ArgumentException">When x.Length != RowCount.</exception>
+    public double[] MultiplyTranspose(double[] x)
+    {
+      if (x == null || x.Length != m_rows)
+        throw new ArgumentException("x.Length != RowCount");
+      double[] y = new double[m_columns];
+      UnsafeNativeMethods.ON_SparseMatrix_Multiply(m_ptr, x, y, true, 0);
+      return y;
+    }
+
+    /// <summary>
+    /// Solves M*x=b for a symmetric positive definite matrix with the Jacobi
+    /// preconditioned conjugate gradient method.
+    /// </summary>
+    /// <param name="b">RowCount values.</param>
+    /// <param name="x">The initial guess, often all zeros, replaced by the solution.</param>
+    /// <param name="tolerance">Stop when |b - M*x| &lt;= tolerance*|b|.</param>
+    /// <param name="maxIterations">Maximum number of iterations.</param>
+    /// <param name="iterations">The number of iterations used.</param>
+    /// <param name="residual">|b - M*x|/|b| for the returned x.</param>
+    /// <returns>
+    /// true if the tolerance was reached; false if the matrix is not square or not positive
+    /// definite, or maxIterations was reached first.
+    /// </returns>
+    public bool SolveConjugateGradient(double[] b, double[] x, double tolerance, int maxIterations, out int iterations, out double residual)
+    {
+      iterations = 0;
+      residual = 0;
+      if (m_rows != m_columns || b == null || b.Length != m_rows || x == null || x.Length != m_columns)
+        return false;
+      return UnsafeNativeMethods.ON_SparseMatrix_SolveCG(m_ptr, b, x, tolerance, maxIterations, true, 0, ref iterations, ref residual);
+    }
+
+    /// <summary>
+    /// Solves M*x=b, or the least squares problem min |M*x - b|, with LSQR.
+    /// Works for matrices of any shape.
+    /// </summary>
+    /// <param name="b">RowCount values.</param>
+    /// <param name="x">
+    /// The initial guess, often all zeros, replaced by the solution. LSQR solves for the
+    /// correction of the initial guess.
+    /// </param>
+    /// <param name="damping">
+    /// 0.0, or a positive value d that solves min |M*dx - r|^2 + d^2*|dx|^2 for the correction
+    /// dx to regularize ill conditioned systems.
+    /// </param>
+    /// <param name="tolerance">
+    /// Stop when |b - M*x| &lt;= tolerance*|b|, or when the least squares optimality test
+    /// |transpose(M)*r| &lt;= tolerance*|M|*|r| passes.
+    /// </param>
+    /// <param name="maxIterations">Maximum number of iterations.</param>
+    /// <param name="iterations">The number of iterations used.</param>
+    /// <param name="residual">An estimate of |b - M*x|/|b| for the returned x.</param>
+    /// <returns>true if one of the tolerance tests passed; false if maxIterations was reached first.</returns>
+    public bool SolveLeastSquares(double[] b, double[] x, double damping, double tolerance, int maxIterations, out int iterations, out double residual)
+    {
+      iterations = 0;
+      residual = 0;
+      if (b == null || b.Length != m_rows || x == null || x.Length != m_columns)
+        return false;
+      return UnsafeNativeMethods.ON_SparseMatrix_SolveLSQR(m_ptr, b, x, damping, tolerance, maxIterations, 0, ref iterations, ref residual);
+    }
+  }
+}
@@ -1025,6 +1025,30 @@ public int DisjointMeshCount
       }
     }
 
+    /// <summary>
+    /// Gets or sets a value indicating whether a face search tree is stored with this mesh.
+    /// <para>When enabled, the tree is written to 3dm files along with the mesh and
+    /// restored when the file is read, so ray and point containment queries on large
+    /// meshes do not have to build a tree first. The tree is rebuilt automatically
+    /// when the mesh no longer matches it.</para>
+    /// <para>Queries only compare the vertex and face counts with the tree. Transformations
+    /// and edits made with SetVertex or SetFace are detected as well; after any other edit that
+    /// keeps the counts, set this property to false and back to true.</para>
+    /// </summary>
+    public bool SearchTreeCacheEnabled
+    {
+      get
+      {
+        IntPtr pConstThis = ConstPointer();
+        return UnsafeNativeMethods.ON_Mesh_GetTreeCacheEnabled(pConstThis);
+      }
+      set
+      {
+        IntPtr pThis = NonConstPointer();
+        UnsafeNativeMethods.ON_Mesh_SetTreeCacheEnabled(pThis, value);
+      }
+    }
+
     /// <summary>
     /// Gets a value indicating whether a mesh is considered to be closed (solid).
     /// A mesh is considered solid when every mesh edge borders two or more faces.
@@ -5158,4 +5182,152 @@ public MeshFace Flip()
     }
     #endregion
   }
+
+  /// <summary>
+  /// Represents a narrow band signed distance field of a closed mesh, sampled on a regular grid.
+  /// <para>Values are negative inside the mesh and positive outside. Distances farther
+  /// from the mesh than the band width are clamped to plus or minus the band width.</para>
+  /// </summary>
+  public class MeshDistanceField : IDisposable
+  {
+    IntPtr m_ptr; // CRhCmnMeshDistanceField*
+    long m_memory_pressure;
+    Point3d m_origin;
+    double m_voxel_size;
+    double m_band_width;
+    int m_count_x;
+    int m_count_y;
+    int m_count_z;
+
+    MeshDistanceField(IntPtr ptr)
+    {
+      m_ptr = ptr;
+      UnsafeNativeMethods.ON_MeshDistanceField_GetGrid(m_ptr, ref m_origin, ref m_voxel_size, ref m_band_width, ref m_count_x, ref m_count_y, ref m_count_z);
+      m_memory_pressure = UnsafeNativeMethods.ON_MeshDistanceField_SizeOf(m_ptr);
+      GC.AddMemoryPressure(m_memory_pressure);
+    }
+
+    /// <summary>
+    /// Computes the signed distance field of a closed mesh, using several threads.
+    /// </summary>
+    /// <param name="mesh">A closed mesh.</param>
+    /// <param name="voxelSize">Distance between grid points.</param>
+    /// <param name="bandWidth">
+    /// Distances are computed exactly up to this distance from the mesh. Must be at least voxelSize.
+    /// </param>
+    /// <returns>The distance field, or null on error.</returns>
+    public static MeshDistanceField Create(Mesh mesh, double voxelSize, double bandWidth)
+    {
+      IntPtr pConstMesh = mesh.ConstPointer();
+      IntPtr ptr = UnsafeNativeMethods.ON_MeshDistanceField_New(pConstMesh, voxelSize, bandWidth, 0);
+      if (IntPtr.Zero == ptr)
+        return null;
+      return new MeshDistanceField(ptr);
+    }
+
+    /// <summary>Gets the location of the first grid point.</summary>
+    public Point3d Origin { get { return m_origin; } }
+
+    /// <summary>Gets the distance between grid points.</summary>
+    public double VoxelSize { get { return m_voxel_size; } }
+
+    /// <summary>Gets the width of the band around the mesh where distances are exact.</summary>
+    public double BandWidth { get { return m_band_width; } }
+
+    /// <summary>Gets the number of grid points in the x direction.</summary>
+    public int CountX { get { return m_count_x; } }
+
+    /// <summary>Gets the number of grid points in the y direction.</summary>
+    public int CountY { get { return m_count_y; } }
+
+    /// <summary>Gets the number of grid points in the z direction.</summary>
+    public int CountZ { get { return m_count_z; } }
+
+    /// <summary>
+    /// Gets a pointer to the grid values without copying them.
+    /// <para>The values are single precision floats, CountX*CountY*CountZ of them, with
+    /// the x index running fastest, then y, then z. The pointer is valid until this
+    /// field is disposed.</para>
+    /// </summary>
+    public IntPtr ValueBuffer
+    {
+      get { return UnsafeNativeMethods.ON_MeshDistanceField_Values(m_ptr); }
+    }
+
+    /// <summary>
+    /// Copies the grid values into a new array, in the same order as <see cref="ValueBuffer"/>.
+    /// </summary>
+    /// <returns>The grid values.</returns>
+    public float[] ToArray()
+    {
+      float[] rc = new float[(long)m_count_x * m_count_y * m_count_z];
+      IntPtr pValues = ValueBuffer;
+      if (rc.Length > 0 && IntPtr.Zero != pValues)
+        System.Runtime.InteropServices.Marshal.Copy(pValues, rc, 0, rc.Length);
+      return rc;
+    }
+
+    /// <summary>
+    /// Gets the signed distance at a point by trilinear interpolation of the grid.
+    /// Points outside of the grid get the band width.
+    /// </summary>
+    /// <param name="point">A point.</param>
+    /// <returns>The signed distance.</returns>
+    public double ValueAt(Point3d point)
+    {
+      return UnsafeNativeMethods.ON_MeshDistanceField_ValueAt(m_ptr, point);
+    }
+
+    /// <summary>
+    /// Gets the signed distances at many points, using several threads.
+    /// </summary>
+    /// <param name="points">The points.</param>
+    /// <returns>The signed distance at each point.</returns>
+    public double[] ValuesAt(Point3d[] points)
+    {
+      double[] rc = new double[points.Length];
+      if (points.Length > 0)
+        UnsafeNativeMethods.ON_MeshDistanceField_ValuesAt(m_ptr, points.Length, points, rc, 0);
+      return rc;
+    }
+
+    /// <summary>
+    /// Passively reclaims unmanaged resources when the class user did not explicitly call Dispose().
+    /// </summary>
+    ~MeshDistanceField()
+    {
+      Dispose(false);
+    }
+
+    /// <summary>
+    /// Actively reclaims unmanaged resources that this instance uses.
+    /// </summary>
+    public void Dispose()
+    {
+      Dispose(true);
+      GC.SuppressFinalize(this);
+    }
+
+    /// <summary>
+    /// For derived class implementers.
+    /// <para>This method is called with argument true when class user calls Dispose(), while with argument false when
+    /// the Garbage Collector invokes the finalizer, or Finalize() method.</para>
+    /// <para>You must reclaim all used unmanaged resources in both cases, and can use this chance to call Dispose on disposable fields if the argument is true.</para>
+    /// <para>Also, you must call the base virtual method within your overriding method.</para>
+    /// </summary>
+    /// <param name="disposing">true if the call comes from the Dispose() method; false if it comes from the Garbage Collector finalizer.</param>
+    protected virtual void Dispose(bool disposing)
+    {
+      if (IntPtr.Zero != m_ptr)
+      {
+        UnsafeNativeMethods.ON_MeshDistanceField_Delete(m_ptr);
+        m_ptr = IntPtr.Zero;
+      }
+      if (m_memory_pressure > 0)
+      {
+        GC.RemoveMemoryPressure(m_memory_pressure);
+        m_memory_pressure = 0;
+      }
+    }
+  }
 }
@@ -249,6 +249,256 @@ namespace Rhino.Geometry.Intersect
 
   //also add ON_RTree
 
+  /// <summary>
+  /// Represents a place where a face of an object in one set is within the
+  /// clash distance of a face of an object in a second set.
+  /// </summary>
+  public struct MeshClashEvent
+  {
+    internal int m_index_a;
+    internal int m_index_b;
+    internal int m_face_a;
+    internal int m_face_b;
+    internal Point3d m_point_a;
+    internal Point3d m_point_b;
+    internal double m_distance;
+
+    /// <summary>Gets the index of the object in the first set.</summary>
+    public int IndexA { get { return m_index_a; } }
+
+    /// <summary>Gets the index of the object in the second set.</summary>
+    public int IndexB { get { return m_index_b; } }
+
+    /// <summary>
+    /// Gets the index of the face on the first object. This is a mesh face index for
+    /// meshes and extrusions, and a brep face index for breps.
+    /// </summary>
+    public int FaceIndexA { get { return m_face_a; } }
+
+    /// <summary>
+    /// Gets the index of the face on the second object. This is a mesh face index for
+    /// meshes and extrusions, and a brep face index for breps.
+    /// </summary>
+    public int FaceIndexB { get { return m_face_b; } }
+
+    /// <summary>Gets the point on the first object that is closest to the second one.</summary>
+    public Point3d PointA { get { return m_point_a; } }
+
+    /// <summary>Gets the point on the second object that is closest to the first one.</summary>
+    public Point3d PointB { get { return m_point_b; } }
+
+    /// <summary>Gets the distance between the faces. Intersecting faces have distance 0.</summary>
+    public double Distance { get { return m_distance; } }
+  }
+
+  /// <summary>
+  /// Searches for places where objects in one set are closer than a distance to
+  /// objects in a second set, using several threads. Meshes are searched directly,
+  /// breps and extrusions using the render meshes that are stored on them.
+  /// Results are returned in batches so a search can be stopped early.
+  /// </summary>
+  public class MeshClashSearch : IDisposable
+  {
+    IntPtr m_ptr; // CRhCmnClashSearch*
+
+    /// <summary>
+    /// Prepares a clash search. No clashes are computed until <see cref="Next"/> is called.
+    /// </summary>
+    /// <param name="setA">The first set of meshes, breps or extrusions.</param>
+    /// <param name="setB">The second set of meshes, breps or extrusions. An object that is
+    /// also in setA is not searched against itself.</param>
+    /// <param name="distance">The largest distance at which there is a clash.</param>
+    /// <param name="maxEventsPerPair">
+    /// The maximum number of clashes reported for each pair of objects, or 0 for no limit.
+    /// </param>
+    public MeshClashSearch(IEnumerable<GeometryBase> setA, IEnumerable<GeometryBase> setB, double distance, int maxEventsPerPair)
+    {
+      using (SimpleArrayGeometryPointer geometry_a = new SimpleArrayGeometryPointer(setA))
+      using (SimpleArrayGeometryPointer geometry_b = new SimpleArrayGeometryPointer(setB))
+      {
+        IntPtr pGeometryA = geometry_a.ConstPointer();
+        IntPtr pGeometryB = geometry_b.ConstPointer();
+        m_ptr = UnsafeNativeMethods.ON_ClashSearch_New(pGeometryA, pGeometryB, distance, maxEventsPerPair, 0);
+      }
+    }
+
+    /// <summary>
+    /// Gets true when all clashes have been returned.
+    /// </summary>
+    public bool IsDone
+    {
+      get { return UnsafeNativeMethods.ON_ClashSearch_IsDone(m_ptr); }
+    }
+
+    /// <summary>
+    /// Computes the next batch of clashes.
+    /// </summary>
+    /// <param name="maxCount">The largest number of clashes to return.</param>
+    /// <returns>Up to maxCount clashes. An empty array means the search is done.</returns>
+    public MeshClashEvent[] Next(int maxCount)
+    {
+      if (IntPtr.Zero == m_ptr || maxCount < 1)
+        return new MeshClashEvent[0];
+      using (SimpleArrayInt indices = new SimpleArrayInt())
+      using (SimpleArrayDouble values = new SimpleArrayDouble())
+      {
+        int count = UnsafeNativeMethods.ON_ClashSearch_Next(m_ptr, maxCount, indices.NonConstPointer(), values.NonConstPointer());
+        int[] i = indices.ToArray();
+        double[] v = values.ToArray();
+        MeshClashEvent[] rc = new MeshClashEvent[count];
+        for (int n = 0; n < count; n++)
+        {
+          rc[n].m_index_a = i[4 * n];
+          rc[n].m_index_b = i[4 * n + 1];
+          rc[n].m_face_a = i[4 * n + 2];
+          rc[n].m_face_b = i[4 * n + 3];
+          rc[n].m_point_a = new Point3d(v[7 * n], v[7 * n + 1], v[7 * n + 2]);
+          rc[n].m_point_b = new Point3d(v[7 * n + 3], v[7 * n + 4], v[7 * n + 5]);
+          rc[n].m_distance = v[7 * n + 6];
+        }
+        return rc;
+      }
+    }
+
+    /// <summary>
+    /// Passively reclaims unmanaged resources when the class user did not explicitly call Dispose().
+    /// </summary>
+    ~MeshClashSearch()
+    {
+      Dispose(false);
+    }
+
+    /// <summary>
+    /// Actively reclaims unmanaged resources that this instance uses.
+    /// </summary>
+    public void Dispose()
+    {
+      Dispose(true);
+      GC.SuppressFinalize(this);
+    }
+
+    /// <summary>
+    /// For derived class implementers.
+    /// <para>This method is called with argument true when class user calls Dispose(), while with argument false when
+    /// the Garbage Collector invokes the finalizer, or Finalize() method.</para>
+    /// <para>You must reclaim all used unmanaged resources in both cases, and can use this chance to call Dispose on disposable fields if the argument is true.</para>
+    /// <para>Also, you must call the base virtual method within your overriding method.</para>
+    /// </summary>
+    /// <param name="disposing">true if the call comes from the Dispose() method; false if it comes from the Garbage Collector finalizer.</param>
+    protected virtual void Dispose(bool disposing)
+    {
+      if (IntPtr.Zero != m_ptr)
+      {
+        UnsafeNativeMethods.ON_ClashSearch_Delete(m_ptr);
+        m_ptr = IntPtr.Zero;
+      }
+    }
+  }
+
+  /// <summary>
+  /// Clearance between a set of objects that moves along a path and a set of
+  /// fixed objects. Meshes are used directly, breps and extrusions through the
+  /// render meshes that are stored on them.
+  /// </summary>
+  public sealed class MeshClearanceSweep
+  {
+    double[] m_distances;
+    int[] m_indices;
+    Point3d[] m_points;
+    double[] m_first_contact;
+    double m_first_contact_all;
+
+    private MeshClearanceSweep() { }
+
+    /// <summary>
+    /// Moves setA by every transformation of a path and computes the smallest distance
+    /// to setB at each one, using several threads.
+    /// </summary>
+    /// <param name="setA">The moving meshes, breps or extrusions.</param>
+    /// <param name="setB">The fixed meshes, breps or extrusions.</param>
+    /// <param name="path">Rigid transformations applied to setA, one per path sample.</param>
+    /// <param name="clearance">Distances at or below this value count as contact.</param>
+    /// <param name="maxDistance">
+    /// Distances larger than this are not computed exactly and are reported as maxDistance.
+    /// Use 0 for no limit. A limit makes the search a lot faster.
+    /// </param>
+    /// <returns>The clearance along the path, or null on error.</returns>
+    public static MeshClearanceSweep Compute(IEnumerable<GeometryBase> setA, IEnumerable<GeometryBase> setB, IList<Transform> path, double clearance, double maxDistance)
+    {
+      if (path == null || path.Count < 1)
+        return null;
+      double[] xforms = new double[16 * path.Count];
+      for (int i = 0; i < path.Count; i++)
+      {
+        Transform xf = path[i];
+        for (int r = 0; r < 4; r++)
+        {
+          for (int c = 0; c < 4; c++)
+            xforms[16 * i + 4 * r + c] = xf[r, c];
+        }
+      }
+
+      IList<GeometryBase> _setA = setA as IList<GeometryBase> ?? new List<GeometryBase>(setA);
+      int count_a = _setA.Count;
+      if (count_a < 1)
+        return null;
+      using (SimpleArrayGeometryPointer geometry_a = new SimpleArrayGeometryPointer(_setA))
+      using (SimpleArrayGeometryPointer geometry_b = new SimpleArrayGeometryPointer(setB))
+      {
+        MeshClearanceSweep rc = new MeshClearanceSweep();
+        rc.m_distances = new double[path.Count];
+        rc.m_indices = new int[2 * path.Count];
+        rc.m_points = new Point3d[2 * path.Count];
+        rc.m_first_contact = new double[count_a];
+        if (!UnsafeNativeMethods.ON_ClearanceSweep(geometry_a.ConstPointer(), geometry_b.ConstPointer(), path.Count, xforms, clearance, maxDistance, 0,
+          rc.m_distances, rc.m_indices, rc.m_points, rc.m_first_contact, ref rc.m_first_contact_all))
+          return null;
+        return rc;
+      }
+    }
+
+    /// <summary>Gets the number of path samples.</summary>
+    public int SampleCount { get { return m_distances.Length; } }
+
+    /// <summary>Gets the smallest distance between the sets at a path sample.</summary>
+    /// <param name="sample">Index of the path sample.</param>
+    /// <returns>The distance, or maxDistance when the sets are further apart than that.</returns>
+    public double MinimumDistance(int sample) { return m_distances[sample]; }
+
+    /// <summary>
+    /// Gets the closest pair of objects at a path sample.
+    /// </summary>
+    /// <param name="sample">Index of the path sample.</param>
+    /// <param name="indexA">Index of the object in setA, or -1.</param>
+    /// <param name="indexB">Index of the object in setB, or -1.</param>
+    /// <param name="pointA">Closest point on the moved object from setA.</param>
+    /// <param name="pointB">Closest point on the object from setB.</param>
+    /// <returns>true if the sets are closer than maxDistance at the sample.</returns>
+    public bool GetClosestPair(int sample, out int indexA, out int indexB, out Point3d pointA, out Point3d pointB)
+    {
+      indexA = m_indices[2 * sample];
+      indexB = m_indices[2 * sample + 1];
+      pointA = m_points[2 * sample];
+      pointB = m_points[2 * sample + 1];
+      return indexA >= 0;
+    }
+
+    /// <summary>
+    /// Gets the path parameter of the first contact of any object in setA. The integer part
+    /// is the sample index; between samples the distance is interpolated linearly.
+    /// Returns -1 when there is no contact.
+    /// </summary>
+    public double FirstContactParameter { get { return m_first_contact_all; } }
+
+    /// <summary>
+    /// Gets the path parameter of the first contact of one object in setA, or -1 when it
+    /// never gets within the clearance.
+    /// </summary>
+    /// <param name="indexA">Index of the object in setA.</param>
+    /// <returns>The path parameter.</returns>
+    public double FirstContactParameterOf(int indexA) { return m_first_contact[indexA]; }
+  }
+
 #if RHINO_SDK
 
   /// <summary>
@@ -3,6 +3,29 @@
 
 namespace Rhino.Geometry
 {
+  /// <summary>
+  /// Defines enumerated values for the algorithms that simplify polylines.
+  /// </summary>
+  public enum PolylineSimplifyMethod : int
+  {
+    /// <summary>
+    /// Douglas-Peucker. Tolerance is the largest distance from a removed vertex to the simplified polyline.
+    /// </summary>
+    DouglasPeucker = 0,
+
+    /// <summary>
+    /// Visvalingam-Whyatt. Vertices whose effective triangle area is smaller than the tolerance
+    /// are removed, smallest first. The tolerance is an area.
+    /// </summary>
+    Visvalingam = 1,
+
+    /// <summary>
+    /// Chordal deviation. Walks along the polyline and extends every chord while all the vertices
+    /// it skips are within tolerance of it.
+    /// </summary>
+    Chordal = 2,
+  }
+
   /// <summary>
   /// Represents an ordered set of points connected by linear segments.
   /// <para>Polylines are closed if start and end points coincide.</para>
@@ -556,6 +579,34 @@ public int ReduceSegments(double tolerance)
 
       return vertex_map.Length - m_size;
     }
+
+    /// <summary>
+    /// Removes vertices from this polyline with a native simplification algorithm.
+    /// The first and last vertex are always kept, and closed polylines stay closed.
+    /// </summary>
+    /// <param name="method">The simplification algorithm.</param>
+    /// <param name="tolerance">
+    /// A distance for <see cref="PolylineSimplifyMethod.DouglasPeucker"/> and
+    /// <see cref="PolylineSimplifyMethod.Chordal"/>, an area for <see cref="PolylineSimplifyMethod.Visvalingam"/>.
+    /// </param>
+    /// <returns>The number of vertices that were removed.</returns>
+    public int Simplify(PolylineSimplifyMethod method, double tolerance)
+    {
+      if (m_size < 3) { return 0; }
+      using (var kept = new Runtime.InteropWrappers.SimpleArrayInt())
+      {
+        int N = UnsafeNativeMethods.ON_Polyline_Simplify(m_size, m_items, (int)method, tolerance, kept.NonConstPointer());
+        if (N < 2 || N == m_size)
+          return 0;
+        int[] indices = kept.ToArray();
+        for (int i = 0; i < N; i++)
+          m_items[i] = m_items[indices[i]];
+        int removed = m_size - N;
+        m_size = N;
+        return removed;
+      }
+    }
+
     private static void Reduce_RecursiveComponent(Point3d[] P, bool[] vertex_map, double tolerance, int A, int B)
     {
       //Abort if there is nothing left to collapse.
@@ -130,5 +130,45 @@ public void SetPoint(int index, Point3d point)
       IntPtr ptr = NonConstPointer();
       UnsafeNativeMethods.ON_PolylineCurve_GetSetPoint(ptr, index, ref point, true);
     }
+
+    /// <summary>
+    /// Removes vertices from this polyline curve with a native simplification algorithm.
+    /// The remaining vertices keep their curve parameters.
+    /// </summary>
+    /// <param name="method">The simplification algorithm.</param>
+    /// <param name="tolerance">
+    /// A distance for <see cref="PolylineSimplifyMethod.DouglasPeucker"/> and
+    /// <see cref="PolylineSimplifyMethod.Chordal"/>, an area for <see cref="PolylineSimplifyMethod.Visvalingam"/>.
+    /// </param>
+    /// <returns>The number of vertices that were removed.</returns>
+    public int Simplify(PolylineSimplifyMethod method, double tolerance)
+    {
+      IntPtr ptr = NonConstPointer();
+      return UnsafeNativeMethods.ON_PolylineCurve_Simplify(ptr, (int)method, tolerance);
+    }
+
+    /// <summary>
+    /// Simplifies many polyline curves in place, using several threads.
+    /// </summary>
+    /// <param name="curves">The curves to simplify. Null entries are skipped and repeated curves are simplified once.</param>
+    /// <param name="method">The simplification algorithm.</param>
+    /// <param name="tolerance">
+    /// A distance for <see cref="PolylineSimplifyMethod.DouglasPeucker"/> and
+    /// <see cref="PolylineSimplifyMethod.Chordal"/>, an area for <see cref="PolylineSimplifyMethod.Visvalingam"/>.
+    /// </param>
+    /// <returns>The total number of vertices that were removed.</returns>
+    public static int Simplify(System.Collections.Generic.IEnumerable<PolylineCurve> curves, PolylineSimplifyMethod method, double tolerance)
+    {
+      using (var curve_array = new Runtime.InteropWrappers.SimpleArrayCurvePointer())
+      {
+        IntPtr ptr_curve_array = curve_array.NonConstPointer();
+        foreach (PolylineCurve curve in curves)
+        {
+          if (curve != null)
+            UnsafeNativeMethods.ON_CurveArray_Append(ptr_curve_array, curve.NonConstPointer());
+        }
+        return UnsafeNativeMethods.ON_PolylineCurve_SimplifyBatch(ptr_curve_array, (int)method, tolerance, 0);
+      }
+    }
   }
 }
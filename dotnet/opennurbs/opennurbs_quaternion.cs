@@ -616,5 +616,172 @@ public static Quaternion CrossProduct(Quaternion p, Quaternion q)
     {
       return new Quaternion(0.0, p.m_c * q.m_d - p.m_d * q.m_c, p.m_d * q.m_b - p.m_b * q.m_d, p.m_b * q.m_c - p.m_c * q.m_d);
     }
+
+    #region batch operations
+    /// <summary>
+    /// Spherically interpolates between pairs of unit quaternions along the shorter arc,
+    /// using several threads.
+    /// </summary>
+    /// <param name="from">Unit quaternions at t = 0.</param>
+    /// <param name="to">Unit quaternions at t = 1, as many as from.</param>
+    /// <param name="t">The interpolation parameter used for every pair.</param>
+    /// <returns>The interpolated quaternions, or null if from and to have different lengths.</returns>
+    public static Quaternion[] Slerp(Quaternion[] from, Quaternion[] to, double t)
+    {
+      return Interpolate(from, to, new double[] { t }, false);
+    }
+
+    /// <summary>
+    /// Spherically interpolates between pairs of unit quaternions along the shorter arc,
+    /// using several threads.
+    /// </summary>
+    /// <param name="from">Unit quaternions at t = 0.</param>
+    /// <param name="to">Unit quaternions at t = 1, as many as from.</param>
+    /// <param name="t">One interpolation parameter per pair.</param>
+    /// <returns>The interpolated quaternions, or null if the arrays have different lengths.</returns>
+    public static Quaternion[] Slerp(Quaternion[] from, Quaternion[] to, double[] t)
+    {
+      return Interpolate(from, to, t, false);
+    }
+
+    /// <summary>
+    /// Linearly interpolates between pairs of unit quaternions along the shorter arc and
+    /// unitizes the results, using several threads. This is faster than
+    /// <see cref="Slerp(Quaternion[], Quaternion[], double)"/> but the rotation speed is not constant.
+    /// </summary>
+    /// <param name="from">Unit quaternions at t = 0.</param>
+    /// <param name="to">Unit quaternions at t = 1, as many as from.</param>
+    /// <param name="t">The interpolation parameter used for every pair.</param>
+    /// <returns>The interpolated quaternions, or null if from and to have different lengths.</returns>
+    public static Quaternion[] Nlerp(Quaternion[] from, Quaternion[] to, double t)
+    {
+      return Interpolate(from, to, new double[] { t }, true);
+    }
+
+    /// <summary>
+    /// Linearly interpolates between pairs of unit quaternions along the shorter arc and
+    /// unitizes the results, using several threads.
+    /// </summary>
+    /// <param name="from">Unit quaternions at t = 0.</param>
+    /// <param name="to">Unit quaternions at t = 1, as many as from.</param>
+    /// <param name="t">One interpolation parameter per pair.</param>
+    /// <returns>The interpolated quaternions, or null if the arrays have different lengths.</returns>
+    public static Quaternion[] Nlerp(Quaternion[] from, Quaternion[] to, double[] t)
+    {
+      return Interpolate(from, to, t, true);
+    }
+
+    static Quaternion[] Interpolate(Quaternion[] from, Quaternion[] to, double[] t, bool nlerp)
+    {
+      if (from == null || to == null || t == null || from.Length != to.Length)
+        return null;
+      if (t.Length != 1 && t.Length != from.Length)
+        return null;
+      Quaternion[] rc = new Quaternion[from.Length];
+      if (UnsafeNativeMethods.ON_Quaternion_InterpolateBatch(from.Length, from, to, t.Length, t, nlerp, rc, 0))
+        return rc;
+      return null;
+    }
+
+    /// <summary>
+    /// Rotates many vectors by the rotation of one quaternion, using several threads.
+    /// </summary>
+    /// <param name="rotation">The rotation. It does not have to be unitized.</param>
+    /// <param name="vectors">The vectors to rotate.</param>
+    /// <returns>The rotated vectors, or null on error.</returns>
+    public static Vector3d[] RotateVectors(Quaternion rotation, Vector3d[] vectors)
+    {
+      return RotateVectors(new Quaternion[] { rotation }, vectors);
+    }
+
+    /// <summary>
+    /// Rotates every vector by the rotation of its own quaternion, using several threads.
+    /// </summary>
+    /// <param name="rotations">
+    /// One rotation per vector, or a single rotation for all. They do not have to be unitized.
+    /// </param>
+    /// <param name="vectors">The vectors to rotate.</param>
+    /// <returns>The rotated vectors, or null on error.</returns>
+    public static Vector3d[] RotateVectors(Quaternion[] rotations, Vector3d[] vectors)
+    {
+      if (rotations == null || vectors == null)
+        return null;
+      if (rotations.Length != 1 && rotations.Length != vectors.Length)
+        return null;
+      Vector3d[] rc = new Vector3d[vectors.Length];
+      if (UnsafeNativeMethods.ON_Quaternion_RotateVectors(rotations.Length, rotations, vectors.Length, vectors, rc, 0))
+        return rc;
+      return null;
+    }
+
+    /// <summary>
+    /// Converts rotations and translations to rigid transformations, using several threads.
+    /// </summary>
+    /// <param name="rotations">The rotations. They do not have to be unitized.</param>
+    /// <param name="translations">
+    /// One translation per rotation, applied after the rotation, or null for none.
+    /// </param>
+    /// <returns>The transformations, or null on error.</returns>
+    public static Transform[] ToTransforms(Quaternion[] rotations, Vector3d[] translations)
+    {
+      if (rotations == null)
+        return null;
+      if (translations != null && translations.Length != rotations.Length)
+        return null;
+      Transform[] rc = new Transform[rotations.Length];
+      if (UnsafeNativeMethods.ON_Quaternion_ToXformBatch(rotations.Length, rotations, translations, rc, 0))
+        return rc;
+      return null;
+    }
+
+    /// <summary>
+    /// Splits rigid transformations into rotations and translations, using several threads.
+    /// </summary>
+    /// <param name="xforms">The transformations.</param>
+    /// <param name="tolerance">
+    /// How far the columns of the 3x3 part may be from orthonormal. 1e-8 is a good value.
+    /// </param>
+    /// <param name="rotations">
+    /// One unit quaternion with a non-negative real part per transformation. Transformations that
+    /// are not rigid get <see cref="Zero"/>.
+    /// </param>
+    /// <param name="translations">The translation of every transformation.</param>
+    /// <returns>The number of rigid transformations.</returns>
+    public static int FromTransforms(Transform[] xforms, double tolerance, out Quaternion[] rotations, out Vector3d[] translations)
+    {
+      int count = xforms == null ? 0 : xforms.Length;
+      rotations = new Quaternion[count];
+      translations = new Vector3d[count];
+      if (count < 1)
+        return 0;
+      return UnsafeNativeMethods.ON_Xform_ToQuaternionBatch(count, xforms, tolerance, rotations, translations, 0);
+    }
+
+    /// <summary>
+    /// Blends pairs of rigid transformations given as rotations and translations, using
+    /// several threads. Rotations are interpolated with
+    /// <see cref="Slerp(Quaternion[], Quaternion[], double)"/> and translations linearly.
+    /// </summary>
+    /// <param name="rotations0">Unit rotations at t = 0.</param>
+    /// <param name="translations0">Translations at t = 0.</param>
+    /// <param name="rotations1">Unit rotations at t = 1.</param>
+    /// <param name="translations1">Translations at t = 1.</param>
+    /// <param name="t">The interpolation parameter.</param>
+    /// <returns>The blended transformations, or null if the arrays have different lengths.</returns>
+    public static Transform[] InterpolateRigid(Quaternion[] rotations0, Vector3d[] translations0, Quaternion[] rotations1, Vector3d[] translations1, double t)
+    {
+      if (translations0 == null || translations1 == null || rotations0 == null)
+        return null;
+      if (translations0.Length != rotations0.Length || translations1.Length != rotations0.Length)
+        return null;
+      Quaternion[] rotations = Slerp(rotations0, rotations1, t);
+      if (rotations == null)
+        return null;
+      Vector3d[] translations = new Vector3d[translations0.Length];
+      for (int i = 0; i < translations.Length; i++)
+        translations[i] = translations0[i] + t * (translations1[i] - translations0[i]);
+      return ToTransforms(rotations, translations);
+    }
+    #endregion
   }
 }
@@ -91,6 +91,43 @@ public BoundingBox SearchBoundingBox
         UnsafeNativeMethods.ON_RTreeSearchContext_SetBoundingBox(m_pContext, value.Min, value.Max);
       }
     }
+
+    /// <summary>
+    /// During a ray or segment search, gets the ray parameter where the ray enters
+    /// the bounding box of the found item. Items are found in order of increasing
+    /// parameter. Returns RhinoMath.UnsetValue for other searches.
+    /// </summary>
+    public double RayParameter
+    {
+      get
+      {
+        double t = RhinoMath.UnsetValue;
+        double limit = RhinoMath.UnsetValue;
+        UnsafeNativeMethods.ON_RTreeSearchContext_GetRayParameters(m_pContext, ref t, ref limit);
+        return t;
+      }
+    }
+
+    /// <summary>
+    /// During a ray or segment search, gets or sets the largest ray parameter that is
+    /// still searched. Set this to the parameter of an exact hit with the found item
+    /// and the search skips everything behind it. When no remaining bounding box is
+    /// entered before the limit the search ends.
+    /// </summary>
+    public double RayLimit
+    {
+      get
+      {
+        double t = RhinoMath.UnsetValue;
+        double limit = RhinoMath.UnsetValue;
+        UnsafeNativeMethods.ON_RTreeSearchContext_GetRayParameters(m_pContext, ref t, ref limit);
+        return limit;
+      }
+      set
+      {
+        UnsafeNativeMethods.ON_RTreeSearchContext_SetRayLimit(m_pContext, value);
+      }
+    }
   }
 
   /// <summary>
@@ -104,6 +141,7 @@ public BoundingBox SearchBoundingBox
   public class RTree : IDisposable
   {
     IntPtr m_ptr; //ON_rTree* - this class is never const
+    IntPtr m_pIdIndex; //CRhCmnRTreeIdIndex* - created on first use
     long m_memory_pressure;
     int m_count = -1;
 
@@ -140,6 +178,60 @@ public static RTree CreateMeshFaceTree(Mesh mesh)
       return rc;
     }
 
+    /// <summary>
+    /// Constructs a new tree with an element for each piece of geometry.
+    /// The element id is set to the index of the geometry in the list.
+    /// <para>Bounding boxes are computed on several threads and the tree is
+    /// filled in spatial order, which is much faster than inserting one item at a time.</para>
+    /// </summary>
+    /// <param name="geometry">A list of geometry.</param>
+    /// <param name="tight">If true, tight bounding boxes are used. These are slower to compute.</param>
+    /// <returns>
+    /// A new tree, or null on error. The tree is empty when no geometry has a valid bounding box.
+    /// </returns>
+    public static RTree CreateGeometryTree(IEnumerable<GeometryBase> geometry, bool tight)
+    {
+      RTree rc = new RTree();
+      IntPtr pRtree = rc.NonConstPointer();
+      using (Runtime.InteropWrappers.SimpleArrayGeometryPointer geometry_array = new Runtime.InteropWrappers.SimpleArrayGeometryPointer(geometry))
+      {
+        if (!UnsafeNativeMethods.ON_RTree_CreateGeometryTree(pRtree, geometry_array.ConstPointer(), tight, 0))
+        {
+          rc.Dispose();
+          return null;
+        }
+      }
+      uint size = UnsafeNativeMethods.ON_RTree_SizeOf(pRtree);
+      rc.m_memory_pressure = size;
+      GC.AddMemoryPressure(rc.m_memory_pressure);
+      return rc;
+    }
+
+    /// <summary>
+    /// Constructs a new tree with an element for each object in a 3dm file.
+    /// The element id is set to the index of the object in the file's object table.
+    /// </summary>
+    /// <param name="file">A 3dm file.</param>
+    /// <param name="tight">If true, tight bounding boxes are used. These are slower to compute.</param>
+    /// <returns>
+    /// A new tree, or null on error. The tree is empty when no object has a valid bounding box.
+    /// </returns>
+    public static RTree CreateFile3dmObjectTree(Rhino.FileIO.File3dm file, bool tight)
+    {
+      RTree rc = new RTree();
+      IntPtr pRtree = rc.NonConstPointer();
+      IntPtr pConstModel = file.ConstPointer();
+      if (!UnsafeNativeMethods.ON_RTree_CreateModelObjectTree(pRtree, pConstModel, tight, 0))
+      {
+        rc.Dispose();
+        return null;
+      }
+      uint size = UnsafeNativeMethods.ON_RTree_SizeOf(pRtree);
+      rc.m_memory_pressure = size;
+      GC.AddMemoryPressure(rc.m_memory_pressure);
+      return rc;
+    }
+
     /// <summary>
     /// Constructs a new tree with an element for each pointcloud point.
     /// </summary>
@@ -201,6 +293,7 @@ public bool Insert(BoundingBox box, int elementId)
     public bool Insert(BoundingBox box, IntPtr elementId)
     {
       m_count = -1; 
+      InvalidateIdIndex();
       IntPtr pThis = NonConstPointer();
       return UnsafeNativeMethods.ON_RTree_InsertRemove(pThis, true, box.Min, box.Max, elementId);
     }
@@ -257,6 +350,7 @@ public bool Remove(BoundingBox box, int elementId)
     public bool Remove(BoundingBox box, IntPtr elementId)
     {
       m_count = -1; 
+      InvalidateIdIndex();
       IntPtr pThis = NonConstPointer();
       return UnsafeNativeMethods.ON_RTree_InsertRemove(pThis, false, box.Min, box.Max, elementId);
     }
@@ -276,10 +370,137 @@ public bool Remove(Point2d point, int elementId)
     public void Clear()
     {
       m_count = -1; 
+      InvalidateIdIndex();
       IntPtr pThis = NonConstPointer();
       UnsafeNativeMethods.ON_RTree_RemoveAll(pThis);
     }
 
+    #region id index
+    IntPtr IdIndexPointer()
+    {
+      if (IntPtr.Zero == m_pIdIndex)
+        m_pIdIndex = UnsafeNativeMethods.ON_RTreeIdIndex_New();
+      return m_pIdIndex;
+    }
+
+    void InvalidateIdIndex()
+    {
+      if (IntPtr.Zero != m_pIdIndex)
+        UnsafeNativeMethods.ON_RTreeIdIndex_Invalidate(m_pIdIndex);
+    }
+
+    /// <summary>
+    /// Removes an element from the tree without knowing its bounding box.
+    /// <para>The first call to any of the "ById" functions builds an index from element
+    /// ids to tree leaves; element ids should be unique when these functions are used.</para>
+    /// <para>Insert, Remove, Clear and every RemoveById call change the structure of the tree
+    /// and throw the index away, so the next "ById" call rebuilds it at a cost of
+    /// O(n log n) for n elements. Remove many elements with a single call to
+    /// <see cref="RemoveById(int[])"/> instead of calling this function in a loop.</para>
+    /// </summary>
+    /// <param name="elementId">A number.</param>
+    /// <returns>true if element was successfully removed.</returns>
+    public bool RemoveById(int elementId)
+    {
+      return RemoveById(new int[] { elementId }) == 1;
+    }
+
+    /// <summary>
+    /// Removes elements from the tree without knowing their bounding boxes.
+    /// The id index is looked up once for all of the elements.
+    /// </summary>
+    /// <param name="elementIds">Numbers of the elements to remove.</param>
+    /// <returns>The number of elements that were removed.</returns>
+    public int RemoveById(int[] elementIds)
+    {
+      if (elementIds == null || elementIds.Length < 1)
+        return 0;
+      long[] ids = new long[elementIds.Length];
+      for (int i = 0; i < ids.Length; i++)
+        ids[i] = elementIds[i];
+      m_count = -1;
+      IntPtr pThis = NonConstPointer();
+      return UnsafeNativeMethods.ON_RTree_RemoveById(pThis, IdIndexPointer(), ids.Length, ids);
+    }
+
+    /// <summary>
+    /// Removes an element from the tree without knowing its bounding box.
+    /// <para>Like <see cref="RemoveById(int)"/>, every call rebuilds the id index;
+    /// use <see cref="RemoveById(IntPtr[])"/> to remove many elements.</para>
+    /// </summary>
+    /// <param name="elementId">A pointer.</param>
+    /// <returns>true if element was successfully removed.</returns>
+    public bool RemoveById(IntPtr elementId)
+    {
+      return RemoveById(new IntPtr[] { elementId }) == 1;
+    }
+
+    /// <summary>
+    /// Removes elements from the tree without knowing their bounding boxes.
+    /// The id index is looked up once for all of the elements.
+    /// </summary>
+    /// <param name="elementIds">Pointers of the elements to remove.</param>
+    /// <returns>The number of elements that were removed.</returns>
+    public int RemoveById(IntPtr[] elementIds)
+    {
+      if (elementIds == null || elementIds.Length < 1)
+        return 0;
+      long[] ids = new long[elementIds.Length];
+      for (int i = 0; i < ids.Length; i++)
+        ids[i] = elementIds[i].ToInt64();
+      m_count = -1;
+      IntPtr pThis = NonConstPointer();
+      return UnsafeNativeMethods.ON_RTree_RemoveById(pThis, IdIndexPointer(), ids.Length, ids);
+    }
+
+    /// <summary>
+    /// Moves an element by changing its bounding box in place.
+    /// <para>The tree is refit from the element's leaf up to the root instead of removing
+    /// and inserting the element. The tree is never rebalanced this way, so a tree whose
+    /// elements move far from where they were inserted should be rebuilt occasionally.</para>
+    /// </summary>
+    /// <param name="elementId">A number.</param>
+    /// <param name="box">The new bounding box of the element.</param>
+    /// <returns>true if the element was found and updated.</returns>
+    public bool UpdateById(int elementId, BoundingBox box)
+    {
+      return UpdateById(new int[] { elementId }, new BoundingBox[] { box }) == 1;
+    }
+
+    /// <summary>
+    /// Moves many elements by changing their bounding boxes in place. Every node
+    /// of the tree is refit at most once, however many of its elements moved.
+    /// </summary>
+    /// <param name="elementIds">Numbers of the elements to update.</param>
+    /// <param name="boxes">New bounding boxes, one for each element id.</param>
+    /// <returns>The number of elements that were found and updated.</returns>
+    public int UpdateById(int[] elementIds, BoundingBox[] boxes)
+    {
+      if (elementIds == null || boxes == null)
+        return 0;
+      int count = Math.Min(elementIds.Length, boxes.Length);
+      if (count < 1)
+        return 0;
+      long[] ids = new long[count];
+      for (int i = 0; i < count; i++)
+        ids[i] = elementIds[i];
+      IntPtr pThis = NonConstPointer();
+      return UnsafeNativeMethods.ON_RTree_UpdateById(pThis, IdIndexPointer(), count, ids, boxes);
+    }
+
+    /// <summary>
+    /// Moves an element by changing its bounding box in place.
+    /// </summary>
+    /// <param name="elementId">A pointer.</param>
+    /// <param name="box">The new bounding box of the element.</param>
+    /// <returns>true if the element was found and updated.</returns>
+    public bool UpdateById(IntPtr elementId, BoundingBox box)
+    {
+      IntPtr pThis = NonConstPointer();
+      return UnsafeNativeMethods.ON_RTree_UpdateById(pThis, IdIndexPointer(), 1, new long[] { elementId.ToInt64() }, new BoundingBox[] { box }) == 1;
+    }
+    #endregion
+
     /// <summary>
     /// Gets the number of items in this tree.
     /// </summary>
@@ -299,7 +520,7 @@ public int Count
     static int m_next_serial_number = 1;
     class Callbackholder
     {
-      public RTree Sender { get; set; }
+      public object Sender { get; set; }
       public int SerialNumber { get; set; }
       public EventHandler<RTreeEventArgs> Callback { get; set; }
       public object Tag { get; set; }
@@ -307,7 +528,33 @@ class Callbackholder
     static List<Callbackholder> m_callbacks;
 
     internal delegate int SearchCallback(int serial_number, IntPtr idA, IntPtr idB, IntPtr pContext);
-    private static int CustomSearchCallback(int serial_number, IntPtr idA, IntPtr idB, IntPtr pContext)
+
+    internal static int BeginSearch(object sender, EventHandler<RTreeEventArgs> callback, object tag)
+    {
+      if (m_callbacks == null)
+        m_callbacks = new List<Callbackholder>();
+      Callbackholder cbh = new Callbackholder();
+      cbh.SerialNumber = m_next_serial_number++;
+      cbh.Callback = callback;
+      cbh.Sender = sender;
+      cbh.Tag = tag;
+      m_callbacks.Add(cbh);
+      return cbh.SerialNumber;
+    }
+
+    internal static void EndSearch(int serialNumber)
+    {
+      for (int i = 0; i < m_callbacks.Count; i++)
+      {
+        if (m_callbacks[i].SerialNumber == serialNumber)
+        {
+          m_callbacks.RemoveAt(i);
+          break;
+        }
+      }
+    }
+
+    internal static int CustomSearchCallback(int serial_number, IntPtr idA, IntPtr idB, IntPtr pContext)
     {
       Callbackholder cbh = null;
       for (int i = 0; i < m_callbacks.Count; i++)
@@ -431,6 +678,177 @@ public bool Search(Sphere sphere, EventHandler<RTreeEventArgs> callback, object
       return rc;
     }
 
+    /// <summary>
+    /// Searches for items whose bounding boxes are hit by a ray.
+    /// <para>Items are found front to back, in order of the ray parameter where the ray
+    /// enters their bounding box. To find the first exact hit, intersect the item in the
+    /// callback and set <see cref="RTreeEventArgs.RayLimit"/> to the hit parameter.</para>
+    /// </summary>
+    /// <param name="ray">The ray. Parameters are measured in multiples of the ray direction.</param>
+    /// <param name="callback">An event handler to be raised when items are found.</param>
+    /// <param name="tag">State to be passed inside the <see cref="RTreeEventArgs"/> Tag property.</param>
+    /// <returns>
+    /// true if entire tree was searched. It is possible no results were found.
+    /// </returns>
+    public bool Search(Ray3d ray, EventHandler<RTreeEventArgs> callback, object tag)
+    {
+      IntPtr pConstTree = ConstPointer();
+      int serial_number = BeginSearch(this, callback, tag);
+      SearchCallback searcher = CustomSearchCallback;
+      bool rc = UnsafeNativeMethods.ON_RTree_SearchRay(pConstTree, ray.Position, ray.Direction, 0.0, RhinoMath.UnsetValue, serial_number, searcher);
+      EndSearch(serial_number);
+      return rc;
+    }
+
+    /// <summary>
+    /// Searches for items whose bounding boxes are hit by a line segment.
+    /// <para>Items are found front to back. Ray parameters are line parameters, from
+    /// 0 at line.From to 1 at line.To.</para>
+    /// </summary>
+    /// <param name="line">The line segment.</param>
+    /// <param name="callback">An event handler to be raised when items are found.</param>
+    /// <param name="tag">State to be passed inside the <see cref="RTreeEventArgs"/> Tag property.</param>
+    /// <returns>
+    /// true if entire tree was searched. It is possible no results were found.
+    /// </returns>
+    public bool Search(Line line, EventHandler<RTreeEventArgs> callback, object tag)
+    {
+      IntPtr pConstTree = ConstPointer();
+      int serial_number = BeginSearch(this, callback, tag);
+      SearchCallback searcher = CustomSearchCallback;
+      bool rc = UnsafeNativeMethods.ON_RTree_SearchRay(pConstTree, line.From, line.Direction, 0.0, 1.0, serial_number, searcher);
+      EndSearch(serial_number);
+      return rc;
+    }
+
+    /// <summary>
+    /// Searches many line segments at once, using several threads.
+    /// </summary>
+    /// <param name="lines">The line segments.</param>
+    /// <param name="maxHitsPerLine">
+    /// The number of closest items to find for each line. Use 0 to find all items.
+    /// </param>
+    /// <param name="parameters">
+    /// For each line, the line parameters where the line enters the bounding boxes of the found items.
+    /// </param>
+    /// <returns>For each line, the ids of the items found, sorted front to back.</returns>
+    public int[][] SearchLines(Line[] lines, int maxHitsPerLine, out double[][] parameters)
+    {
+      return SearchRays(lines, false, maxHitsPerLine, out parameters);
+    }
+
+    /// <summary>
+    /// Searches many rays at once, using several threads.
+    /// </summary>
+    /// <param name="rays">The rays.</param>
+    /// <param name="maxHitsPerRay">
+    /// The number of closest items to find for each ray. Use 0 to find all items.
+    /// </param>
+    /// <param name="parameters">
+    /// For each ray, the ray parameters where the ray enters the bounding boxes of the found items.
+    /// </param>
+    /// <returns>For each ray, the ids of the items found, sorted front to back.</returns>
+    public int[][] SearchRays(Ray3d[] rays, int maxHitsPerRay, out double[][] parameters)
+    {
+      Line[] lines = new Line[rays.Length];
+      for (int i = 0; i < rays.Length; i++)
+        lines[i] = new Line(rays[i].Position, rays[i].Position + rays[i].Direction);
+      return SearchRays(lines, true, maxHitsPerRay, out parameters);
+    }
+
+    int[][] SearchRays(Line[] lines, bool infinite, int maxHits, out double[][] parameters)
+    {
+      IntPtr pConstTree = ConstPointer();
+      using (Runtime.InteropWrappers.SimpleArrayInt offsets = new Runtime.InteropWrappers.SimpleArrayInt())
+      using (Runtime.InteropWrappers.SimpleArrayInt ids = new Runtime.InteropWrappers.SimpleArrayInt())
+      using (Runtime.InteropWrappers.SimpleArrayDouble ts = new Runtime.InteropWrappers.SimpleArrayDouble())
+      {
+        UnsafeNativeMethods.ON_RTree_SearchRays(pConstTree, lines.Length, lines, infinite, maxHits, 0, offsets.NonConstPointer(), ids.NonConstPointer(), ts.NonConstPointer());
+        int[][] rc = new int[lines.Length][];
+        parameters = new double[lines.Length][];
+        int[] all_offsets = offsets.ToArray();
+        int[] all_ids = ids.ToArray();
+        double[] all_ts = ts.ToArray();
+        for (int i = 0; i < lines.Length; i++)
+        {
+          int start = 0;
+          int count = 0;
+          if (all_offsets.Length > i + 1)
+          {
+            start = all_offsets[i];
+            count = all_offsets[i + 1] - start;
+          }
+          rc[i] = new int[count];
+          parameters[i] = new double[count];
+          Array.Copy(all_ids, start, rc[i], 0, count);
+          Array.Copy(all_ts, start, parameters[i], 0, count);
+        }
+        return rc;
+      }
+    }
+
+    /// <summary>
+    /// Searches for items inside a convex region bounded by planes.
+    /// <para>The region is the part of space on the side of every plane that the
+    /// plane normal points to. Subtrees whose bounding box is fully inside the region
+    /// are reported without further tests.</para>
+    /// </summary>
+    /// <param name="planes">Up to 64 planes with normals pointing into the region.</param>
+    /// <param name="insideIds">Ids of the items whose bounding boxes are fully inside the region.</param>
+    /// <param name="intersectingIds">Ids of the items whose bounding boxes cross the region boundary.</param>
+    /// <returns>true if the search was performed.</returns>
+    public bool Search(Plane[] planes, out int[] insideIds, out int[] intersectingIds)
+    {
+      insideIds = null;
+      intersectingIds = null;
+      if (planes == null || planes.Length < 1)
+        return false;
+      double[] equations = new double[4 * planes.Length];
+      for (int i = 0; i < planes.Length; i++)
+      {
+        double[] e = planes[i].GetPlaneEquation();
+        Array.Copy(e, 0, equations, 4 * i, 4);
+      }
+      IntPtr pConstTree = ConstPointer();
+      using (Runtime.InteropWrappers.SimpleArrayInt inside = new Runtime.InteropWrappers.SimpleArrayInt())
+      using (Runtime.InteropWrappers.SimpleArrayInt intersecting = new Runtime.InteropWrappers.SimpleArrayInt())
+      {
+        bool rc = UnsafeNativeMethods.ON_RTree_SearchPolytope(pConstTree, planes.Length, equations, inside.NonConstPointer(), intersecting.NonConstPointer());
+        if (rc)
+        {
+          insideIds = inside.ToArray();
+          intersectingIds = intersecting.ToArray();
+        }
+        return rc;
+      }
+    }
+
+    /// <summary>
+    /// Searches for items inside the view frustum of a viewport.
+    /// </summary>
+    /// <param name="viewport">The viewport.</param>
+    /// <param name="insideIds">Ids of the items whose bounding boxes are fully inside the frustum.</param>
+    /// <param name="intersectingIds">Ids of the items whose bounding boxes cross the frustum boundary.</param>
+    /// <returns>true if the search was performed.</returns>
+    public bool Search(Rhino.DocObjects.ViewportInfo viewport, out int[] insideIds, out int[] intersectingIds)
+    {
+      insideIds = null;
+      intersectingIds = null;
+      IntPtr pConstTree = ConstPointer();
+      IntPtr pConstViewport = viewport.ConstPointer();
+      using (Runtime.InteropWrappers.SimpleArrayInt inside = new Runtime.InteropWrappers.SimpleArrayInt())
+      using (Runtime.InteropWrappers.SimpleArrayInt intersecting = new Runtime.InteropWrappers.SimpleArrayInt())
+      {
+        bool rc = UnsafeNativeMethods.ON_RTree_SearchViewportFrustum(pConstTree, pConstViewport, inside.NonConstPointer(), intersecting.NonConstPointer());
+        if (rc)
+        {
+          insideIds = inside.ToArray();
+          intersectingIds = intersecting.ToArray();
+        }
+        return rc;
+      }
+    }
+
     /// <summary>
     /// Searches two R-trees for all pairs elements whose bounding boxes overlap.
     /// </summary>
@@ -468,6 +886,76 @@ public static bool SearchOverlaps(RTree treeA, RTree treeB, double tolerance, Ev
       return rc;
     }
 
+    /// <summary>
+    /// Searches two R-trees for all pairs of elements whose bounding boxes overlap.
+    /// <para>The search is split across several threads and the results are
+    /// collected without calling back into managed code, which makes this much
+    /// faster than the callback version for large trees.</para>
+    /// </summary>
+    /// <param name="treeA">A first tree.</param>
+    /// <param name="treeB">A second tree.</param>
+    /// <param name="tolerance">
+    /// If the distance between a pair of bounding boxes is less than tolerance,
+    /// then the pair is reported.
+    /// </param>
+    /// <param name="maxPairs">
+    /// The search stops once this many pairs have been found. Use 0 for no limit.
+    /// </param>
+    /// <param name="threadCount">Number of threads to use, or 0 to use all processors.</param>
+    /// <param name="reachedLimit">true if the search stopped because maxPairs was reached.</param>
+    /// <returns>
+    /// Pairs of element ids. I is an element of treeA and J an element of treeB.
+    /// The pairs are in no particular order.
+    /// </returns>
+    public static IndexPair[] SearchOverlaps(RTree treeA, RTree treeB, double tolerance, int maxPairs, int threadCount, out bool reachedLimit)
+    {
+      reachedLimit = false;
+      IntPtr pConstTreeA = treeA.ConstPointer();
+      IntPtr pConstTreeB = treeB.ConstPointer();
+      using (Runtime.InteropWrappers.SimpleArrayInt pairs = new Runtime.InteropWrappers.SimpleArrayInt())
+      {
+        int count = UnsafeNativeMethods.ON_RTree_SearchOverlapsParallel(pConstTreeA, pConstTreeB, tolerance, maxPairs, threadCount, pairs.NonConstPointer(), ref reachedLimit);
+        IndexPair[] rc = new IndexPair[count];
+        int[] ids = pairs.ToArray();
+        for (int i = 0; i < count; i++)
+          rc[i] = new IndexPair(ids[2 * i], ids[2 * i + 1]);
+        return rc;
+      }
+    }
+
+    /// <summary>
+    /// Packs this tree into a single, position independent block of memory.
+    /// <para>The block can be saved to a file or a user data chunk and later searched
+    /// with a <see cref="PackedRTree"/> without rebuilding the tree.</para>
+    /// <para>Element ids are stored as numbers. Ids that are pointers are only
+    /// meaningful while the objects they point to are alive.</para>
+    /// </summary>
+    /// <returns>The packed tree, or null on error.</returns>
+    public byte[] ToPackedByteArray()
+    {
+      IntPtr pConstTree = ConstPointer();
+      uint size = UnsafeNativeMethods.ON_RTree_PackedSizeOf(pConstTree);
+      if (size < 1 || size > int.MaxValue)
+        return null;
+      byte[] rc = new byte[size];
+      if (!UnsafeNativeMethods.ON_RTree_Pack(pConstTree, size, rc))
+        return null;
+      return rc;
+    }
+
+    /// <summary>
+    /// Writes this tree to an archive in packed form.
+    /// Read it back with <see cref="PackedRTree.Read"/>.
+    /// </summary>
+    /// <param name="archive">The archive to write to.</param>
+    /// <returns>true on success.</returns>
+    public bool WritePacked(Rhino.FileIO.BinaryArchiveWriter archive)
+    {
+      IntPtr pConstTree = ConstPointer();
+      IntPtr pArchive = archive.NonConstPointer();
+      return UnsafeNativeMethods.ON_RTree_WritePacked(pConstTree, pArchive);
+    }
+
     #region pointer / disposable handlers
     IntPtr ConstPointer() { return m_ptr; }
     IntPtr NonConstPointer() { return m_ptr; }
@@ -504,6 +992,11 @@ protected virtual void Dispose(bool disposing)
         UnsafeNativeMethods.ON_RTree_Delete(m_ptr);
         m_ptr = IntPtr.Zero;
       }
+      if (IntPtr.Zero != m_pIdIndex)
+      {
+        UnsafeNativeMethods.ON_RTreeIdIndex_Delete(m_pIdIndex);
+        m_pIdIndex = IntPtr.Zero;
+      }
       if (m_memory_pressure > 0)
       {
         GC.RemoveMemoryPressure(m_memory_pressure);
@@ -513,4 +1006,228 @@ protected virtual void Dispose(bool disposing)
     #endregion
 
   }
+
+  /// <summary>
+  /// Represents a read-only <see cref="RTree"/> stored in one packed, position
+  /// independent block of memory.
+  /// <para>A packed tree is searched in place, so it is available immediately after
+  /// loading it from a user data chunk or from a memory mapped file.</para>
+  /// </summary>
+  public class PackedRTree : IDisposable
+  {
+    IntPtr m_ptr; //CRhCmnPackedRTree*
+    System.IO.MemoryMappedFiles.MemoryMappedFile m_mapped_file;
+    System.IO.MemoryMappedFiles.MemoryMappedViewAccessor m_mapped_view;
+    long m_memory_pressure;
+
+    PackedRTree(IntPtr ptr)
+    {
+      m_ptr = ptr;
+    }
+
+    /// <summary>
+    /// Creates a packed tree from a block created with <see cref="RTree.ToPackedByteArray"/>.
+    /// </summary>
+    /// <param name="data">A packed tree.</param>
+    /// <returns>A new packed tree, or null if data is not a valid packed tree.</returns>
+    public static PackedRTree FromByteArray(byte[] data)
+    {
+      if (data == null || data.Length < 1)
+        return null;
+      System.Runtime.InteropServices.GCHandle handle = System.Runtime.InteropServices.GCHandle.Alloc(data, System.Runtime.InteropServices.GCHandleType.Pinned);
+      IntPtr ptr;
+      try
+      {
+        ptr = UnsafeNativeMethods.ON_PackedRTree_New(handle.AddrOfPinnedObject(), (uint)data.Length, true, true);
+      }
+      finally
+      {
+        handle.Free();
+      }
+      if (IntPtr.Zero == ptr)
+        return null;
+      PackedRTree rc = new PackedRTree(ptr);
+      rc.m_memory_pressure = data.Length;
+      GC.AddMemoryPressure(rc.m_memory_pressure);
+      return rc;
+    }
+
+    /// <summary>
+    /// Memory maps a file written with the bytes from <see cref="RTree.ToPackedByteArray"/>.
+    /// The tree is searched directly from the mapped file; nothing is copied or rebuilt.
+    /// </summary>
+    /// <param name="path">Path to the file.</param>
+    /// <param name="verifyChecksum">
+    /// If true, the node data is checked against the stored CRC. This reads every
+    /// page of the file once.
+    /// </param>
+    /// <returns>A new packed tree, or null if the file does not hold a valid packed tree.</returns>
+    public static PackedRTree OpenFile(string path, bool verifyChecksum)
+    {
+      long length = new System.IO.FileInfo(path).Length;
+      if (length < 1 || length > uint.MaxValue)
+        return null;
+      var mapped_file = System.IO.MemoryMappedFiles.MemoryMappedFile.CreateFromFile(path, System.IO.FileMode.Open, null, 0, System.IO.MemoryMappedFiles.MemoryMappedFileAccess.Read);
+      var view = mapped_file.CreateViewAccessor(0, length, System.IO.MemoryMappedFiles.MemoryMappedFileAccess.Read);
+      IntPtr pBuffer = view.SafeMemoryMappedViewHandle.DangerousGetHandle();
+      IntPtr ptr = UnsafeNativeMethods.ON_PackedRTree_New(pBuffer, (uint)length, false, verifyChecksum);
+      if (IntPtr.Zero == ptr)
+      {
+        view.Dispose();
+        mapped_file.Dispose();
+        return null;
+      }
+      PackedRTree rc = new PackedRTree(ptr);
+      rc.m_mapped_file = mapped_file;
+      rc.m_mapped_view = view;
+      return rc;
+    }
+
+    /// <summary>
+    /// Reads a packed tree written with <see cref="RTree.WritePacked"/> or <see cref="Write"/>.
+    /// </summary>
+    /// <param name="archive">The archive to read from.</param>
+    /// <returns>A new packed tree, or null on error.</returns>
+    public static PackedRTree Read(Rhino.FileIO.BinaryArchiveReader archive)
+    {
+      IntPtr pArchive = archive.NonConstPointer();
+      IntPtr ptr = UnsafeNativeMethods.ON_PackedRTree_Read(pArchive);
+      if (IntPtr.Zero == ptr)
+        return null;
+      PackedRTree rc = new PackedRTree(ptr);
+      rc.m_memory_pressure = UnsafeNativeMethods.ON_PackedRTree_SizeOf(ptr);
+      GC.AddMemoryPressure(rc.m_memory_pressure);
+      return rc;
+    }
+
+    /// <summary>
+    /// Writes this packed tree to an archive.
+    /// </summary>
+    /// <param name="archive">The archive to write to.</param>
+    /// <returns>true on success.</returns>
+    public bool Write(Rhino.FileIO.BinaryArchiveWriter archive)
+    {
+      IntPtr pConstThis = ConstPointer();
+      IntPtr pArchive = archive.NonConstPointer();
+      return UnsafeNativeMethods.ON_PackedRTree_Write(pConstThis, pArchive);
+    }
+
+    /// <summary>
+    /// Gets the number of items in this tree.
+    /// </summary>
+    public int Count
+    {
+      get
+      {
+        IntPtr pConstThis = ConstPointer();
+        return UnsafeNativeMethods.ON_PackedRTree_ElementCount(pConstThis);
+      }
+    }
+
+    /// <summary>
+    /// Gets the bounding box of all items in this tree.
+    /// </summary>
+    public BoundingBox BoundingBox
+    {
+      get
+      {
+        IntPtr pConstThis = ConstPointer();
+        BoundingBox rc = BoundingBox.Unset;
+        UnsafeNativeMethods.ON_PackedRTree_BoundingBox(pConstThis, ref rc);
+        return rc;
+      }
+    }
+
+    /// <summary>
+    /// Searches for items in a bounding box.
+    /// <para>The bounding box can be singular and contain exactly one single point.</para>
+    /// </summary>
+    /// <param name="box">A bounding box.</param>
+    /// <param name="callback">An event handler to be raised when items are found.</param>
+    /// <param name="tag">State to be passed inside the <see cref="RTreeEventArgs"/> Tag property.</param>
+    /// <returns>
+    /// true if entire tree was searched. It is possible no results were found.
+    /// </returns>
+    public bool Search(BoundingBox box, EventHandler<RTreeEventArgs> callback, object tag)
+    {
+      IntPtr pConstThis = ConstPointer();
+      int serial_number = RTree.BeginSearch(this, callback, tag);
+      RTree.SearchCallback searcher = RTree.CustomSearchCallback;
+      bool rc = UnsafeNativeMethods.ON_PackedRTree_Search(pConstThis, box.Min, box.Max, serial_number, searcher);
+      RTree.EndSearch(serial_number);
+      return rc;
+    }
+
+    /// <summary>
+    /// Searches for items in a sphere.
+    /// </summary>
+    /// <param name="sphere">bounds used for searching.</param>
+    /// <param name="callback">An event handler to be raised when items are found.</param>
+    /// <param name="tag">State to be passed inside the <see cref="RTreeEventArgs"/> Tag property.</param>
+    /// <returns>
+    /// true if entire tree was searched. It is possible no results were found.
+    /// </returns>
+    public bool Search(Sphere sphere, EventHandler<RTreeEventArgs> callback, object tag)
+    {
+      IntPtr pConstThis = ConstPointer();
+      int serial_number = RTree.BeginSearch(this, callback, tag);
+      RTree.SearchCallback searcher = RTree.CustomSearchCallback;
+      bool rc = UnsafeNativeMethods.ON_PackedRTree_SearchSphere(pConstThis, sphere.Center, sphere.Radius, serial_number, searcher);
+      RTree.EndSearch(serial_number);
+      return rc;
+    }
+
+    #region pointer / disposable handlers
+    IntPtr ConstPointer() { return m_ptr; }
+
+    /// <summary>
+    /// Passively reclaims unmanaged resources when the class user did not explicitly call Dispose().
+    /// </summary>
+    ~PackedRTree()
+    {
+      Dispose(false);
+    }
+
+    /// <summary>
+    /// Actively reclaims unmanaged resources that this instance uses.
+    /// </summary>
+    public void Dispose()
+    {
+      Dispose(true);
+      GC.SuppressFinalize(this);
+    }
+
+    /// <summary>
+    /// For derived class implementers.
+    /// <para>This method is called with argument true when class user calls Dispose(), while with argument false when
+    /// the Garbage Collector invokes the finalizer, or Finalize() method.</para>
+    /// <para>You must reclaim all used unmanaged resources in both cases, and can use this chance to call Dispose on disposable fields if the argument is true.</para>
+    /// <para>Also, you must call the base virtual method within your overriding method.</para>
+    /// </summary>
+    /// <param name="disposing">true if the call comes from the Dispose() method; false if it comes from the Garbage Collector finalizer.</param>
+    protected virtual void Dispose(bool disposing)
+    {
+      // the native tree may point into the mapped view, so delete it first
+      if (IntPtr.Zero != m_ptr)
+      {
+        UnsafeNativeMethods.ON_PackedRTree_Delete(m_ptr);
+        m_ptr = IntPtr.Zero;
+      }
+      if (disposing)
+      {
+        if (m_mapped_view != null)
+          m_mapped_view.Dispose();
+        if (m_mapped_file != null)
+          m_mapped_file.Dispose();
+      }
+      m_mapped_view = null;
+      m_mapped_file = null;
+      if (m_memory_pressure > 0)
+      {
+        GC.RemoveMemoryPressure(m_memory_pressure);
+        m_memory_pressure = 0;
+      }
+    }
+    #endregion
+  }
 }
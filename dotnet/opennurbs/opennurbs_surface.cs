@@ -819,6 +819,25 @@ public bool GetNextDiscontinuity(int direction, Continuity continuityType, doubl
       return UnsafeNativeMethods.ON_Surface_GetNextDiscontinuity(ptr, direction, (int)continuityType, t0, t1, ref t);
     }
 
+    /// <summary>
+    /// Finds all derivative, tangent, or curvature discontinuities in one direction in one call.
+    /// This gives the same parameters as calling GetNextDiscontinuity() repeatedly.
+    /// </summary>
+    /// <param name="direction">0 selects the u direction, 1 selects the v direction.</param>
+    /// <param name="continuityType">Type of continuity to search for.</param>
+    /// <param name="t0">Search begins at t0. A discontinuity at t0 is ignored.</param>
+    /// <param name="t1">(t0 != t1) Search ends at t1.</param>
+    /// <returns>The discontinuity parameters, ordered from t0 to t1. The array is empty when none are found.</returns>
+    public double[] GetDiscontinuities(int direction, Continuity continuityType, double t0, double t1)
+    {
+      IntPtr ptr = ConstPointer();
+      using (var t = new Runtime.InteropWrappers.SimpleArrayDouble())
+      {
+        UnsafeNativeMethods.ON_Surface_GetDiscontinuities(ptr, direction, (int)continuityType, t0, t1, t.NonConstPointer());
+        return t.ToArray();
+      }
+    }
+
     // [skipping]
     //  ON_NurbsSurface* NurbsSurface(
     //  void DestroySurfaceTree();
@@ -1478,4 +1497,111 @@ internal virtual void Draw(Display.DisplayPipeline pipeline, System.Drawing.Colo
     }
 #endif
   }
+
+  /// <summary>
+  /// Adaptive (u,v) grids of surfaces and untrimmed brep faces, computed using several threads.
+  /// The parameters in each direction are refined until the grid lines are within a chordal
+  /// tolerance of the surface and the normals along them turn less than an angle tolerance.
+  /// All grids are stored in flat arrays.
+  /// </summary>
+  public sealed class SurfaceGrid
+  {
+    int[] m_info; // 3 ints per surface: u count, v count, first vertex
+    Point3d[] m_vertices;
+    Vector3d[] m_normals;
+    Point2d[] m_parameters;
+    int[] m_quads;
+
+    private SurfaceGrid() { }
+
+    /// <summary>
+    /// Tessellates surfaces into grids.
+    /// </summary>
+    /// <param name="surfaces">
+    /// The surfaces. Brep faces are tessellated as untrimmed surfaces, with normals that follow
+    /// the face orientation.
+    /// </param>
+    /// <param name="chordTolerance">
+    /// Largest distance between a grid segment and the surface. 0 turns the test off.
+    /// </param>
+    /// <param name="angleToleranceRadians">
+    /// Largest angle between the normals at the ends of a grid segment. 0 turns the test off.
+    /// </param>
+    /// <param name="maxCountPerDirection">Largest number of grid parameters in each direction.</param>
+    /// <returns>The grids, one per input surface. Null inputs get an empty grid.</returns>
+    public static SurfaceGrid Create(System.Collections.Generic.IEnumerable<Surface> surfaces, double chordTolerance, double angleToleranceRadians, int maxCountPerDirection)
+    {
+      var input = new System.Collections.Generic.List<Surface>();
+      var indices = new System.Collections.Generic.List<int>();
+      int index = 0;
+      foreach (Surface srf in surfaces)
+      {
+        if (srf != null)
+        {
+          input.Add(srf);
+          indices.Add(index);
+        }
+        index++;
+      }
+
+      SurfaceGrid rc = new SurfaceGrid();
+      using (var geometry = new Runtime.InteropWrappers.SimpleArrayGeometryPointer(input))
+      {
+        IntPtr ptr_grids = UnsafeNativeMethods.ON_SurfaceGrids_New(geometry.ConstPointer(), chordTolerance, angleToleranceRadians, maxCountPerDirection, 0);
+        if (IntPtr.Zero == ptr_grids)
+          return null;
+        int[] counts = new int[3];
+        UnsafeNativeMethods.ON_SurfaceGrids_GetCounts(ptr_grids, counts);
+        int[] info = new int[3 * counts[0]];
+        rc.m_vertices = new Point3d[counts[1]];
+        rc.m_normals = new Vector3d[counts[1]];
+        rc.m_parameters = new Point2d[counts[1]];
+        rc.m_quads = new int[4 * counts[2]];
+        UnsafeNativeMethods.ON_SurfaceGrids_Copy(ptr_grids, info, rc.m_vertices, rc.m_normals, rc.m_parameters, rc.m_quads);
+        UnsafeNativeMethods.ON_SurfaceGrids_Delete(ptr_grids);
+
+        rc.m_info = new int[3 * index];
+        for (int i = 0; i < indices.Count; i++)
+          Array.Copy(info, 3 * i, rc.m_info, 3 * indices[i], 3);
+      }
+      return rc;
+    }
+
+    /// <summary>Gets the number of grids, which is the number of input surfaces.</summary>
+    public int Count { get { return m_info.Length / 3; } }
+
+    /// <summary>
+    /// Gets the size of one grid. Vertex (i,j) of grid g is Vertices[FirstVertex(g) + j*uCount + i].
+    /// </summary>
+    /// <param name="index">Index of the grid.</param>
+    /// <param name="uCount">Number of parameters in the u direction.</param>
+    /// <param name="vCount">Number of parameters in the v direction.</param>
+    public void GetSize(int index, out int uCount, out int vCount)
+    {
+      uCount = m_info[3 * index];
+      vCount = m_info[3 * index + 1];
+    }
+
+    /// <summary>Gets the index of the first vertex of one grid.</summary>
+    /// <param name="index">Index of the grid.</param>
+    /// <returns>An index into <see cref="Vertices"/>.</returns>
+    public int FirstVertex(int index)
+    {
+      return m_info[3 * index + 2];
+    }
+
+    /// <summary>Gets the vertices of all grids.</summary>
+    public Point3d[] Vertices { get { return m_vertices; } }
+
+    /// <summary>Gets the unit normals of all grids. Vertices where the normal is not defined get a zero vector.</summary>
+    public Vector3d[] Normals { get { return m_normals; } }
+
+    /// <summary>Gets the (u,v) surface parameters of all vertices.</summary>
+    public Point2d[] Parameters { get { return m_parameters; } }
+
+    /// <summary>
+    /// Gets 4 vertex indices per grid cell, counterclockwise about the normal.
+    /// </summary>
+    public int[] QuadIndices { get { return m_quads; } }
+  }
 }
\ No newline at end of file
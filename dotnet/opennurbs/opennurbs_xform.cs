@@ -779,6 +779,27 @@ public float[] ToFloatArray(bool rowDominant)
       return rc;
     }
 
+    /// <summary>
+    /// Composes the transformations of a part hierarchy, like an assembly, using several threads.
+    /// <para>world[i] = world[parents[i]] * local[i], so the local transformation of a part is
+    /// applied first and then the world transformation of its parent.</para>
+    /// </summary>
+    /// <param name="local">The transformation of every part relative to its parent.</param>
+    /// <param name="parents">The index of the parent of every part, or -1 for parts without one.</param>
+    /// <returns>
+    /// The world transformation of every part, or null if the arrays do not have the same length,
+    /// a parent index is out of range or the parents form a cycle.
+    /// </returns>
+    public static Transform[] ComposeHierarchy(Transform[] local, int[] parents)
+    {
+      if (local == null || parents == null || local.Length != parents.Length)
+        return null;
+      Transform[] world = new Transform[local.Length];
+      if (UnsafeNativeMethods.ON_Xform_ComposeHierarchy(local.Length, local, parents, world, 0))
+        return world;
+      return null;
+    }
+
     #endregion
 
     /// <summary>
@@ -377,7 +377,16 @@ static string ParameterTypeAsCSharp(string ctype, bool isArray)
             return "ref ComponentIndex";
 
           if (s.Equals("ON_Xform") || s.Equals("AR_Transform"))
+          {
+            if (isArray)
+            {
+              if (isConst)
+                return "Transform[]";
+              else
+                return "[In,Out] Transform[]";
+            }
             return "ref Transform";
+          }
 
           if (s.Equals("ON_2fPoint") || s.Equals("AR_2fPoint"))
             return "ref Point2f";